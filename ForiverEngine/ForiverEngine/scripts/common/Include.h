@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <array>
+#include <span>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
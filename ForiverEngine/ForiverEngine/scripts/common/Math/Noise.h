@@ -2,9 +2,13 @@
 
 #include <scripts/common/IncludeInternal.h>
 #include <scripts/common/Math/Defines.h>
+#include <scripts/common/Math/LinearAlgebra/Include.h>
+#include <scripts/common/Math/SimplexNoiseBatch.h>
 
 #include <oss/SimplexNoise.h>
 
+#include <span>
+
 namespace ForiverEngine
 {
 	class Noise final
@@ -44,5 +48,41 @@ namespace ForiverEngine
 		{
 			return SimplexNoise::noise(x, y, z);
 		}
+
+		/// <summary>
+		/// <para>シンプレックスノイズ 2D を、座標の配列についてまとめて求める (out[i] = Simplex2D(xs[i], ys[i]))</para>
+		/// <para>SIMD で複数の座標を同時に求める. 値は Simplex2D() と (FMA などによる誤差を除いて) 一致する</para>
+		/// </summary>
+		static void Simplex2D(std::span<const float> xs, std::span<const float> ys, std::span<float> out) noexcept
+		{
+			SimplexNoiseBatch::Noise2D(xs, ys, out);
+		}
+
+		/// <summary>
+		/// <para>シンプレックスノイズ 2D を、格子状の座標についてまとめて求める</para>
+		/// <para>out[xi * count.y + yi] = Simplex2D(origin.x + step.x * xi, origin.y + step.y * yi)</para>
+		/// </summary>
+		static void Simplex2DGrid(std::span<float> out, const Vector2& origin, const Vector2& step, const Lattice2& count) noexcept
+		{
+			SimplexNoiseBatch::Noise2DGrid(out, origin.x, origin.y, step.x, step.y, count.x, count.y);
+		}
+
+		/// <summary>
+		/// <para>シンプレックスノイズ 3D を、座標の配列についてまとめて求める (out[i] = Simplex3D(xs[i], ys[i], zs[i]))</para>
+		/// <para>SIMD で複数の座標を同時に求める. 値は Simplex3D() と (FMA などによる誤差を除いて) 一致する</para>
+		/// </summary>
+		static void Simplex3D(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> out) noexcept
+		{
+			SimplexNoiseBatch::Noise3D(xs, ys, zs, out);
+		}
+
+		/// <summary>
+		/// <para>シンプレックスノイズ 3D を、格子状の座標についてまとめて求める</para>
+		/// <para>out[(xi * count.y + yi) * count.z + zi] = Simplex3D(origin.x + step.x * xi, origin.y + step.y * yi, origin.z + step.z * zi)</para>
+		/// </summary>
+		static void Simplex3DGrid(std::span<float> out, const Vector3& origin, const Vector3& step, const Lattice3& count) noexcept
+		{
+			SimplexNoiseBatch::Noise3DGrid(out, origin.x, origin.y, origin.z, step.x, step.y, step.z, count.x, count.y, count.z);
+		}
 	};
 }
@@ -0,0 +1,434 @@
+﻿#pragma once
+
+#include <scripts/common/IncludeInternal.h>
+
+#include <array>
+#include <algorithm>
+#include <span>
+#include <tuple>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>シンプレックスノイズ (oss/SimplexNoise.cpp と同じもの) を、多数の座標についてまとめて求める</para>
+	/// <para>AVX2 が有効なビルドなら8レーン、それ以外の x64 なら SSE2 の4レーンずつ求める. どちらも無ければ1つずつ求める</para>
+	/// <para>演算の順番は元の実装と同じにしてあるので、コンパイラが FMA などに置き換えなければ、値は一致する</para>
+	/// </summary>
+	class SimplexNoiseBatch final
+	{
+	public:
+		DELETE_DEFAULT_METHODS(SimplexNoiseBatch);
+
+		/// <summary>
+		/// out[i] = SimplexNoise::noise(xs[i], ys[i])
+		/// </summary>
+		static void Noise2D(std::span<const float> xs, std::span<const float> ys, std::span<float> out) noexcept
+		{
+			EvaluateArray<Lanes>(std::array{ xs, ys }, out,
+				[](const auto& x, const auto& y) { return Evaluate2D<Lanes>(x, y); });
+		}
+
+		/// <summary>
+		/// out[i] = SimplexNoise::noise(xs[i], ys[i], zs[i])
+		/// </summary>
+		static void Noise3D(std::span<const float> xs, std::span<const float> ys, std::span<const float> zs, std::span<float> out) noexcept
+		{
+			EvaluateArray<Lanes>(std::array{ xs, ys, zs }, out,
+				[](const auto& x, const auto& y, const auto& z) { return Evaluate3D<Lanes>(x, y, z); });
+		}
+
+		/// <summary>
+		/// <para>格子状の座標 (origin + step * インデックス) について求める</para>
+		/// <para>out[xi * countY + yi] = SimplexNoise::noise(originX + stepX * xi, originY + stepY * yi)</para>
+		/// </summary>
+		static void Noise2DGrid(std::span<float> out, float originX, float originY, float stepX, float stepY, int countX, int countY) noexcept
+		{
+			assert(out.size() == static_cast<std::size_t>(countX) * countY);
+
+			for (int xi = 0; xi < countX; ++xi)
+			{
+				const Lanes::Float x = Lanes::Set(originX + stepX * static_cast<float>(xi));
+				EvaluateRow<Lanes>(out.subspan(static_cast<std::size_t>(xi) * countY, countY), originY, stepY,
+					[&x](const auto& y) { return Evaluate2D<Lanes>(x, y); });
+			}
+		}
+
+		/// <summary>
+		/// <para>格子状の座標 (origin + step * インデックス) について求める</para>
+		/// <para>out[(xi * countY + yi) * countZ + zi] = SimplexNoise::noise(originX + stepX * xi, originY + stepY * yi, originZ + stepZ * zi)</para>
+		/// </summary>
+		static void Noise3DGrid(std::span<float> out, float originX, float originY, float originZ, float stepX, float stepY, float stepZ,
+			int countX, int countY, int countZ) noexcept
+		{
+			assert(out.size() == static_cast<std::size_t>(countX) * countY * countZ);
+
+			for (int xi = 0; xi < countX; ++xi)
+				for (int yi = 0; yi < countY; ++yi)
+				{
+					const Lanes::Float x = Lanes::Set(originX + stepX * static_cast<float>(xi));
+					const Lanes::Float y = Lanes::Set(originY + stepY * static_cast<float>(yi));
+					EvaluateRow<Lanes>(out.subspan((static_cast<std::size_t>(xi) * countY + yi) * countZ, countZ), originZ, stepZ,
+						[&x, &y](const auto& z) { return Evaluate3D<Lanes>(x, y, z); });
+				}
+		}
+
+		/// <summary>
+		/// 1度にまとめて求める座標の数 (ビルドの命令セットで決まる)
+		/// </summary>
+		static constexpr int GetLaneCount() noexcept { return Lanes::Count; }
+
+	private:
+		// 元の実装の perm[] と同じ (SIMD のギャザーで読めるよう、32ビットで持つ)
+		static constexpr std::array<std::int32_t, 256> Permutation =
+		{
+			151, 160, 137, 91, 90, 15,
+			131, 13, 201, 95, 96, 53, 194, 233, 7, 225, 140, 36, 103, 30, 69, 142, 8, 99, 37, 240, 21, 10, 23,
+			190, 6, 148, 247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32, 57, 177, 33,
+			88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175, 74, 165, 71, 134, 139, 48, 27, 166,
+			77, 146, 158, 231, 83, 111, 229, 122, 60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244,
+			102, 143, 54, 65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169, 200, 196,
+			135, 130, 116, 188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64, 52, 217, 226, 250, 124, 123,
+			5, 202, 38, 147, 118, 126, 255, 82, 85, 212, 207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42,
+			223, 183, 170, 213, 119, 248, 152, 2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9,
+			129, 22, 39, 253, 19, 98, 108, 110, 79, 113, 224, 232, 178, 185, 112, 104, 218, 246, 97, 228,
+			251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162, 241, 81, 51, 145, 235, 249, 14, 239, 107,
+			49, 192, 214, 31, 181, 199, 106, 157, 184, 84, 204, 176, 115, 121, 50, 45, 127, 4, 150, 254,
+			138, 236, 205, 93, 222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66, 215, 61, 156, 180,
+		};
+
+		// 1レーン (SIMD が無い時の代わり. マスクは bool)
+		struct ScalarLanes
+		{
+			using Float = float;
+			using Int = std::int32_t;
+			using Mask = bool;
+			static constexpr int Count = 1;
+
+			static Float Load(const float* p) noexcept { return *p; }
+			static void Store(float* p, Float v) noexcept { *p = v; }
+			static Float Set(float v) noexcept { return v; }
+			static Int SetInt(std::int32_t v) noexcept { return v; }
+			static Float LaneIndices() noexcept { return 0.0f; }
+
+			static Float Add(Float a, Float b) noexcept { return a + b; }
+			static Float Sub(Float a, Float b) noexcept { return a - b; }
+			static Float Mul(Float a, Float b) noexcept { return a * b; }
+			static Float Negate(Float a) noexcept { return -a; }
+			static Mask Less(Float a, Float b) noexcept { return a < b; }
+			static Float Select(Mask mask, Float a, Float b) noexcept { return mask ? a : b; }
+
+			static Int AddInt(Int a, Int b) noexcept { return a + b; }
+			static Int AndInt(Int a, std::int32_t b) noexcept { return a & b; }
+			static Mask LessInt(Int a, std::int32_t b) noexcept { return a < b; }
+			static Mask EqualInt(Int a, std::int32_t b) noexcept { return a == b; }
+			static Float ToFloat(Int a) noexcept { return static_cast<float>(a); }
+			static Int Truncate(Float a) noexcept { return static_cast<std::int32_t>(a); }
+			static Int MaskToOne(Mask mask) noexcept { return mask ? 1 : 0; }
+			static Int MaskToMinusOne(Mask mask) noexcept { return mask ? -1 : 0; }
+
+			static Mask And(Mask a, Mask b) noexcept { return a && b; }
+			static Mask Or(Mask a, Mask b) noexcept { return a || b; }
+			static Mask Not(Mask a) noexcept { return !a; }
+
+			static Int Hash(Int i) noexcept { return Permutation[static_cast<std::uint8_t>(i)]; }
+		};
+
+#if defined(__AVX2__)
+		// AVX2 の8レーン
+		struct SimdLanes
+		{
+			using Float = __m256;
+			using Int = __m256i;
+			using Mask = __m256;
+			static constexpr int Count = 8;
+
+			static Float Load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+			static void Store(float* p, Float v) noexcept { _mm256_storeu_ps(p, v); }
+			static Float Set(float v) noexcept { return _mm256_set1_ps(v); }
+			static Int SetInt(std::int32_t v) noexcept { return _mm256_set1_epi32(v); }
+			static Float LaneIndices() noexcept { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+
+			static Float Add(Float a, Float b) noexcept { return _mm256_add_ps(a, b); }
+			static Float Sub(Float a, Float b) noexcept { return _mm256_sub_ps(a, b); }
+			static Float Mul(Float a, Float b) noexcept { return _mm256_mul_ps(a, b); }
+			static Float Negate(Float a) noexcept { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+			static Mask Less(Float a, Float b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			static Float Select(Mask mask, Float a, Float b) noexcept { return _mm256_blendv_ps(b, a, mask); }
+
+			static Int AddInt(Int a, Int b) noexcept { return _mm256_add_epi32(a, b); }
+			static Int AndInt(Int a, std::int32_t b) noexcept { return _mm256_and_si256(a, _mm256_set1_epi32(b)); }
+			static Mask LessInt(Int a, std::int32_t b) noexcept { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(b), a)); }
+			static Mask EqualInt(Int a, std::int32_t b) noexcept { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, _mm256_set1_epi32(b))); }
+			static Float ToFloat(Int a) noexcept { return _mm256_cvtepi32_ps(a); }
+			static Int Truncate(Float a) noexcept { return _mm256_cvttps_epi32(a); }
+			static Int MaskToOne(Mask mask) noexcept { return _mm256_srli_epi32(_mm256_castps_si256(mask), 31); }
+			static Int MaskToMinusOne(Mask mask) noexcept { return _mm256_castps_si256(mask); }
+
+			static Mask And(Mask a, Mask b) noexcept { return _mm256_and_ps(a, b); }
+			static Mask Or(Mask a, Mask b) noexcept { return _mm256_or_ps(a, b); }
+			static Mask Not(Mask a) noexcept { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+
+			static Int Hash(Int i) noexcept
+			{
+				return _mm256_i32gather_epi32(Permutation.data(), _mm256_and_si256(i, _mm256_set1_epi32(0xFF)), 4);
+			}
+		};
+		using Lanes = SimdLanes;
+#elif defined(__SSE2__) || defined(_M_X64)
+		// SSE2 の4レーン (x64 なら必ず使える. ギャザーが無いので、表引きだけは1つずつ行う)
+		struct SimdLanes
+		{
+			using Float = __m128;
+			using Int = __m128i;
+			using Mask = __m128;
+			static constexpr int Count = 4;
+
+			static Float Load(const float* p) noexcept { return _mm_loadu_ps(p); }
+			static void Store(float* p, Float v) noexcept { _mm_storeu_ps(p, v); }
+			static Float Set(float v) noexcept { return _mm_set1_ps(v); }
+			static Int SetInt(std::int32_t v) noexcept { return _mm_set1_epi32(v); }
+			static Float LaneIndices() noexcept { return _mm_setr_ps(0, 1, 2, 3); }
+
+			static Float Add(Float a, Float b) noexcept { return _mm_add_ps(a, b); }
+			static Float Sub(Float a, Float b) noexcept { return _mm_sub_ps(a, b); }
+			static Float Mul(Float a, Float b) noexcept { return _mm_mul_ps(a, b); }
+			static Float Negate(Float a) noexcept { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+			static Mask Less(Float a, Float b) noexcept { return _mm_cmplt_ps(a, b); }
+			static Float Select(Mask mask, Float a, Float b) noexcept { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+			static Int AddInt(Int a, Int b) noexcept { return _mm_add_epi32(a, b); }
+			static Int AndInt(Int a, std::int32_t b) noexcept { return _mm_and_si128(a, _mm_set1_epi32(b)); }
+			static Mask LessInt(Int a, std::int32_t b) noexcept { return _mm_castsi128_ps(_mm_cmplt_epi32(a, _mm_set1_epi32(b))); }
+			static Mask EqualInt(Int a, std::int32_t b) noexcept { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, _mm_set1_epi32(b))); }
+			static Float ToFloat(Int a) noexcept { return _mm_cvtepi32_ps(a); }
+			static Int Truncate(Float a) noexcept { return _mm_cvttps_epi32(a); }
+			static Int MaskToOne(Mask mask) noexcept { return _mm_srli_epi32(_mm_castps_si128(mask), 31); }
+			static Int MaskToMinusOne(Mask mask) noexcept { return _mm_castps_si128(mask); }
+
+			static Mask And(Mask a, Mask b) noexcept { return _mm_and_ps(a, b); }
+			static Mask Or(Mask a, Mask b) noexcept { return _mm_or_ps(a, b); }
+			static Mask Not(Mask a) noexcept { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+
+			static Int Hash(Int i) noexcept
+			{
+				alignas(16) std::int32_t indices[Count];
+				_mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_and_si128(i, _mm_set1_epi32(0xFF)));
+				return _mm_setr_epi32(Permutation[indices[0]], Permutation[indices[1]], Permutation[indices[2]], Permutation[indices[3]]);
+			}
+		};
+		using Lanes = SimdLanes;
+#else
+		using Lanes = ScalarLanes;
+#endif
+
+		// 元の実装の fastfloor() (切り捨てた値が元より大きければ、1つ戻す)
+		template<typename L>
+		static typename L::Int Floor(typename L::Float v) noexcept
+		{
+			const typename L::Int truncated = L::Truncate(v);
+			return L::AddInt(truncated, L::MaskToMinusOne(L::Less(v, L::ToFloat(truncated))));
+		}
+
+		// 1頂点分の寄与 (t = 半径 - 距離^2. 負なら寄与なし)
+		template<typename L>
+		static typename L::Float Contribution(typename L::Float t, typename L::Float gradient) noexcept
+		{
+			const typename L::Float t2 = L::Mul(t, t);
+			return L::Select(L::Less(t, L::Set(0.0f)), L::Set(0.0f), L::Mul(L::Mul(t2, t2), gradient));
+		}
+
+		// 元の実装の grad(hash, x, y)
+		template<typename L>
+		static typename L::Float Gradient2D(typename L::Int hash, typename L::Float x, typename L::Float y) noexcept
+		{
+			const typename L::Int h = L::AndInt(hash, 0x3F);
+			const typename L::Mask isX = L::LessInt(h, 4);
+			const typename L::Float u = L::Select(isX, x, y);
+			const typename L::Float v = L::Mul(L::Set(2.0f), L::Select(isX, y, x));
+			return L::Add(
+				L::Select(L::EqualInt(L::AndInt(h, 1), 1), L::Negate(u), u),
+				L::Select(L::EqualInt(L::AndInt(h, 2), 2), L::Negate(v), v));
+		}
+
+		// 元の実装の grad(hash, x, y, z)
+		template<typename L>
+		static typename L::Float Gradient3D(typename L::Int hash, typename L::Float x, typename L::Float y, typename L::Float z) noexcept
+		{
+			const typename L::Int h = L::AndInt(hash, 15);
+			const typename L::Float u = L::Select(L::LessInt(h, 8), x, y);
+			const typename L::Float v = L::Select(L::LessInt(h, 4), y,
+				L::Select(L::Or(L::EqualInt(h, 12), L::EqualInt(h, 14)), x, z));
+			return L::Add(
+				L::Select(L::EqualInt(L::AndInt(h, 1), 1), L::Negate(u), u),
+				L::Select(L::EqualInt(L::AndInt(h, 2), 2), L::Negate(v), v));
+		}
+
+		// 元の実装の noise(x, y) を、分岐をマスクの選択に置き換えたもの
+		template<typename L>
+		static typename L::Float Evaluate2D(typename L::Float x, typename L::Float y) noexcept
+		{
+			using Float = typename L::Float;
+			using Int = typename L::Int;
+			constexpr float F2 = 0.366025403f;
+			constexpr float G2 = 0.211324865f;
+
+			// 入力を歪ませて、どのセルにいるか求める
+			const Float s = L::Mul(L::Add(x, y), L::Set(F2));
+			const Int i = Floor<L>(L::Add(x, s));
+			const Int j = Floor<L>(L::Add(y, s));
+
+			// セルの原点からの距離
+			const Float t = L::Mul(L::ToFloat(L::AddInt(i, j)), L::Set(G2));
+			const Float x0 = L::Sub(x, L::Sub(L::ToFloat(i), t));
+			const Float y0 = L::Sub(y, L::Sub(L::ToFloat(j), t));
+
+			// 2つ目の頂点 (x0 > y0 なら (1,0), そうでなければ (0,1))
+			const typename L::Mask isLower = L::Less(y0, x0);
+			const Int i1 = L::MaskToOne(isLower);
+			const Int j1 = L::MaskToOne(L::Not(isLower));
+
+			const Float x1 = L::Add(L::Sub(x0, L::ToFloat(i1)), L::Set(G2));
+			const Float y1 = L::Add(L::Sub(y0, L::ToFloat(j1)), L::Set(G2));
+			const Float x2 = L::Add(L::Sub(x0, L::Set(1.0f)), L::Set(2.0f * G2));
+			const Float y2 = L::Add(L::Sub(y0, L::Set(1.0f)), L::Set(2.0f * G2));
+
+			const Int one = L::SetInt(1);
+			const Int gi0 = L::Hash(L::AddInt(i, L::Hash(j)));
+			const Int gi1 = L::Hash(L::AddInt(L::AddInt(i, i1), L::Hash(L::AddInt(j, j1))));
+			const Int gi2 = L::Hash(L::AddInt(L::AddInt(i, one), L::Hash(L::AddInt(j, one))));
+
+			const auto distance = [](Float dx, Float dy) { return L::Sub(L::Sub(L::Set(0.5f), L::Mul(dx, dx)), L::Mul(dy, dy)); };
+			const Float n0 = Contribution<L>(distance(x0, y0), Gradient2D<L>(gi0, x0, y0));
+			const Float n1 = Contribution<L>(distance(x1, y1), Gradient2D<L>(gi1, x1, y1));
+			const Float n2 = Contribution<L>(distance(x2, y2), Gradient2D<L>(gi2, x2, y2));
+			return L::Mul(L::Set(45.23065f), L::Add(L::Add(n0, n1), n2));
+		}
+
+		// 元の実装の noise(x, y, z) を、分岐をマスクの選択に置き換えたもの
+		template<typename L>
+		static typename L::Float Evaluate3D(typename L::Float x, typename L::Float y, typename L::Float z) noexcept
+		{
+			using Float = typename L::Float;
+			using Int = typename L::Int;
+			using Mask = typename L::Mask;
+			constexpr float F3 = 1.0f / 3.0f;
+			constexpr float G3 = 1.0f / 6.0f;
+
+			// 入力を歪ませて、どのセルにいるか求める
+			const Float s = L::Mul(L::Add(L::Add(x, y), z), L::Set(F3));
+			const Int i = Floor<L>(L::Add(x, s));
+			const Int j = Floor<L>(L::Add(y, s));
+			const Int k = Floor<L>(L::Add(z, s));
+
+			// セルの原点からの距離
+			const Float t = L::Mul(L::ToFloat(L::AddInt(L::AddInt(i, j), k)), L::Set(G3));
+			const Float x0 = L::Sub(x, L::Sub(L::ToFloat(i), t));
+			const Float y0 = L::Sub(y, L::Sub(L::ToFloat(j), t));
+			const Float z0 = L::Sub(z, L::Sub(L::ToFloat(k), t));
+
+			// 2つ目・3つ目の頂点 (元の実装の6通りの分岐を、3つの比較の組み合わせで表したもの)
+			const Mask xy = L::Not(L::Less(x0, y0)); // x0 >= y0
+			const Mask yz = L::Not(L::Less(y0, z0)); // y0 >= z0
+			const Mask xz = L::Not(L::Less(x0, z0)); // x0 >= z0
+			const Mask isI1 = L::And(xy, L::Or(yz, xz));
+			const Mask isJ1 = L::And(L::Not(xy), yz);
+			const Int i1 = L::MaskToOne(isI1);
+			const Int j1 = L::MaskToOne(isJ1);
+			const Int k1 = L::MaskToOne(L::Not(L::Or(isI1, isJ1)));
+			const Int i2 = L::MaskToOne(L::Or(xy, L::And(yz, xz)));
+			const Int j2 = L::MaskToOne(L::Or(L::Not(xy), yz));
+			const Int k2 = L::MaskToOne(L::Or(L::Not(yz), L::And(L::Not(xy), L::Not(xz))));
+
+			const Float x1 = L::Add(L::Sub(x0, L::ToFloat(i1)), L::Set(G3));
+			const Float y1 = L::Add(L::Sub(y0, L::ToFloat(j1)), L::Set(G3));
+			const Float z1 = L::Add(L::Sub(z0, L::ToFloat(k1)), L::Set(G3));
+			const Float x2 = L::Add(L::Sub(x0, L::ToFloat(i2)), L::Set(2.0f * G3));
+			const Float y2 = L::Add(L::Sub(y0, L::ToFloat(j2)), L::Set(2.0f * G3));
+			const Float z2 = L::Add(L::Sub(z0, L::ToFloat(k2)), L::Set(2.0f * G3));
+			const Float x3 = L::Add(L::Sub(x0, L::Set(1.0f)), L::Set(3.0f * G3));
+			const Float y3 = L::Add(L::Sub(y0, L::Set(1.0f)), L::Set(3.0f * G3));
+			const Float z3 = L::Add(L::Sub(z0, L::Set(1.0f)), L::Set(3.0f * G3));
+
+			const Int one = L::SetInt(1);
+			const auto hash3 = [](Int a, Int b, Int c) { return L::Hash(L::AddInt(a, L::Hash(L::AddInt(b, L::Hash(c))))); };
+			const Int gi0 = hash3(i, j, k);
+			const Int gi1 = hash3(L::AddInt(i, i1), L::AddInt(j, j1), L::AddInt(k, k1));
+			const Int gi2 = hash3(L::AddInt(i, i2), L::AddInt(j, j2), L::AddInt(k, k2));
+			const Int gi3 = hash3(L::AddInt(i, one), L::AddInt(j, one), L::AddInt(k, one));
+
+			const auto distance = [](Float dx, Float dy, Float dz)
+				{
+					return L::Sub(L::Sub(L::Sub(L::Set(0.6f), L::Mul(dx, dx)), L::Mul(dy, dy)), L::Mul(dz, dz));
+				};
+			const Float n0 = Contribution<L>(distance(x0, y0, z0), Gradient3D<L>(gi0, x0, y0, z0));
+			const Float n1 = Contribution<L>(distance(x1, y1, z1), Gradient3D<L>(gi1, x1, y1, z1));
+			const Float n2 = Contribution<L>(distance(x2, y2, z2), Gradient3D<L>(gi2, x2, y2, z2));
+			const Float n3 = Contribution<L>(distance(x3, y3, z3), Gradient3D<L>(gi3, x3, y3, z3));
+			return L::Mul(L::Set(32.0f), L::Add(L::Add(L::Add(n0, n1), n2), n3));
+		}
+
+		// 座標の配列を、レーン数ずつ評価する (端数は、0 で埋めたレーンで評価して必要な分だけ書き戻す)
+		template<typename L, std::size_t N, typename TEvaluate>
+		static void EvaluateArray(const std::array<std::span<const float>, N>& inputs, std::span<float> out, const TEvaluate& evaluate) noexcept
+		{
+			for (const std::span<const float>& input : inputs)
+				assert(input.size() == out.size());
+
+			const std::size_t count = out.size();
+			std::size_t begin = 0;
+			for (; begin + L::Count <= count; begin += L::Count)
+			{
+				std::array<typename L::Float, N> lanes;
+				for (std::size_t n = 0; n < N; ++n)
+					lanes[n] = L::Load(inputs[n].data() + begin);
+				L::Store(out.data() + begin, std::apply(evaluate, lanes));
+			}
+
+			if (begin < count)
+			{
+				std::array<typename L::Float, N> lanes;
+				for (std::size_t n = 0; n < N; ++n)
+				{
+					std::array<float, L::Count> padded = {};
+					std::copy(inputs[n].begin() + begin, inputs[n].end(), padded.begin());
+					lanes[n] = L::Load(padded.data());
+				}
+				std::array<float, L::Count> result;
+				L::Store(result.data(), std::apply(evaluate, lanes));
+				std::copy_n(result.begin(), count - begin, out.begin() + begin);
+			}
+		}
+
+		// 格子の1列 (最後の軸の座標 = origin + step * インデックス) を、レーン数ずつ評価する
+		template<typename L, typename TEvaluate>
+		static void EvaluateRow(std::span<float> out, float origin, float step, const TEvaluate& evaluate) noexcept
+		{
+			const int count = static_cast<int>(out.size());
+			for (int begin = 0; begin < count; begin += L::Count)
+			{
+				// 1つずつ求めた時と同じ値になるよう、インデックスを float にしてから掛ける
+				const typename L::Float indices = L::Add(L::Set(static_cast<float>(begin)), L::LaneIndices());
+				const typename L::Float value = evaluate(L::Add(L::Set(origin), L::Mul(L::Set(step), indices)));
+				if (begin + L::Count <= count)
+				{
+					L::Store(out.data() + begin, value);
+				}
+				else
+				{
+					std::array<float, L::Count> result;
+					L::Store(result.data(), value);
+					std::copy_n(result.begin(), count - begin, out.begin() + begin);
+				}
+			}
+		}
+	};
+}
\ No newline at end of file
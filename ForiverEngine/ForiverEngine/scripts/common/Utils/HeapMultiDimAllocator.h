@@ -3,9 +3,140 @@
 #include <scripts/common/IncludeInternal.h>
 
 #include <memory>
+#include <array>
+#include <cassert>
 
 namespace ForiverEngine
 {
+	/// <summary>
+	/// <para>多次元配列のメモリレイアウト (行優先)</para>
+	/// <para>最後の次元が連続する. [x][y] なら y が連続する</para>
+	/// </summary>
+	struct MultiDimLayoutRowMajor final
+	{
+		template<int Rank>
+		static constexpr int GetOffset(const std::array<int, Rank>& extents, const std::array<int, Rank>& indices) noexcept
+		{
+			int offset = 0;
+			for (int i = 0; i < Rank; ++i)
+				offset = offset * extents[i] + indices[i];
+			return offset;
+		}
+	};
+
+	/// <summary>
+	/// <para>多次元配列のメモリレイアウト (列優先)</para>
+	/// <para>最初の次元が連続する. [x][y] なら x が連続する</para>
+	/// </summary>
+	struct MultiDimLayoutColumnMajor final
+	{
+		template<int Rank>
+		static constexpr int GetOffset(const std::array<int, Rank>& extents, const std::array<int, Rank>& indices) noexcept
+		{
+			int offset = 0;
+			for (int i = Rank - 1; i >= 0; --i)
+				offset = offset * extents[i] + indices[i];
+			return offset;
+		}
+	};
+
+	/// <summary>
+	/// <para>1回の確保で連続したメモリに置く、多次元配列</para>
+	/// <para>アクセスは [x][y][z]... の順 (最後の [] で要素の参照が返る)</para>
+	/// <para>メモリレイアウトは TLayout で指定する (static な GetOffset(extents, indices) を持つ型なら、独自のものも使える)</para>
+	/// <para>assert が有効なビルドでは、各次元のインデックスの範囲をチェックする</para>
+	/// </summary>
+	template<typename T, int Rank, typename TLayout = MultiDimLayoutRowMajor>
+	class MultiDimArray final
+	{
+		static_assert(Rank >= 1, "Rank は1以上である必要がある");
+
+	public:
+		MultiDimArray() = default;
+
+		explicit MultiDimArray(const std::array<int, Rank>& extents)
+			: extents(extents), count(CalculateCount(extents)), values(std::make_unique<T[]>(CalculateCount(extents)))
+		{
+		}
+
+		MultiDimArray(MultiDimArray&&) noexcept = default;
+		MultiDimArray& operator=(MultiDimArray&&) noexcept = default;
+
+		/// <summary>
+		/// <para>途中までインデックスを指定した状態</para>
+		/// <para>[] でインデックスを1つずつ追加していき、全て揃ったら要素の参照を返す</para>
+		/// </summary>
+		template<typename TOwner, typename TValue, int Depth>
+		class Slice
+		{
+		public:
+			Slice(TOwner& owner, const std::array<int, Rank>& indices) noexcept : owner(owner), indices(indices) {}
+
+			decltype(auto) operator[](int index) const noexcept
+			{
+				std::array<int, Rank> nextIndices = indices;
+				nextIndices[Depth] = index;
+
+				if constexpr (Depth + 1 == Rank)
+					return static_cast<TValue&>(owner.At(nextIndices));
+				else
+					return Slice<TOwner, TValue, Depth + 1>(owner, nextIndices);
+			}
+
+		private:
+			TOwner& owner;
+			std::array<int, Rank> indices;
+		};
+
+		decltype(auto) operator[](int index) noexcept
+		{
+			return Slice<MultiDimArray, T, 0>(*this, {})[index];
+		}
+		decltype(auto) operator[](int index) const noexcept
+		{
+			return Slice<const MultiDimArray, const T, 0>(*this, {})[index];
+		}
+
+		T& At(const std::array<int, Rank>& indices) noexcept
+		{
+			return values[GetOffset(indices)];
+		}
+		const T& At(const std::array<int, Rank>& indices) const noexcept
+		{
+			return values[GetOffset(indices)];
+		}
+
+		int GetExtent(int dimension) const noexcept { return extents[dimension]; }
+		int GetCount() const noexcept { return count; }
+
+		// 全要素を、メモリ上の順に走査するためのもの
+		T* begin() noexcept { return values.get(); }
+		T* end() noexcept { return values.get() + count; }
+		const T* begin() const noexcept { return values.get(); }
+		const T* end() const noexcept { return values.get() + count; }
+
+	private:
+		std::array<int, Rank> extents = {};
+		int count = 0;
+		std::unique_ptr<T[]> values = nullptr;
+
+		static constexpr int CalculateCount(const std::array<int, Rank>& extents) noexcept
+		{
+			int count = 1;
+			for (int extent : extents)
+				count *= extent;
+			return count;
+		}
+
+		int GetOffset(const std::array<int, Rank>& indices) const noexcept
+		{
+			for (int i = 0; i < Rank; ++i)
+				assert(indices[i] >= 0 && indices[i] < extents[i] && "MultiDimArray の範囲外にアクセスしました");
+
+			return TLayout::template GetOffset<Rank>(extents, indices);
+		}
+	};
+
 	/// <summary>
 	/// ヒープ上に多次元配列を確保するためのユーティリティクラス
 	/// </summary>
@@ -14,6 +145,19 @@ namespace ForiverEngine
 	public:
 		DELETE_DEFAULT_METHODS(HeapMultiDimAllocator);
 
+		// 連続したメモリに置く多次元配列 (1回の確保で済む. 基本はこちらを使う)
+		template<typename T, int Rank, typename TLayout = MultiDimLayoutRowMajor>
+		using ArrayND = MultiDimArray<T, Rank, TLayout>;
+
+		// 各次元のサイズを指定して作成する (x,y,z... の順でアクセス)
+		template<typename T, typename TLayout = MultiDimLayoutRowMajor, typename... TSizes>
+		static ArrayND<T, sizeof...(TSizes), TLayout> CreateArrayND(TSizes... sizes)
+		{
+			return ArrayND<T, sizeof...(TSizes), TLayout>(std::array<int, sizeof...(TSizes)>{ static_cast<int>(sizes)... });
+		}
+
+		// 以下は、ポインタの配列を入れ子にした多次元配列 (次元ごとに確保が発生する)
+
 		template<typename T>
 		using Array1D = std::unique_ptr<T[]>;
 
@@ -2,3 +2,8 @@
 
 #include "./StringUtils.h"
 #include "./HeapMultiDimAllocator.h"
+#include "./VectorPool.h"
+#include "./ThreadPool.h"
+#include "./PaletteArray.h"
+#include "./PagedArray2D.h"
+#include "./RangeAllocator.h"
@@ -0,0 +1,209 @@
+﻿#pragma once
+
+#include <scripts/common/IncludeInternal.h>
+
+#include <memory>
+#include <atomic>
+#include <bit>
+#include <cassert>
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>PageSize x PageSize 要素のページ単位で、必要になった時に確保する2次元配列 (疎な2次元配列)</para>
+	/// <para>ディレクトリ (ページへのポインタの配列) だけを最初に確保し、要素に書き込むためにアクセスした時点で、そのページを確保する</para>
+	/// <para>const でのアクセスではページを確保せず、未確保ならデフォルト値を返す</para>
+	/// <para>ページの確保はロックフリーなので、異なるスレッドから同時にアクセスしてよい (要素自体の排他は行わない)</para>
+	/// <para>アクセスは [x][y] の順. どちらも O(1)</para>
+	/// </summary>
+	template<typename T, int PageSize>
+	class PagedArray2D
+	{
+		static_assert(std::has_single_bit(static_cast<unsigned>(PageSize)), "PageSize は2の冪である必要がある");
+
+	public:
+		static constexpr int PageShift = std::countr_zero(static_cast<unsigned>(PageSize));
+		static constexpr int PageMask = PageSize - 1;
+		static constexpr int PageVolume = PageSize * PageSize;
+
+		PagedArray2D() = default;
+
+		PagedArray2D(int sizeX, int sizeY)
+			: sizeX(sizeX), sizeY(sizeY)
+			, pageCountX((sizeX + PageMask) >> PageShift), pageCountY((sizeY + PageMask) >> PageShift)
+			, directory(std::make_unique<std::atomic<Page*>[]>(pageCountX * pageCountY))
+		{
+		}
+
+		~PagedArray2D()
+		{
+			Clear();
+		}
+
+		PagedArray2D(PagedArray2D&& other) noexcept
+		{
+			*this = std::move(other);
+		}
+
+		PagedArray2D& operator=(PagedArray2D&& other) noexcept
+		{
+			Clear();
+			sizeX = other.sizeX;
+			sizeY = other.sizeY;
+			pageCountX = other.pageCountX;
+			pageCountY = other.pageCountY;
+			directory = std::move(other.directory);
+			allocatedPageCount.store(other.allocatedPageCount.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+
+		/// <summary>
+		/// 書き込み用の行 (未確保のページにアクセスすると、その場で確保する)
+		/// </summary>
+		class Row
+		{
+		public:
+			Row(PagedArray2D& owner, int x) noexcept : owner(owner), x(x) {}
+
+			T& operator[](int y) const
+			{
+				return owner.At(x, y);
+			}
+
+		private:
+			PagedArray2D& owner;
+			int x;
+		};
+
+		/// <summary>
+		/// 読み取り用の行 (未確保のページにアクセスすると、デフォルト値を返す)
+		/// </summary>
+		class ConstRow
+		{
+		public:
+			ConstRow(const PagedArray2D& owner, int x) noexcept : owner(owner), x(x) {}
+
+			const T& operator[](int y) const noexcept
+			{
+				return owner.At(x, y);
+			}
+
+		private:
+			const PagedArray2D& owner;
+			int x;
+		};
+
+		Row operator[](int x) noexcept { return Row(*this, x); }
+		ConstRow operator[](int x) const noexcept { return ConstRow(*this, x); }
+
+		T& At(int x, int y)
+		{
+			assert(x >= 0 && x < sizeX && y >= 0 && y < sizeY && "PagedArray2D の範囲外にアクセスしました");
+
+			std::atomic<Page*>& slot = directory[GetPageIndex(x, y)];
+			Page* page = slot.load(std::memory_order_acquire);
+			if (!page)
+				page = InstallPage(slot);
+
+			return page->values[GetLocalIndex(x, y)];
+		}
+
+		const T& At(int x, int y) const noexcept
+		{
+			assert(x >= 0 && x < sizeX && y >= 0 && y < sizeY && "PagedArray2D の範囲外にアクセスしました");
+
+			const Page* page = directory[GetPageIndex(x, y)].load(std::memory_order_acquire);
+			if (!page)
+				return DefaultValue;
+
+			return page->values[GetLocalIndex(x, y)];
+		}
+
+		/// <summary>
+		/// 要素を含むページが確保済みか
+		/// </summary>
+		bool IsAllocated(int x, int y) const noexcept
+		{
+			return directory[GetPageIndex(x, y)].load(std::memory_order_acquire) != nullptr;
+		}
+
+		/// <summary>
+		/// <para>要素を含むページを解放する (ページ内の全要素がデフォルト値に戻る)</para>
+		/// <para>そのページに他のスレッドがアクセスしていないこと、参照が残っていないことを、呼び出し側で保証すること</para>
+		/// </summary>
+		void ReleasePage(int x, int y) noexcept
+		{
+			Page* page = directory[GetPageIndex(x, y)].exchange(nullptr, std::memory_order_acq_rel);
+			if (!page)
+				return;
+
+			delete page;
+			allocatedPageCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		int GetSizeX() const noexcept { return sizeX; }
+		int GetSizeY() const noexcept { return sizeY; }
+		int GetAllocatedPageCount() const noexcept { return allocatedPageCount.load(std::memory_order_relaxed); }
+
+		/// <summary>
+		/// 使用しているメモリ量 [byte] を返す (要素が別途ヒープに持つものは含まない)
+		/// </summary>
+		std::size_t GetMemoryUsage() const noexcept
+		{
+			return sizeof(std::atomic<Page*>) * pageCountX * pageCountY
+				+ sizeof(Page) * GetAllocatedPageCount();
+		}
+
+	private:
+		struct Page
+		{
+			T values[PageVolume]; // new Page() で値初期化される
+		};
+
+		// 未確保のページの要素を読んだ時に返す値
+		inline static const T DefaultValue{};
+
+		int sizeX = 0;
+		int sizeY = 0;
+		int pageCountX = 0;
+		int pageCountY = 0;
+		std::unique_ptr<std::atomic<Page*>[]> directory = nullptr;
+		std::atomic<int> allocatedPageCount = 0;
+
+		int GetPageIndex(int x, int y) const noexcept
+		{
+			return (x >> PageShift) * pageCountY + (y >> PageShift);
+		}
+
+		static constexpr int GetLocalIndex(int x, int y) noexcept
+		{
+			return ((x & PageMask) << PageShift) | (y & PageMask);
+		}
+
+		// ページを確保してディレクトリに登録する
+		// 他のスレッドが先に登録していたら、自分の確保した分は捨ててそちらを使う
+		Page* InstallPage(std::atomic<Page*>& slot)
+		{
+			Page* newPage = new Page();
+			Page* expected = nullptr;
+			if (slot.compare_exchange_strong(expected, newPage, std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				allocatedPageCount.fetch_add(1, std::memory_order_relaxed);
+				return newPage;
+			}
+
+			delete newPage;
+			return expected;
+		}
+
+		void Clear() noexcept
+		{
+			if (!directory)
+				return;
+
+			for (int i = 0; i < pageCountX * pageCountY; ++i)
+				delete directory[i].exchange(nullptr, std::memory_order_acq_rel);
+			allocatedPageCount.store(0, std::memory_order_relaxed);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,405 @@
+﻿#pragma once
+
+#include <scripts/common/IncludeInternal.h>
+#include "./VectorPool.h"
+
+#include <vector>
+#include <array>
+#include <span>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>パレット圧縮した、固定長の1次元配列</para>
+	/// <para>値の種類 (パレット) を別に持ち、各要素はパレットのインデックスとして 1/2/4/8/16 bit に詰めて保持する</para>
+	/// <para>新しい種類の値が書き込まれてパレットに収まらなくなったら、bit 幅を倍にして詰め直す</para>
+	/// <para>全要素が同じ値 (一様) の間は 0 bit として扱い、ワード配列を確保しない</para>
+	/// <para>1要素が 64bit ワードを跨がないので、読み取りは分岐なしで行える</para>
+	/// <para>ワード配列のメモリは VectorPool から借り、不要になったら返す</para>
+	/// </summary>
+	template<typename T>
+	class PaletteArray
+	{
+	public:
+		static constexpr int BitsPerEntryMax = 16;
+		static constexpr int InlinePaletteCapacity = 16; // この数までのパレットは、ヒープを使わずに保持する
+
+		PaletteArray() : PaletteArray(0, T{}) {}
+
+		/// <summary>
+		/// 全要素を initialValue で埋めた状態 (一様) で作成する
+		/// </summary>
+		PaletteArray(int size, const T& initialValue)
+			: size(size)
+		{
+			inlinePalette[0] = initialValue;
+			paletteSize = 1;
+			SetBitsPerEntry(0);
+		}
+
+		PaletteArray(PaletteArray&& other) noexcept
+		{
+			*this = std::move(other);
+		}
+
+		~PaletteArray()
+		{
+			ReleaseWords();
+		}
+
+		// 移動元は、全要素が T{} の一様な状態に戻る (要素数は変わらないので、そのまま読み書きできる)
+		PaletteArray& operator=(PaletteArray&& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			size = other.size;
+			paletteSize = other.paletteSize;
+			inlinePalette = other.inlinePalette;
+			heapPalette = std::move(other.heapPalette);
+			ReleaseWords();
+			words = std::exchange(other.words, {});
+			bitsPerEntry = other.bitsPerEntry;
+			entriesPerWordShift = other.entriesPerWordShift;
+			entriesPerWordMask = other.entriesPerWordMask;
+			entryMask = other.entryMask;
+			RefreshPointers();
+
+			other.ResetToUniform();
+			return *this;
+		}
+
+		T Get(int index) const noexcept
+		{
+			const std::uint64_t word = wordsView[index >> entriesPerWordShift];
+			const int shift = (index & entriesPerWordMask) * bitsPerEntry;
+			return paletteView[static_cast<int>((word >> shift) & entryMask)];
+		}
+
+		void Set(int index, const T& value)
+		{
+			int paletteIndex = FindPaletteIndex(value);
+			if (paletteIndex < 0)
+			{
+				paletteIndex = paletteSize;
+				PushPalette(value);
+
+				// パレットが溢れたら、bit 幅を広げて詰め直す
+				if (paletteSize > (1 << bitsPerEntry))
+					Repack(std::max(bitsPerEntry * 2, 1));
+			}
+			// 一様なままなので、書き込むものが無い
+			else if (bitsPerEntry == 0)
+				return;
+
+			std::uint64_t& word = words[index >> entriesPerWordShift];
+			const int shift = (index & entriesPerWordMask) * bitsPerEntry;
+			word = (word & ~(entryMask << shift)) | (static_cast<std::uint64_t>(paletteIndex) << shift);
+		}
+
+		/// <summary>
+		/// <para>連続した範囲 [begin, begin + count) を、同じ値で埋める</para>
+		/// <para>要素ごとではなく、ワード単位でマスクして書き込む. 全要素を埋めるなら、一様に戻す</para>
+		/// </summary>
+		void Fill(int begin, int count, const T& value)
+		{
+			if (count <= 0)
+				return;
+			if (begin == 0 && count == size)
+			{
+				*this = PaletteArray(size, value);
+				return;
+			}
+
+			int paletteIndex = FindPaletteIndex(value);
+			if (paletteIndex < 0)
+			{
+				paletteIndex = paletteSize;
+				PushPalette(value);
+
+				// パレットが溢れたら、bit 幅を広げて詰め直す
+				if (paletteSize > (1 << bitsPerEntry))
+					Repack(std::max(bitsPerEntry * 2, 1));
+			}
+			// 一様なままなので、書き込むものが無い
+			else if (bitsPerEntry == 0)
+				return;
+
+			// 全要素に paletteIndex を並べたワード (~0 / entryMask は、各要素の最下位ビットだけが立つ)
+			const std::uint64_t pattern = static_cast<std::uint64_t>(paletteIndex) * (~static_cast<std::uint64_t>(0) / entryMask);
+
+			const int end = begin + count;
+			for (int wordIndex = begin >> entriesPerWordShift; wordIndex <= ((end - 1) >> entriesPerWordShift); ++wordIndex)
+			{
+				const int firstEntry = std::max(begin, wordIndex << entriesPerWordShift) & entriesPerWordMask;
+				const int lastEntry = (std::min(end, (wordIndex + 1) << entriesPerWordShift) - 1) & entriesPerWordMask;
+				const int highBit = (lastEntry + 1) * bitsPerEntry - 1;
+				const std::uint64_t mask = ((highBit == 63) ? ~static_cast<std::uint64_t>(0) : ((static_cast<std::uint64_t>(1) << (highBit + 1)) - 1))
+					& (~static_cast<std::uint64_t>(0) << (firstEntry * bitsPerEntry));
+
+				std::uint64_t& word = words[wordIndex];
+				word = (word & ~mask) | (pattern & mask);
+			}
+		}
+
+		/// <summary>
+		/// <para>使われていないパレットを取り除き、最小の bit 幅で詰め直す</para>
+		/// <para>全要素が同じ値になっていたら、一様 (0 bit) に戻してワード配列を解放する</para>
+		/// </summary>
+		void Compact()
+		{
+			if (bitsPerEntry == 0)
+				return;
+
+			// パレットごとの、詰め直した後のインデックスの表
+			// チャンクの生成のたびに全セクションで呼ぶので、ヒープには確保しない (インラインのパレットの分はスタック、それを超えたらプールから借りる)
+			if (paletteSize <= InlinePaletteCapacity)
+			{
+				std::array<int, InlinePaletteCapacity> remap;
+				CompactWithRemap(std::span<int>(remap.data(), paletteSize));
+			}
+			else
+			{
+				std::vector<int> remap = VectorPool<int>::Acquire(paletteSize);
+				remap.resize(paletteSize);
+				CompactWithRemap(remap);
+				VectorPool<int>::Release(std::move(remap));
+			}
+		}
+
+		int GetSize() const noexcept { return size; }
+		int GetBitsPerEntry() const noexcept { return bitsPerEntry; }
+		int GetPaletteSize() const noexcept { return paletteSize; }
+
+		/// <summary>
+		/// 全要素が同じ値か (0 bit で保持しているか)
+		/// </summary>
+		bool IsUniform() const noexcept { return bitsPerEntry == 0; }
+
+		/// <summary>
+		/// パレットの先頭の値を返す (一様ならば、全要素の値と同じ)
+		/// </summary>
+		T GetFirstPaletteValue() const noexcept { return paletteView[0]; }
+
+		/// <summary>
+		/// ヒープ上で使用しているメモリ量 [byte] を返す
+		/// </summary>
+		std::size_t GetMemoryUsage() const noexcept
+		{
+			return heapPalette.capacity() * sizeof(T) + words.capacity() * sizeof(std::uint64_t);
+		}
+
+	private:
+		// 一様な場合に参照する、ダミーのワード (常に 0 番目のパレットを指す)
+		inline static const std::uint64_t ZeroWord = 0;
+
+		int size = 0;
+
+		// パレット
+		// InlinePaletteCapacity 個までは inlinePalette に、それを超えたら全て heapPalette に保持する
+		int paletteSize = 0;
+		std::array<T, InlinePaletteCapacity> inlinePalette{};
+		std::vector<T> heapPalette{};
+		const T* paletteView = nullptr; // 実際に使っている方のパレットを指す
+
+		// パレットのインデックスを詰めた配列
+		std::vector<std::uint64_t> words{};
+		const std::uint64_t* wordsView = nullptr; // 読み取り用 (一様なら ZeroWord を指す)
+		int bitsPerEntry = 0;
+		int entriesPerWordShift = 0; // log2(1ワードに入る要素数)
+		int entriesPerWordMask = 0;  // 1ワードに入る要素数 - 1
+		std::uint64_t entryMask = 0; // 1要素分のビットマスク
+
+		int GetWordCount() const noexcept
+		{
+			return (size + entriesPerWordMask) >> entriesPerWordShift;
+		}
+
+		void RefreshPointers() noexcept
+		{
+			paletteView = heapPalette.empty() ? inlinePalette.data() : heapPalette.data();
+			wordsView = !words.empty() ? words.data() : &ZeroWord;
+		}
+
+		int FindPaletteIndex(const T& value) const noexcept
+		{
+			const T* const end = paletteView + paletteSize;
+			const T* const it = std::find(paletteView, end, value);
+			return (it != end) ? static_cast<int>(it - paletteView) : -1;
+		}
+
+		void PushPalette(const T& value)
+		{
+			if (paletteSize < InlinePaletteCapacity)
+			{
+				inlinePalette[paletteSize] = value;
+			}
+			else
+			{
+				// インラインに収まらなくなったら、全てヒープに移す
+				if (heapPalette.empty())
+					heapPalette.assign(inlinePalette.begin(), inlinePalette.end());
+				heapPalette.push_back(value);
+			}
+
+			++paletteSize;
+			RefreshPointers();
+		}
+
+		std::uint64_t GetPaletteIndex(int index) const noexcept
+		{
+			const std::uint64_t word = wordsView[index >> entriesPerWordShift];
+			return (word >> ((index & entriesPerWordMask) * bitsPerEntry)) & entryMask;
+		}
+
+		// 書き込み先が 0 であることを前提に、インデックスを書き込む
+		void WriteRaw(int index, std::uint64_t paletteIndex) noexcept
+		{
+			words[index >> entriesPerWordShift] |= paletteIndex << ((index & entriesPerWordMask) * bitsPerEntry);
+		}
+
+		// bit 幅を設定し、全てパレットの 0 番目を指す状態にする (0 bit ならワード配列を確保しない)
+		void SetBitsPerEntry(int newBitsPerEntry)
+		{
+			bitsPerEntry = newBitsPerEntry;
+
+			if (newBitsPerEntry == 0)
+			{
+				// インデックスは常に 0 になる (シフトで 0 ワード目を、マスクで 0 番目のパレットを指す)
+				entriesPerWordShift = 31;
+				entriesPerWordMask = 0;
+				entryMask = 0;
+				ReleaseWords();
+			}
+			else
+			{
+				entriesPerWordShift = std::countr_zero(static_cast<unsigned>(64 / newBitsPerEntry));
+				entriesPerWordMask = (1 << entriesPerWordShift) - 1;
+				entryMask = (static_cast<std::uint64_t>(1) << newBitsPerEntry) - 1;
+				ReleaseWords();
+				words = VectorPool<std::uint64_t>::Acquire(GetWordCount());
+				words.resize(GetWordCount(), 0);
+			}
+
+			RefreshPointers();
+		}
+
+		// パレットを T{} の1つだけにして、一様 (0 bit) に戻す (移動元を、読み書きできる状態にする)
+		void ResetToUniform() noexcept
+		{
+			heapPalette = {};
+			inlinePalette[0] = T{};
+			paletteSize = 1;
+			SetBitsPerEntry(0);
+		}
+
+		// ワード配列をプールに返す
+		void ReleaseWords()
+		{
+			if (words.capacity() > 0)
+				VectorPool<std::uint64_t>::Release(std::exchange(words, {}));
+		}
+
+		// Compact() の本体. remap はパレットと同じ要素数の作業領域
+		void CompactWithRemap(std::span<int> remap)
+		{
+			// 使われているパレットを調べる
+			// 全要素が同じインデックスのワード (0 のワードなど) は、1要素だけ見ればよい
+			std::fill(remap.begin(), remap.end(), -1);
+			const std::uint64_t lowBits = ~static_cast<std::uint64_t>(0) / entryMask; // 各要素の最下位ビットだけが立つ
+			for (int wordIndex = 0; wordIndex < GetWordCount(); ++wordIndex)
+			{
+				const std::uint64_t word = words[wordIndex];
+				const int begin = wordIndex << entriesPerWordShift;
+				if (word == (word & entryMask) * lowBits && begin + entriesPerWordMask < size)
+				{
+					remap[word & entryMask] = 0;
+					continue;
+				}
+
+				for (int i = begin; i < std::min(begin + entriesPerWordMask + 1, size); ++i)
+					remap[GetPaletteIndex(i)] = 0;
+			}
+
+			// 全て使われていれば、並びも bit 幅も変わらない (パレットは溢れた時だけ bit 幅を広げるので、既に最小)
+			if (std::find(remap.begin(), remap.end(), -1) == remap.end())
+				return;
+
+			// 使われているパレットに、前から詰めたインデックスを振る
+			int usedPaletteSize = 0;
+			for (int& newIndex : remap)
+			{
+				if (newIndex >= 0)
+					newIndex = usedPaletteSize++;
+			}
+
+			PaletteArray<T> old = std::move(*this);
+
+			// 新しいパレットを作成する
+			size = old.size;
+			paletteSize = 0;
+			for (int i = 0; i < old.paletteSize; ++i)
+			{
+				if (remap[i] >= 0)
+					PushPalette(old.paletteView[i]);
+			}
+
+			int newBitsPerEntry = 0;
+			while ((1 << newBitsPerEntry) < paletteSize)
+				newBitsPerEntry = std::max(newBitsPerEntry * 2, 1);
+			SetBitsPerEntry(newBitsPerEntry);
+
+			if (bitsPerEntry == 0)
+				return;
+			for (int wordIndex = 0; wordIndex < old.GetWordCount(); ++wordIndex)
+			{
+				// 0 番目のパレットが 0 番目のままなら、書き込むものが無い
+				if (old.words[wordIndex] == 0 && remap[0] == 0)
+					continue;
+				const int begin = wordIndex << old.entriesPerWordShift;
+				for (int i = begin; i < std::min(begin + old.entriesPerWordMask + 1, size); ++i)
+					WriteRaw(i, static_cast<std::uint64_t>(remap[old.GetPaletteIndex(i)]));
+			}
+		}
+
+		// bit 幅を変えて、全要素を詰め直す
+		void Repack(int newBitsPerEntry)
+		{
+			assert(newBitsPerEntry <= BitsPerEntryMax && "PaletteArray のパレットが上限を超えました");
+
+			const int oldBitsPerEntry = bitsPerEntry;
+			const int oldEntriesPerWordShift = entriesPerWordShift;
+			const int oldEntriesPerWordMask = entriesPerWordMask;
+			const std::uint64_t oldEntryMask = entryMask;
+			std::vector<std::uint64_t> oldWords = std::exchange(words, {});
+
+			SetBitsPerEntry(newBitsPerEntry);
+
+			// 一様だったなら、全て 0 番目のパレットのままで良い
+			if (oldWords.empty())
+				return;
+
+			for (int wordIndex = 0; wordIndex < static_cast<int>(oldWords.size()); ++wordIndex)
+			{
+				// 0 のワードは、全て 0 番目のパレットのままで良い
+				const std::uint64_t oldWord = oldWords[wordIndex];
+				if (oldWord == 0)
+					continue;
+
+				const int begin = wordIndex << oldEntriesPerWordShift;
+				for (int i = begin; i < std::min(begin + oldEntriesPerWordMask + 1, size); ++i)
+				{
+					const int oldShift = (i & oldEntriesPerWordMask) * oldBitsPerEntry;
+					WriteRaw(i, (oldWord >> oldShift) & oldEntryMask);
+				}
+			}
+
+			VectorPool<std::uint64_t>::Release(std::move(oldWords));
+		}
+	};
+}
\ No newline at end of file
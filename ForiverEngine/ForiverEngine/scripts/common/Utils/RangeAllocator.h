@@ -0,0 +1,194 @@
+﻿#pragma once
+
+#include <scripts/common/IncludeInternal.h>
+
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <algorithm>
+#include <cassert>
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>[0, capacity) の範囲を、連続した区間に切り分けて貸し出す (サブアロケーター)</para>
+	/// <para>実際のメモリは持たず、区間 (オフセット, サイズ) の管理のみを行う (GPU のバッファなどの、大きなページの中身の割り当てに使う)</para>
+	/// <para>空き区間はオフセット順に持ち、先頭から最初に収まる区間を使う (first-fit). 解放時は、隣接する空き区間と結合する</para>
+	/// <para>区間はハンドルで参照する. Defragment() で区間が移動しても、ハンドルはそのまま使える</para>
+	/// </summary>
+	class RangeAllocator
+	{
+	public:
+		using Handle = std::uint32_t;
+		static constexpr Handle InvalidHandle = ~static_cast<Handle>(0);
+
+		// Defragment() で移動した区間 (この順に、同じ容量の中で移動すればよい)
+		struct Move
+		{
+			Handle handle;
+			int fromOffset;
+			int toOffset;
+			int size;
+		};
+
+		RangeAllocator() = default;
+
+		explicit RangeAllocator(int capacity)
+			: capacity(capacity)
+		{
+			assert(capacity > 0);
+			freeRanges.emplace(0, capacity);
+		}
+
+		/// <summary>
+		/// <para>size の区間を確保して、そのハンドルを返す</para>
+		/// <para>収まる空き区間が無ければ、InvalidHandle を返す</para>
+		/// </summary>
+		Handle Allocate(int size)
+		{
+			assert(size > 0);
+
+			const auto it = std::find_if(freeRanges.begin(), freeRanges.end(),
+				[size](const auto& freeRange) { return freeRange.second >= size; });
+			if (it == freeRanges.end())
+				return InvalidHandle;
+
+			const int offset = it->first;
+			const int remainingSize = it->second - size;
+			freeRanges.erase(it);
+			if (remainingSize > 0)
+				freeRanges.emplace(offset + size, remainingSize);
+			usedSize += size;
+
+			Handle handle = InvalidHandle;
+			if (!freeHandles.empty())
+			{
+				handle = freeHandles.back();
+				freeHandles.pop_back();
+			}
+			else
+			{
+				handle = static_cast<Handle>(ranges.size());
+				ranges.emplace_back();
+			}
+			ranges[handle] = Range{ .offset = offset, .size = size };
+			return handle;
+		}
+
+		/// <summary>
+		/// 区間を解放する (隣接する空き区間と結合する)
+		/// </summary>
+		void Free(Handle handle)
+		{
+			assert(IsValid(handle));
+
+			Range& range = ranges[handle];
+			int offset = range.offset;
+			int size = range.size;
+			range = Range{};
+			freeHandles.push_back(handle);
+			usedSize -= size;
+
+			// 後ろの空き区間と結合する
+			const auto next = freeRanges.lower_bound(offset);
+			if (next != freeRanges.end() && next->first == offset + size)
+			{
+				size += next->second;
+				freeRanges.erase(next);
+			}
+			// 前の空き区間と結合する
+			const auto nextAfterMerge = freeRanges.lower_bound(offset);
+			if (nextAfterMerge != freeRanges.begin())
+			{
+				const auto previous = std::prev(nextAfterMerge);
+				if (previous->first + previous->second == offset)
+				{
+					previous->second += size;
+					return;
+				}
+			}
+			freeRanges.emplace(offset, size);
+		}
+
+		/// <summary>
+		/// <para>確保中の区間を、オフセット順に先頭へ詰める (空き区間は末尾の1つになる)</para>
+		/// <para>移動した区間を、移動すべき順に返す (移動先は常に移動元以前なので、この順に memmove すれば中身を壊さない)</para>
+		/// </summary>
+		std::vector<Move> Defragment()
+		{
+			std::vector<Handle> handles = {};
+			handles.reserve(ranges.size() - freeHandles.size());
+			for (Handle handle = 0; handle < static_cast<Handle>(ranges.size()); ++handle)
+			{
+				if (ranges[handle].size > 0)
+					handles.push_back(handle);
+			}
+			std::sort(handles.begin(), handles.end(),
+				[this](Handle a, Handle b) { return ranges[a].offset < ranges[b].offset; });
+
+			std::vector<Move> moves = {};
+			int offset = 0;
+			for (const Handle handle : handles)
+			{
+				Range& range = ranges[handle];
+				if (range.offset != offset)
+				{
+					moves.push_back(Move{ .handle = handle, .fromOffset = range.offset, .toOffset = offset, .size = range.size });
+					range.offset = offset;
+				}
+				offset += range.size;
+			}
+
+			freeRanges.clear();
+			if (offset < capacity)
+				freeRanges.emplace(offset, capacity - offset);
+			return moves;
+		}
+
+		bool IsValid(Handle handle) const noexcept
+		{
+			return handle < ranges.size() && ranges[handle].size > 0;
+		}
+		int GetOffset(Handle handle) const noexcept
+		{
+			assert(IsValid(handle));
+			return ranges[handle].offset;
+		}
+		int GetSize(Handle handle) const noexcept
+		{
+			assert(IsValid(handle));
+			return ranges[handle].size;
+		}
+
+		int GetCapacity() const noexcept { return capacity; }
+		int GetUsedSize() const noexcept { return usedSize; }
+		int GetFreeSize() const noexcept { return capacity - usedSize; }
+		int GetAllocationCount() const noexcept { return static_cast<int>(ranges.size() - freeHandles.size()); }
+		int GetFreeRangeCount() const noexcept { return static_cast<int>(freeRanges.size()); }
+
+		/// <summary>
+		/// 最も大きな空き区間のサイズ (これより大きな区間は、Defragment() しないと確保できない)
+		/// </summary>
+		int GetLargestFreeSize() const noexcept
+		{
+			int largestSize = 0;
+			for (const auto& [offset, size] : freeRanges)
+				largestSize = std::max(largestSize, size);
+			return largestSize;
+		}
+
+	private:
+		// 確保中の区間 (解放済みのハンドルは size = 0)
+		struct Range
+		{
+			int offset = 0;
+			int size = 0;
+		};
+
+		int capacity = 0;
+		int usedSize = 0;
+		std::vector<Range> ranges;        // インデックスはハンドル
+		std::vector<Handle> freeHandles;  // 再利用するハンドル
+		std::map<int, int> freeRanges;    // 空き区間 (オフセット -> サイズ)
+	};
+}
\ No newline at end of file
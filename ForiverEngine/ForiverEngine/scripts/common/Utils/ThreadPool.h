@@ -0,0 +1,85 @@
+﻿#pragma once
+
+#include <scripts/common/IncludeInternal.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <algorithm>
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>常駐するワーカースレッドで、ジョブを投入順に実行するスレッドプール (シングルトン)</para>
+	/// <para>ワーカーは初回の投入時に起動し、プロセスの終了まで使い回す (スレッドローカルなキャッシュを、ジョブ間で再利用できるように)</para>
+	/// <para>ジョブの完了は待たないので、完了の通知はジョブ自身が行う</para>
+	/// </summary>
+	class ThreadPool final
+	{
+	public:
+		DELETE_DEFAULT_METHODS(ThreadPool);
+
+		/// <summary>
+		/// ジョブを投入する. 空いているワーカーが、投入順に実行する
+		/// </summary>
+		static void Enqueue(std::function<void()>&& job)
+		{
+			State& state = GetState();
+			{
+				const std::lock_guard<std::mutex> lock(state.mutex);
+				state.jobs.push_back(std::move(job));
+			}
+			state.condition.notify_one();
+		}
+
+		static int GetWorkerCount()
+		{
+			return GetState().workerCount;
+		}
+
+	private:
+		struct State
+		{
+			std::mutex mutex{};
+			std::condition_variable condition{};
+			std::deque<std::function<void()>> jobs{};
+			int workerCount = 0;
+		};
+
+		// ワーカーは終了しないので、状態はプロセスの終了まで解放しない (静的オブジェクトの破棄順に依存しないため)
+		static State& GetState()
+		{
+			static State* const state = CreateState();
+			return *state;
+		}
+
+		static State* CreateState()
+		{
+			State* const state = new State();
+
+			// メインスレッドの分を1つ空けておく
+			state->workerCount = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+			for (int i = 0; i < state->workerCount; ++i)
+				std::thread([state]() { RunWorker(*state); }).detach();
+
+			return state;
+		}
+
+		[[noreturn]] static void RunWorker(State& state)
+		{
+			while (true)
+			{
+				std::function<void()> job = {};
+				{
+					std::unique_lock<std::mutex> lock(state.mutex);
+					state.condition.wait(lock, [&state]() { return !state.jobs.empty(); });
+					job = std::move(state.jobs.front());
+					state.jobs.pop_front();
+				}
+				job();
+			}
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+﻿#pragma once
+
+#include <scripts/common/IncludeInternal.h>
+
+#include <vector>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <algorithm>
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>std::vector の確保済みメモリを使い回すための、スレッドセーフなプール (型ごとのシングルトン)</para>
+	/// <para>容量を 2 の冪のサイズクラスに分けて、空の std::vector として保持する</para>
+	/// <para>各スレッドは少数をスレッドローカルに保持し、溢れた/足りない分だけ共有の保管庫とやりとりする (ロックの競合を減らすため)</para>
+	/// <para>保持する量はバイト数で制限し、上限を超える分はそのまま解放する. 保持しているバイト数は GetStats() で取得できる</para>
+	/// <para>サイズクラスの範囲外の容量は、プールを使わずに通常通り確保・解放する</para>
+	/// </summary>
+	template<typename T>
+	class VectorPool final
+	{
+	public:
+		DELETE_DEFAULT_METHODS(VectorPool);
+
+		static constexpr int MinClassShift = 6;  // 最小のサイズクラス (要素数 2^6)
+		static constexpr int MaxClassShift = 20; // 最大のサイズクラス (要素数 2^20)
+		static constexpr int ClassCount = MaxClassShift - MinClassShift + 1;
+		static constexpr std::size_t LocalCacheCapacityBytes = 2ull * 1024 * 1024;   // 1スレッドが保持する最大のバイト数 (全サイズクラスの合計)
+		static constexpr std::size_t SharedCacheCapacityBytes = 16ull * 1024 * 1024; // 共有の保管庫が保持する最大のバイト数 (全サイズクラスの合計)
+
+		struct Stats
+		{
+			std::uint64_t hitCount;      // プールから取り出せた回数
+			std::uint64_t missCount;     // プールが空で、新たに確保した回数
+			std::size_t retainedBytes;   // プールが保持しているメモリ量 [byte] (全スレッドの合計)
+		};
+
+		/// <summary>
+		/// <para>容量が minCapacity 以上の、空の std::vector を取り出す</para>
+		/// <para>プールが空なら、サイズクラスの容量で新たに確保する</para>
+		/// </summary>
+		static std::vector<T> Acquire(std::size_t minCapacity)
+		{
+			std::vector<T> vector = {};
+
+			const int classIndex = GetClassIndexToAcquire(minCapacity);
+			if (classIndex < 0)
+			{
+				vector.reserve(minCapacity);
+				return vector;
+			}
+
+			if (TryPop(classIndex, vector))
+			{
+				hitCount.fetch_add(1, std::memory_order_relaxed);
+				return vector;
+			}
+
+			missCount.fetch_add(1, std::memory_order_relaxed);
+			vector.reserve(static_cast<std::size_t>(1) << (classIndex + MinClassShift));
+			return vector;
+		}
+
+		/// <summary>
+		/// <para>std::vector をプールに返す (要素は破棄され、確保済みのメモリだけが残る)</para>
+		/// <para>サイズクラスの範囲外の容量、またはプールが一杯なら、そのまま解放する</para>
+		/// </summary>
+		static void Release(std::vector<T>&& vector)
+		{
+			const int classIndex = GetClassIndexToRelease(vector.capacity());
+			if (classIndex < 0)
+			{
+				std::vector<T>().swap(vector);
+				return;
+			}
+
+			vector.clear();
+			Push(classIndex, std::move(vector));
+		}
+
+		/// <summary>
+		/// <para>要素数に見合ったサイズクラスの std::vector に詰め替えて返す</para>
+		/// <para>元の std::vector (作業用の大きいもの) はプールに返す</para>
+		/// </summary>
+		static std::vector<T> ShrinkToClass(std::vector<T>&& vector)
+		{
+			std::vector<T> shrinked = Acquire(vector.size());
+			shrinked.assign(vector.begin(), vector.end());
+			Release(std::move(vector));
+			return shrinked;
+		}
+
+		static Stats GetStats() noexcept
+		{
+			return Stats
+			{
+				.hitCount = hitCount.load(std::memory_order_relaxed),
+				.missCount = missCount.load(std::memory_order_relaxed),
+				.retainedBytes = retainedBytes.load(std::memory_order_relaxed),
+			};
+		}
+
+	private:
+		using Bucket = std::vector<std::vector<T>>;
+
+		// スレッドローカルの保持分 (ThreadPool のワーカーは常駐するので、ジョブをまたいで使い回される)
+		// スレッド終了時に、まとめて共有の保管庫に戻す
+		struct LocalCache
+		{
+			std::array<Bucket, ClassCount> buckets{};
+			std::size_t bytes = 0;
+
+			~LocalCache()
+			{
+				// この後 (静的オブジェクトの破棄など) にこのスレッドから返されたものは、共有の保管庫とやりとりする
+				isLocalCacheDestroyed = true;
+
+				const std::lock_guard<std::mutex> lock(sharedMutex);
+				for (int i = 0; i < ClassCount; ++i)
+				{
+					for (std::vector<T>& vector : buckets[i])
+					{
+						retainedBytes.fetch_sub(GetBytes(vector), std::memory_order_relaxed);
+						PushSharedLocked(i, std::move(vector));
+					}
+				}
+			}
+		};
+
+		inline static thread_local LocalCache localCache{};
+		inline static thread_local bool isLocalCacheDestroyed = false;
+
+		inline static std::mutex sharedMutex{};
+		inline static std::array<Bucket, ClassCount> sharedBuckets{};
+		inline static std::size_t sharedBytes = 0; // sharedMutex で保護する
+
+		inline static std::atomic<std::uint64_t> hitCount = 0;
+		inline static std::atomic<std::uint64_t> missCount = 0;
+		inline static std::atomic<std::size_t> retainedBytes = 0;
+
+		static std::size_t GetBytes(const std::vector<T>& vector) noexcept
+		{
+			return vector.capacity() * sizeof(T);
+		}
+
+		// 取り出す時は、容量が足りるよう切り上げる
+		static int GetClassIndexToAcquire(std::size_t capacity) noexcept
+		{
+			const int shift = std::max(static_cast<int>(std::bit_width(capacity > 0 ? capacity - 1 : 0)), MinClassShift);
+			return (shift <= MaxClassShift) ? shift - MinClassShift : -1;
+		}
+
+		// 返す時は、そのサイズクラスとして使えるよう切り捨てる
+		static int GetClassIndexToRelease(std::size_t capacity) noexcept
+		{
+			if (capacity < (static_cast<std::size_t>(1) << MinClassShift))
+				return -1;
+			const int shift = std::min(static_cast<int>(std::bit_width(capacity)) - 1, MaxClassShift);
+			return shift - MinClassShift;
+		}
+
+		static bool TryPop(int classIndex, std::vector<T>& outVector)
+		{
+			if (isLocalCacheDestroyed)
+				return TryPopShared(classIndex, outVector);
+
+			Bucket& localBucket = localCache.buckets[classIndex];
+			if (!localBucket.empty())
+			{
+				outVector = std::move(localBucket.back());
+				localBucket.pop_back();
+				localCache.bytes -= GetBytes(outVector);
+				retainedBytes.fetch_sub(GetBytes(outVector), std::memory_order_relaxed);
+				return true;
+			}
+
+			return TryPopShared(classIndex, outVector);
+		}
+
+		static bool TryPopShared(int classIndex, std::vector<T>& outVector)
+		{
+			const std::lock_guard<std::mutex> lock(sharedMutex);
+			Bucket& sharedBucket = sharedBuckets[classIndex];
+			if (sharedBucket.empty())
+				return false;
+
+			outVector = std::move(sharedBucket.back());
+			sharedBucket.pop_back();
+			sharedBytes -= GetBytes(outVector);
+			retainedBytes.fetch_sub(GetBytes(outVector), std::memory_order_relaxed);
+			return true;
+		}
+
+		static void Push(int classIndex, std::vector<T>&& vector)
+		{
+			const std::size_t bytes = GetBytes(vector);
+			if (!isLocalCacheDestroyed && localCache.bytes + bytes <= LocalCacheCapacityBytes)
+			{
+				localCache.buckets[classIndex].push_back(std::move(vector));
+				localCache.bytes += bytes;
+				retainedBytes.fetch_add(bytes, std::memory_order_relaxed);
+				return;
+			}
+
+			PushShared(classIndex, std::move(vector));
+		}
+
+		static void PushShared(int classIndex, std::vector<T>&& vector)
+		{
+			const std::lock_guard<std::mutex> lock(sharedMutex);
+			PushSharedLocked(classIndex, std::move(vector));
+		}
+
+		// sharedMutex をロックした状態で呼ぶ
+		static void PushSharedLocked(int classIndex, std::vector<T>&& vector)
+		{
+			const std::size_t bytes = GetBytes(vector);
+			if (sharedBytes + bytes > SharedCacheCapacityBytes)
+			{
+				// 一杯なので、そのまま解放する
+				std::vector<T>().swap(vector);
+				return;
+			}
+
+			sharedBuckets[classIndex].push_back(std::move(vector));
+			sharedBytes += bytes;
+			retainedBytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+	};
+}
\ No newline at end of file
@@ -243,16 +243,35 @@ namespace ForiverEngine
 		template<typename TVertexData>
 		static std::pair<VertexBufferView, IndexBufferView> CreateMeshViews(const Device& device, const IMesh<TVertexData>& mesh)
 		{
-			const std::vector<TVertexData>& vertices = mesh.GetVertices();           // メッシュのプロパティ
+			const auto [vb, ib, vbv, ibv] = CreateMeshBuffersAndViews(device, mesh);
+			return { vbv, ibv };
+		}
+
+		/// <summary>
+		/// <para>メッシュから 頂点/インデックスバッファ と VBV, IBV を作成して返す</para>
+		/// <para>バッファを後で解放したい場合は、こちらを使う</para>
+		/// </summary>
+		template<typename TVertexData>
+		static std::tuple<GraphicsBuffer, GraphicsBuffer, VertexBufferView, IndexBufferView> CreateMeshBuffersAndViews(
+			const Device& device, const IMesh<TVertexData>& mesh)
+		{
+			const auto [vb, vbv] = CreateVertexBufferAndView(device, mesh.GetVertices());
+			const auto [ib, ibv] = CreateIndexBufferAndView(device, mesh.GetIndices());
+			return { vb, ib, vbv, ibv };
+		}
+
+		/// <summary>
+		/// <para>頂点配列から 頂点バッファ と VBV を作成して返す</para>
+		/// <para>インデックスバッファを他と共有するメッシュは、こちらで頂点バッファのみを作る</para>
+		/// </summary>
+		template<typename TVertexData>
+		static std::pair<GraphicsBuffer, VertexBufferView> CreateVertexBufferAndView(
+			const Device& device, const std::vector<TVertexData>& vertices)
+		{
 			const TVertexData* verticesPtr = vertices.data();                        // 先頭ポインタ
-			const int vertexSize = static_cast<int>(sizeof(vertices[0]));            // 要素1つ分のメモリサイズ
+			const int vertexSize = static_cast<int>(sizeof(TVertexData));            // 要素1つ分のメモリサイズ
 			const int verticesSize = static_cast<int>(vertices.size() * vertexSize); // 全体のメモリサイズ
 
-			const std::vector<std::uint32_t>& indices = mesh.GetIndices();           // メッシュのプロパティ
-			const std::uint32_t* indicesPtr = indices.data();                        // 先頭ポインタ
-			const int indexSize = static_cast<int>(sizeof(indices[0]));              // 要素1つ分のメモリサイズ
-			const int indicesSize = static_cast<int>(indices.size() * indexSize);    // 全体のメモリサイズ
-
 			const GraphicsBuffer vb = D3D12Helper::CreateGraphicsBuffer1D(device, verticesSize, true);
 			if (!vb)
 				ShowError(L"頂点バッファーの作成に失敗しました");
@@ -260,6 +279,19 @@ namespace ForiverEngine
 				ShowError(L"頂点バッファーを GPU 側にコピーすることに失敗しました");
 			const VertexBufferView vbv = D3D12Helper::CreateVertexBufferView(vb, verticesSize, vertexSize);
 
+			return { vb, vbv };
+		}
+
+		/// <summary>
+		/// インデックス配列から インデックスバッファ と IBV を作成して返す
+		/// </summary>
+		static std::pair<GraphicsBuffer, IndexBufferView> CreateIndexBufferAndView(
+			const Device& device, const std::vector<std::uint32_t>& indices)
+		{
+			const std::uint32_t* indicesPtr = indices.data();                        // 先頭ポインタ
+			const int indexSize = static_cast<int>(sizeof(std::uint32_t));           // 要素1つ分のメモリサイズ
+			const int indicesSize = static_cast<int>(indices.size() * indexSize);    // 全体のメモリサイズ
+
 			const GraphicsBuffer ib = D3D12Helper::CreateGraphicsBuffer1D(device, indicesSize, true);
 			if (!ib)
 				ShowError(L"インデックスバッファーの作成に失敗しました");
@@ -267,7 +299,7 @@ namespace ForiverEngine
 				ShowError(L"インデックスバッファーを GPU 側にコピーすることに失敗しました");
 			const IndexBufferView ibv = D3D12Helper::CreateIndexBufferView(ib, indicesSize, Format::R_U32);
 
-			return { vbv, ibv };
+			return { ib, ibv };
 		}
 
 		/// <summary>
@@ -380,6 +412,8 @@ namespace ForiverEngine
 		/// <param name="rtvClearColor">RTV のクリアカラー</param>
 		/// <param name="depthClearValue">DSV のクリア深度値 (ステンシルは使わないので、深度値のみ. [0, 1])</param>
 		/// <param name="indexTotalCountArray">ドローコール時のインデックス総数 (サイズはドローコール数と同じ!)</param>
+		/// <param name="rootConstantsArray">ドローコールごとのルート定数 (空なら書き込まない)</param>
+		/// <param name="baseVertexArray">ドローコールごとの、頂点のインデックスに足す値 (空なら全て 0)</param>
 		static void Draw
 		(
 			// 基本オブジェクト
@@ -397,7 +431,11 @@ namespace ForiverEngine
 			const ViewportScissorRect& viewportScissorRect, PrimitiveTopology primitiveTopology,
 			Color rtvClearColor, float depthClearValue,
 			// ドローコール関連
-			const std::vector<int>& indexTotalCountArray
+			const std::vector<int>& indexTotalCountArray,
+			// ドローコールごとのルート定数 (ルートパラメータのインデックス1に書き込む. 空なら書き込まない)
+			const std::vector<Vector4>& rootConstantsArray = {},
+			// ドローコールごとの BaseVertexLocation (1つの頂点バッファに詰めた、複数のメッシュを描き分ける. 空なら全て 0)
+			const std::vector<int>& baseVertexArray = {}
 		)
 		{
 			// ドローコール数を取得
@@ -407,6 +445,10 @@ namespace ForiverEngine
 				ShowError(L"頂点バッファビューの数と、ドローコール数が一致しません");
 			if (drawCount != static_cast<std::uint32_t>(indexBufferViewArray.size()))
 				ShowError(L"インデックスバッファビューの数と、ドローコール数が一致しません");
+			if (!rootConstantsArray.empty() && drawCount != static_cast<std::uint32_t>(rootConstantsArray.size()))
+				ShowError(L"ルート定数の数と、ドローコール数が一致しません");
+			if (!baseVertexArray.empty() && drawCount != static_cast<std::uint32_t>(baseVertexArray.size()))
+				ShowError(L"BaseVertexLocation の数と、ドローコール数が一致しません");
 
 			D3D12Helper::CommandInvokeResourceBarrierAsTransition(commandList, rt, rtStateOutsideRender, rtStateInsideRender, false);
 			{
@@ -429,12 +471,22 @@ namespace ForiverEngine
 				D3D12Helper::CommandRSSetViewportAndScissorRect(commandList, viewportScissorRect);
 
 				// ドローコール分ループ
+				// 直前のドローコールと同じバッファなら、バインドし直さない
 				for (std::uint32_t i = 0; i < drawCount; ++i)
 				{
-					D3D12Helper::CommandIASetVertexBuffer(commandList, { vertexBufferViewArray[i] });
-					D3D12Helper::CommandIASetIndexBuffer(commandList, indexBufferViewArray[i]);
-
-					D3D12Helper::CommandDrawIndexedInstanced(commandList, indexTotalCountArray[i]);
+					const VertexBufferView& vbv = vertexBufferViewArray[i];
+					const IndexBufferView& ibv = indexBufferViewArray[i];
+					if (i == 0 || vbv.bufferAddress != vertexBufferViewArray[i - 1].bufferAddress || vbv.verticesSize != vertexBufferViewArray[i - 1].verticesSize)
+						D3D12Helper::CommandIASetVertexBuffer(commandList, { vbv });
+					if (i == 0 || ibv.bufferAddress != indexBufferViewArray[i - 1].bufferAddress || ibv.indicesSize != indexBufferViewArray[i - 1].indicesSize)
+						D3D12Helper::CommandIASetIndexBuffer(commandList, ibv);
+					if (!rootConstantsArray.empty())
+						D3D12Helper::CommandSetGraphicsRootConstants(commandList, 1, &rootConstantsArray[i], sizeof(Vector4) / sizeof(float));
+
+					if (baseVertexArray.empty())
+						D3D12Helper::CommandDrawIndexedInstanced(commandList, indexTotalCountArray[i]);
+					else
+						D3D12Helper::CommandDrawIndexedInstanced(commandList, indexTotalCountArray[i], baseVertexArray[i]);
 				}
 			}
 			D3D12Helper::CommandInvokeResourceBarrierAsTransition(commandList, rt, rtStateInsideRender, rtStateOutsideRender, false);
@@ -3,3 +3,5 @@
 #include "./IMesh.h"
 #include "./Mesh.h"
 #include "./MeshQuad.h"
+#include "./TerrainMesh.h"
+#include "./VertexBufferArena.h"
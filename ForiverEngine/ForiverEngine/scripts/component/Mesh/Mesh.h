@@ -24,6 +24,8 @@ namespace ForiverEngine
 		// [テクスチャ構造]
 		// 凡例 : Up, Down, Right, Left, Forward, Backward
 		// 1枚のテクスチャに2つ詰め込んでいるが、読み取りを切り替えるのはシェーダー側で行うので、下半分は無いものとしてUV値を設定する
+		// UV値は面の中での座標 (1ブロック = 1.0) とし、どのマスを読むかは、シェーダー側で法線から決める
+		// (1.0 を超えた分は繰り返すので、複数ブロックをまとめた面でもそのまま貼れる)
 		// [L][R][B][F]
 		// [U][D][ ][ ]
 		// [L][R][B][F]
@@ -37,40 +39,40 @@ namespace ForiverEngine
 			mesh.vertices =
 			{
 				// Up
-				{ Vector4(-0.5f, +0.5f, -0.5f), Vector2(0.00f, 0.50f), Vector3::Up()      , centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, +0.5f, +0.5f), Vector2(0.00f, 0.25f), Vector3::Up()      , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, +0.5f, -0.5f), Vector2(0.25f, 0.50f), Vector3::Up()      , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, +0.5f, +0.5f), Vector2(0.25f, 0.25f), Vector3::Up()      , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, +0.5f, -0.5f), Vector2(0.0f, 1.0f), Vector3::Up()      , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, +0.5f, +0.5f), Vector2(0.0f, 0.0f), Vector3::Up()      , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, +0.5f, -0.5f), Vector2(1.0f, 1.0f), Vector3::Up()      , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, +0.5f, +0.5f), Vector2(1.0f, 0.0f), Vector3::Up()      , centerWorldPosition, textureIndex },
 
 				// Down
-				{ Vector4(-0.5f, -0.5f, +0.5f), Vector2(0.25f, 0.50f), Vector3::Down()    , centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, -0.5f, -0.5f), Vector2(0.25f, 0.25f), Vector3::Down()    , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, -0.5f, +0.5f), Vector2(0.50f, 0.50f), Vector3::Down()    , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, -0.5f, -0.5f), Vector2(0.50f, 0.25f), Vector3::Down()    , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, -0.5f, +0.5f), Vector2(0.0f, 1.0f), Vector3::Down()    , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, -0.5f, -0.5f), Vector2(0.0f, 0.0f), Vector3::Down()    , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, -0.5f, +0.5f), Vector2(1.0f, 1.0f), Vector3::Down()    , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, -0.5f, -0.5f), Vector2(1.0f, 0.0f), Vector3::Down()    , centerWorldPosition, textureIndex },
 
 				// Right
-				{ Vector4(+0.5f, -0.5f, -0.5f), Vector2(0.25f, 0.25f), Vector3::Right()   , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, +0.5f, -0.5f), Vector2(0.25f, 0.00f), Vector3::Right()   , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, -0.5f, +0.5f), Vector2(0.50f, 0.25f), Vector3::Right()   , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, +0.5f, +0.5f), Vector2(0.50f, 0.00f), Vector3::Right()   , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, -0.5f, -0.5f), Vector2(0.0f, 1.0f), Vector3::Right()   , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, +0.5f, -0.5f), Vector2(0.0f, 0.0f), Vector3::Right()   , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, -0.5f, +0.5f), Vector2(1.0f, 1.0f), Vector3::Right()   , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, +0.5f, +0.5f), Vector2(1.0f, 0.0f), Vector3::Right()   , centerWorldPosition, textureIndex },
 
 				// Left
-				{ Vector4(-0.5f, -0.5f, +0.5f), Vector2(0.00f, 0.25f), Vector3::Left()    , centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, +0.5f, +0.5f), Vector2(0.00f, 0.00f), Vector3::Left()    , centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, -0.5f, -0.5f), Vector2(0.25f, 0.25f), Vector3::Left()    , centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, +0.5f, -0.5f), Vector2(0.25f, 0.00f), Vector3::Left()    , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, -0.5f, +0.5f), Vector2(0.0f, 1.0f), Vector3::Left()    , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, +0.5f, +0.5f), Vector2(0.0f, 0.0f), Vector3::Left()    , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, -0.5f, -0.5f), Vector2(1.0f, 1.0f), Vector3::Left()    , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, +0.5f, -0.5f), Vector2(1.0f, 0.0f), Vector3::Left()    , centerWorldPosition, textureIndex },
 
 				// Forward
-				{ Vector4(+0.5f, -0.5f, +0.5f), Vector2(0.75f, 0.25f), Vector3::Forward() , centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, +0.5f, +0.5f), Vector2(0.75f, 0.00f), Vector3::Forward() , centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, -0.5f, +0.5f), Vector2(1.00f, 0.25f), Vector3::Forward() , centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, +0.5f, +0.5f), Vector2(1.00f, 0.00f), Vector3::Forward() , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, -0.5f, +0.5f), Vector2(0.0f, 1.0f), Vector3::Forward() , centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, +0.5f, +0.5f), Vector2(0.0f, 0.0f), Vector3::Forward() , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, -0.5f, +0.5f), Vector2(1.0f, 1.0f), Vector3::Forward() , centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, +0.5f, +0.5f), Vector2(1.0f, 0.0f), Vector3::Forward() , centerWorldPosition, textureIndex },
 
 				// Backward
-				{ Vector4(-0.5f, -0.5f, -0.5f), Vector2(0.50f, 0.25f), Vector3::Backward(), centerWorldPosition, textureIndex },
-				{ Vector4(-0.5f, +0.5f, -0.5f), Vector2(0.50f, 0.00f), Vector3::Backward(), centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, -0.5f, -0.5f), Vector2(0.75f, 0.25f), Vector3::Backward(), centerWorldPosition, textureIndex },
-				{ Vector4(+0.5f, +0.5f, -0.5f), Vector2(0.75f, 0.00f), Vector3::Backward(), centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, -0.5f, -0.5f), Vector2(0.0f, 1.0f), Vector3::Backward(), centerWorldPosition, textureIndex },
+				{ Vector4(-0.5f, +0.5f, -0.5f), Vector2(0.0f, 0.0f), Vector3::Backward(), centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, -0.5f, -0.5f), Vector2(1.0f, 1.0f), Vector3::Backward(), centerWorldPosition, textureIndex },
+				{ Vector4(+0.5f, +0.5f, -0.5f), Vector2(1.0f, 0.0f), Vector3::Backward(), centerWorldPosition, textureIndex },
 			};
 			mesh.indices =
 			{
@@ -0,0 +1,493 @@
+﻿#pragma once
+
+#include <scripts/common/Include.h>
+#include <scripts/helper/Include.h>
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>地形の頂点 (VertexDataTerrain) の詰め方と、その復元</para>
+	/// <para>packed : [0, 5) x, [5, 14) y, [14, 19) z, [19, 22) 面の向き, [22, 24) 面の中での頂点番号, [24, 26) 環境遮蔽, [26, 29) 空の遮蔽, [29, 32) 未使用 (0)</para>
+	/// <para>座標は、チャンク内でのブロックの角の格子点 (ブロック (x, y, z) の中心は、格子点 (x, y, z) から +0.5 ずれた位置)</para>
+	/// <para>遮蔽は、メッシュ作成時に焼き込む頂点ごとの暗さ (0 なら遮られていない. 焼き込まないメッシュは 0 のまま)</para>
+	/// <para>texIndex : [0, 16) テクスチャのインデックス, [16, 21) x, [21, 26) z 方向の、ドローコールの原点からのチャンク数, [26, 32) 未使用 (0)</para>
+	/// <para>チャンク数は、複数チャンクのメッシュを1回で描画するためのもの (LOD をリージョン単位でまとめる. それ以外は 0)</para>
+	/// <para>シェーダー (shaders/common/TerrainVertex.hlsl) と同じ内容にすること</para>
+	/// </summary>
+	class TerrainVertex final
+	{
+	public:
+		DELETE_DEFAULT_METHODS(TerrainVertex);
+
+		static constexpr int FaceCount = 6;
+
+		static constexpr int PositionXBits = 5;      // [0, 16]
+		static constexpr int PositionYBits = 9;      // [0, 256]
+		static constexpr int PositionZBits = 5;      // [0, 16]
+		static constexpr int FaceIndexBits = 3;      // [0, 6)
+		static constexpr int CornerIndexBits = 2;    // [0, 4)
+		static constexpr int AmbientOcclusionBits = 2; // [0, MaxAmbientOcclusion]
+		static constexpr int SkyOcclusionBits = 3;     // [0, MaxSkyOcclusion]
+
+		static constexpr int PositionXShift = 0;
+		static constexpr int PositionYShift = PositionXShift + PositionXBits;
+		static constexpr int PositionZShift = PositionYShift + PositionYBits;
+		static constexpr int FaceIndexShift = PositionZShift + PositionZBits;
+		static constexpr int CornerIndexShift = FaceIndexShift + FaceIndexBits;
+		static constexpr int AmbientOcclusionShift = CornerIndexShift + CornerIndexBits;
+		static constexpr int SkyOcclusionShift = AmbientOcclusionShift + AmbientOcclusionBits;
+		static_assert(SkyOcclusionShift + SkyOcclusionBits <= 32);
+
+		static constexpr int TextureIndexBits = 16;  // [0, 65536)
+		static constexpr int ChunkOffsetBits = 5;    // [0, 32)
+		static constexpr int ChunkOffsetXShift = TextureIndexBits;
+		static constexpr int ChunkOffsetZShift = ChunkOffsetXShift + ChunkOffsetBits;
+		static_assert(ChunkOffsetZShift + ChunkOffsetBits <= 32);
+		static constexpr int ChunkOffsetUnit = 16;   // チャンク数1つ分のブロック数 (Chunk::Size と同じ)
+
+		static constexpr int MaxAmbientOcclusion = 3; // 頂点に接する、面の手前の3ブロック (側面2つ + 角) が遮る数 (側面が2つとも遮るなら、角によらず最大)
+		static constexpr int MaxSkyOcclusion = 4;     // 頂点に接する、面の手前の4マスのうち、空が見えない (列の最も高いブロック以下の) マスの数
+
+		// 面一覧 (順番は Up, Down, Right, Left, Forward, Backward. 面のインデックスと同じ)
+		static constexpr Lattice3 FaceNormals[FaceCount] =
+		{
+			Lattice3::Up(),
+			Lattice3::Down(),
+			Lattice3::Right(),
+			Lattice3::Left(),
+			Lattice3::Forward(),
+			Lattice3::Backward(),
+		};
+
+		// 面の4頂点 (左下, 左上, 右下, 右上) の、ブロックの最小の角からのずれ
+		// 1ブロック分の面なら、ブロックの座標 + これ が頂点の格子点になる
+		static constexpr int FaceCornerOffsets[FaceCount][4][3] =
+		{
+			{ { 0, 1, 0 }, { 0, 1, 1 }, { 1, 1, 0 }, { 1, 1, 1 } }, // Up
+			{ { 0, 0, 1 }, { 0, 0, 0 }, { 1, 0, 1 }, { 1, 0, 0 } }, // Down
+			{ { 1, 0, 0 }, { 1, 1, 0 }, { 1, 0, 1 }, { 1, 1, 1 } }, // Right
+			{ { 0, 0, 1 }, { 0, 1, 1 }, { 0, 0, 0 }, { 0, 1, 0 } }, // Left
+			{ { 1, 0, 1 }, { 1, 1, 1 }, { 0, 0, 1 }, { 0, 1, 1 } }, // Forward
+			{ { 0, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 }, { 1, 1, 0 } }, // Backward
+		};
+
+		// FaceCornerOffsets に、面の向き・頂点番号を合わせて詰めたもの (packed の値)
+		// 各成分がビット幅に収まる限り、EncodePosition() の値に足すだけで頂点になる (繰り上がりが起きないため)
+		static constexpr std::array<std::array<std::uint32_t, 4>, FaceCount> FaceCornerPackedOffsets = []()
+			{
+				std::array<std::array<std::uint32_t, 4>, FaceCount> table = {};
+				for (int face = 0; face < FaceCount; ++face)
+					for (int corner = 0; corner < 4; ++corner)
+					{
+						const int (&offset)[3] = FaceCornerOffsets[face][corner];
+						table[face][corner] =
+							(static_cast<std::uint32_t>(offset[0]) << PositionXShift) |
+							(static_cast<std::uint32_t>(offset[1]) << PositionYShift) |
+							(static_cast<std::uint32_t>(offset[2]) << PositionZShift) |
+							(static_cast<std::uint32_t>(face) << FaceIndexShift) |
+							(static_cast<std::uint32_t>(corner) << CornerIndexShift);
+					}
+				return table;
+			}();
+
+		// UV値 = 格子点とこれらの内積 (1ブロック = 1.0. 整数のずれはシェーダーで frac() するので無視できる)
+		// 1ブロック分の面で、左下 (0, 1), 左上 (0, 0), 右下 (1, 1), 右上 (1, 0) になるような向き
+		static constexpr Lattice3 FaceUAxes[FaceCount] =
+		{
+			Lattice3(+1, 0, 0), // Up
+			Lattice3(+1, 0, 0), // Down
+			Lattice3(0, 0, +1), // Right
+			Lattice3(0, 0, -1), // Left
+			Lattice3(-1, 0, 0), // Forward
+			Lattice3(+1, 0, 0), // Backward
+		};
+		static constexpr Lattice3 FaceVAxes[FaceCount] =
+		{
+			Lattice3(0, 0, -1), // Up
+			Lattice3(0, 0, +1), // Down
+			Lattice3(0, -1, 0), // Right
+			Lattice3(0, -1, 0), // Left
+			Lattice3(0, -1, 0), // Forward
+			Lattice3(0, -1, 0), // Backward
+		};
+
+		// 頂点の中身を展開したもの
+		struct Decoded
+		{
+			Lattice3 cornerPosition; // チャンク内での格子点
+			int faceIndex;
+			int cornerIndex;
+			int ambientOcclusion;
+			int skyOcclusion;
+			std::uint32_t texIndex;
+			Lattice2 chunkOffset; // ドローコールの原点からのチャンク数 (x, z)
+		};
+
+		/// <summary>
+		/// 頂点を8バイトに詰める (各値はビット幅に収まっていること)
+		/// </summary>
+		static constexpr VertexDataTerrain Encode(const Lattice3& cornerPosition, int faceIndex, int cornerIndex, std::uint32_t texIndex,
+			int ambientOcclusion = 0, int skyOcclusion = 0) noexcept
+		{
+			assert(0 <= cornerPosition.x && cornerPosition.x < (1 << PositionXBits));
+			assert(0 <= cornerPosition.y && cornerPosition.y < (1 << PositionYBits));
+			assert(0 <= cornerPosition.z && cornerPosition.z < (1 << PositionZBits));
+			assert(0 <= faceIndex && faceIndex < FaceCount);
+			assert(0 <= cornerIndex && cornerIndex < 4);
+
+			const std::uint32_t packed =
+				(static_cast<std::uint32_t>(cornerPosition.x) << PositionXShift) |
+				(static_cast<std::uint32_t>(cornerPosition.y) << PositionYShift) |
+				(static_cast<std::uint32_t>(cornerPosition.z) << PositionZShift) |
+				(static_cast<std::uint32_t>(faceIndex) << FaceIndexShift) |
+				(static_cast<std::uint32_t>(cornerIndex) << CornerIndexShift) |
+				EncodeOcclusion(ambientOcclusion, skyOcclusion);
+			return VertexDataTerrain{ packed, texIndex };
+		}
+
+		/// <summary>
+		/// 遮蔽だけを、packed の形に詰める (他の値に足すだけで頂点になる)
+		/// </summary>
+		static constexpr std::uint32_t EncodeOcclusion(int ambientOcclusion, int skyOcclusion) noexcept
+		{
+			assert(0 <= ambientOcclusion && ambientOcclusion <= MaxAmbientOcclusion);
+			assert(0 <= skyOcclusion && skyOcclusion <= MaxSkyOcclusion);
+
+			return (static_cast<std::uint32_t>(ambientOcclusion) << AmbientOcclusionShift) |
+				(static_cast<std::uint32_t>(skyOcclusion) << SkyOcclusionShift);
+		}
+
+		/// <summary>
+		/// <para>面の4頂点を、書き込む順に並べた頂点番号 (cornerOcclusions : 頂点番号順の EncodeOcclusion() の値)</para>
+		/// <para>共有のインデックスは、左上-右下 の対角線で四角形を2つの三角形に分ける</para>
+		/// <para>遮蔽の大きい2頂点を結ぶ対角線で分けると、暗さが斜めに伸びて見えるので、その時は頂点を90度回して並べ、左下-右上 で分ける (表裏は変わらない)</para>
+		/// </summary>
+		static constexpr std::array<int, 4> GetCornerWriteOrder(const std::array<std::uint32_t, 4>& cornerOcclusions) noexcept
+		{
+			if (IsCornerWriteOrderRotated(cornerOcclusions))
+				return { 2, 0, 3, 1 };
+			return { 0, 1, 2, 3 };
+		}
+		// GetCornerWriteOrder() が、頂点を90度回した並びになるか
+		static constexpr bool IsCornerWriteOrderRotated(const std::array<std::uint32_t, 4>& cornerOcclusions) noexcept
+		{
+			const auto weight = [](std::uint32_t occlusion)
+				{
+					return ExtractBits(occlusion, AmbientOcclusionShift, AmbientOcclusionBits) + ExtractBits(occlusion, SkyOcclusionShift, SkyOcclusionBits);
+				};
+			return weight(cornerOcclusions[1]) + weight(cornerOcclusions[2]) > weight(cornerOcclusions[0]) + weight(cornerOcclusions[3]);
+		}
+
+		/// <summary>
+		/// <para>頂点の texIndex に、ドローコールの原点からのチャンク数 (x, z) を詰める (頂点の texIndex のチャンク数は 0 であること)</para>
+		/// <para>ワールド座標は、チャンク数 * ChunkOffsetUnit ブロックだけずれる</para>
+		/// </summary>
+		static constexpr VertexDataTerrain AddChunkOffset(const VertexDataTerrain& vertex, const Lattice2& chunkOffset) noexcept
+		{
+			assert(0 <= chunkOffset.x && chunkOffset.x < (1 << ChunkOffsetBits));
+			assert(0 <= chunkOffset.y && chunkOffset.y < (1 << ChunkOffsetBits));
+			assert((vertex.texIndex >> TextureIndexBits) == 0);
+
+			return VertexDataTerrain
+			{
+				vertex.packed,
+				vertex.texIndex |
+					(static_cast<std::uint32_t>(chunkOffset.x) << ChunkOffsetXShift) |
+					(static_cast<std::uint32_t>(chunkOffset.y) << ChunkOffsetZShift),
+			};
+		}
+
+		/// <summary>
+		/// 格子点の座標だけを、packed の形に詰める
+		/// </summary>
+		static constexpr std::uint32_t EncodePosition(const Lattice3& cornerPosition) noexcept
+		{
+			return Encode(cornerPosition, 0, 0, 0).packed;
+		}
+
+		/// <summary>
+		/// <para>packedBlockPosition (EncodePosition() の値) のブロックの、faceIndex の向きの面1枚分の4頂点を out に書き込む</para>
+		/// <para>表を引いて足すだけなので、頂点ごとの分岐は無い</para>
+		/// </summary>
+		static void WriteFace(std::span<VertexDataTerrain, 4> out, std::uint32_t packedBlockPosition, int faceIndex, std::uint32_t texIndex) noexcept
+		{
+			assert(0 <= faceIndex && faceIndex < FaceCount);
+
+			const std::array<std::uint32_t, 4>& offsets = FaceCornerPackedOffsets[faceIndex];
+			out[0] = VertexDataTerrain{ packedBlockPosition + offsets[0], texIndex };
+			out[1] = VertexDataTerrain{ packedBlockPosition + offsets[1], texIndex };
+			out[2] = VertexDataTerrain{ packedBlockPosition + offsets[2], texIndex };
+			out[3] = VertexDataTerrain{ packedBlockPosition + offsets[3], texIndex };
+		}
+
+		/// <summary>
+		/// <para>↑に加えて、頂点ごとの遮蔽 (cornerOcclusions : 頂点番号順の EncodeOcclusion() の値) を焼き込む</para>
+		/// <para>頂点は GetCornerWriteOrder() の順に並べる</para>
+		/// </summary>
+		static void WriteFace(std::span<VertexDataTerrain, 4> out, std::uint32_t packedBlockPosition, int faceIndex, std::uint32_t texIndex,
+			const std::array<std::uint32_t, 4>& cornerOcclusions) noexcept
+		{
+			assert(0 <= faceIndex && faceIndex < FaceCount);
+
+			const std::array<std::uint32_t, 4>& offsets = FaceCornerPackedOffsets[faceIndex];
+			const auto vertex = [&](int corner) { return VertexDataTerrain{ packedBlockPosition + offsets[corner] + cornerOcclusions[corner], texIndex }; };
+			// 並びは2通りしか無いので、添字が定数になるよう分けて書く (並びの配列を介して読むより速い)
+			if (IsCornerWriteOrderRotated(cornerOcclusions))
+			{
+				out[0] = vertex(2);
+				out[1] = vertex(0);
+				out[2] = vertex(3);
+				out[3] = vertex(1);
+			}
+			else
+			{
+				out[0] = vertex(0);
+				out[1] = vertex(1);
+				out[2] = vertex(2);
+				out[3] = vertex(3);
+			}
+		}
+
+		/// <summary>
+		/// Encode() の逆変換 (シェーダーと同じビット演算)
+		/// </summary>
+		static constexpr Decoded Decode(const VertexDataTerrain& vertex) noexcept
+		{
+			return Decoded
+			{
+				.cornerPosition = Lattice3(
+					ExtractBits(vertex.packed, PositionXShift, PositionXBits),
+					ExtractBits(vertex.packed, PositionYShift, PositionYBits),
+					ExtractBits(vertex.packed, PositionZShift, PositionZBits)),
+				.faceIndex = ExtractBits(vertex.packed, FaceIndexShift, FaceIndexBits),
+				.cornerIndex = ExtractBits(vertex.packed, CornerIndexShift, CornerIndexBits),
+				.ambientOcclusion = ExtractBits(vertex.packed, AmbientOcclusionShift, AmbientOcclusionBits),
+				.skyOcclusion = ExtractBits(vertex.packed, SkyOcclusionShift, SkyOcclusionBits),
+				.texIndex = static_cast<std::uint32_t>(ExtractBits(vertex.texIndex, 0, TextureIndexBits)),
+				.chunkOffset = Lattice2(
+					ExtractBits(vertex.texIndex, ChunkOffsetXShift, ChunkOffsetBits),
+					ExtractBits(vertex.texIndex, ChunkOffsetZShift, ChunkOffsetBits)),
+			};
+		}
+
+		/// <summary>
+		/// 頂点のワールド座標を求める (chunkOrigin : チャンク (LOD はリージョン) の原点のワールド座標. ドローコールごとにシェーダーに渡す値)
+		/// </summary>
+		static Vector3 CalculateWorldPosition(const Decoded& decoded, const Vector3& chunkOrigin) noexcept
+		{
+			const Vector3 chunkOffset = Vector3(
+				static_cast<float>(decoded.chunkOffset.x * ChunkOffsetUnit), 0.0f, static_cast<float>(decoded.chunkOffset.y * ChunkOffsetUnit));
+			return chunkOrigin + chunkOffset + Vector3(decoded.cornerPosition) - Vector3::One() * 0.5f;
+		}
+
+		/// <summary>
+		/// 頂点の UV値を求める (1ブロック = 1.0)
+		/// </summary>
+		static Vector2 CalculateUV(const Decoded& decoded) noexcept
+		{
+			const Lattice3& uAxis = FaceUAxes[decoded.faceIndex];
+			const Lattice3& vAxis = FaceVAxes[decoded.faceIndex];
+			const Lattice3& p = decoded.cornerPosition;
+			return Vector2(
+				static_cast<float>(p.x * uAxis.x + p.y * uAxis.y + p.z * uAxis.z),
+				static_cast<float>(p.x * vAxis.x + p.y * vAxis.y + p.z * vAxis.z));
+		}
+
+	private:
+		static constexpr int ExtractBits(std::uint32_t value, int shift, int bits) noexcept
+		{
+			return static_cast<int>((value >> shift) & ((1u << bits) - 1));
+		}
+	};
+
+	/// <summary>
+	/// <para>地形のメッシュ (頂点のみを持つ)</para>
+	/// <para>連続する4頂点 (左下, 左上, 右下, 右上) で四角形1枚とする</para>
+	/// <para>インデックスは全ての四角形で同じ並びなので、メッシュごとには持たず、CreateQuadIndices() で作った1つのバッファを共有する</para>
+	/// <para>四角形は面の向きごとにまとめて、FaceLayoutOrder の順に並べる (描画時に、視点から見えない向きの範囲を丸ごと省けるように)</para>
+	/// </summary>
+	struct TerrainMesh
+	{
+		static constexpr int VerticesPerQuad = 4;
+		static constexpr int IndicesPerQuad = 6;
+
+		// 面の向きごとの範囲を、メッシュ内に並べる順 (面のインデックス)
+		// 上面の両隣に側面を置き、視点から見える向き (上面と側面2つ) がなるべく連続するようにする
+		// (太陽の向き (1, -1, 1) から見える Left, Backward, Up は、常に1つの範囲になる)
+		static constexpr std::array<int, TerrainVertex::FaceCount> FaceLayoutOrder = { 3, 5, 0, 2, 4, 1 };
+		// ↑の逆引き (面のインデックス -> 並びの何番目か)
+		static constexpr std::array<int, TerrainVertex::FaceCount> FaceLayoutSlots = []()
+			{
+				std::array<int, TerrainVertex::FaceCount> slots = {};
+				for (int slot = 0; slot < TerrainVertex::FaceCount; ++slot)
+					slots[FaceLayoutOrder[slot]] = slot;
+				return slots;
+			}();
+
+		// 並びの i 番目の向きの四角形の範囲 [offsets[i], offsets[i + 1]) (最後の要素は四角形の数)
+		using FaceQuadOffsets = std::array<int, TerrainVertex::FaceCount + 1>;
+
+		std::vector<VertexDataTerrain> vertices{};
+		FaceQuadOffsets faceQuadOffsets{};
+
+		int GetQuadCount() const noexcept
+		{
+			return static_cast<int>(vertices.size()) / VerticesPerQuad;
+		}
+		// 共有のインデックスバッファのうち、描画に使う数
+		int GetIndexCount() const noexcept
+		{
+			return GetQuadCount() * IndicesPerQuad;
+		}
+		// faceIndex の向きの、最初の四角形
+		int GetFaceQuadBegin(int faceIndex) const noexcept
+		{
+			return faceQuadOffsets[FaceLayoutSlots[faceIndex]];
+		}
+		// faceIndex の向きの四角形の数
+		int GetFaceQuadCount(int faceIndex) const noexcept
+		{
+			const int slot = FaceLayoutSlots[faceIndex];
+			return faceQuadOffsets[slot + 1] - faceQuadOffsets[slot];
+		}
+
+		/// <summary>
+		/// 面の向きごと (インデックスは面のインデックス) の四角形の数から、FaceLayoutOrder の順に並べた範囲を求める
+		/// </summary>
+		static constexpr FaceQuadOffsets CalculateFaceQuadOffsets(const std::array<int, TerrainVertex::FaceCount>& faceQuadCounts) noexcept
+		{
+			FaceQuadOffsets offsets = {};
+			for (int slot = 0; slot < TerrainVertex::FaceCount; ++slot)
+				offsets[slot + 1] = offsets[slot] + faceQuadCounts[FaceLayoutOrder[slot]];
+			return offsets;
+		}
+
+		/// <summary>
+		/// <para>visibleFaceBits (ビット i が面の向き i) の向きの四角形の範囲を、func(最初の四角形, 四角形の数) で列挙する</para>
+		/// <para>連続する範囲は1つにまとめる (四角形の無い向きは、見えなくても範囲を途切れさせない)</para>
+		/// </summary>
+		template<typename TFunc>
+		static void ForEachFaceRange(const FaceQuadOffsets& offsets, std::uint32_t visibleFaceBits, const TFunc& func)
+		{
+			int rangeBegin = -1;
+			for (int slot = 0; slot < TerrainVertex::FaceCount; ++slot)
+			{
+				const bool isEmpty = offsets[slot + 1] == offsets[slot];
+				if (isEmpty)
+					continue;
+
+				const bool isVisible = ((visibleFaceBits >> FaceLayoutOrder[slot]) & 1) != 0;
+				if (isVisible && rangeBegin < 0)
+					rangeBegin = offsets[slot];
+				else if (!isVisible && rangeBegin >= 0)
+				{
+					func(rangeBegin, offsets[slot] - rangeBegin);
+					rangeBegin = -1;
+				}
+			}
+			if (rangeBegin >= 0)
+				func(rangeBegin, offsets[TerrainVertex::FaceCount] - rangeBegin);
+		}
+
+		/// <summary>
+		/// <para>quadCount 枚の四角形分のインデックスを作成する (全ての地形メッシュで共有する)</para>
+		/// <para>時計回りに結線する!! (4k+0, 4k+1, 4k+2), (4k+2, 4k+1, 4k+3)</para>
+		/// </summary>
+		static std::vector<std::uint32_t> CreateQuadIndices(int quadCount)
+		{
+			std::vector<std::uint32_t> indices = std::vector<std::uint32_t>(static_cast<std::size_t>(quadCount) * IndicesPerQuad);
+			for (int quad = 0; quad < quadCount; ++quad)
+			{
+				const std::uint32_t vertexBegin = static_cast<std::uint32_t>(quad) * VerticesPerQuad;
+				std::uint32_t* out = &indices[static_cast<std::size_t>(quad) * IndicesPerQuad];
+				out[0] = vertexBegin + 0;
+				out[1] = vertexBegin + 1;
+				out[2] = vertexBegin + 2;
+				out[3] = vertexBegin + 2;
+				out[4] = vertexBegin + 1;
+				out[5] = vertexBegin + 3;
+			}
+			return indices;
+		}
+
+		/// <summary>
+		/// チャンク内の blockPosition にあるブロックの、faceIndex の向きの面1枚だけのメッシュを作成する
+		/// </summary>
+		static TerrainMesh CreateFace(const Lattice3& blockPosition, int faceIndex, std::uint32_t textureIndex)
+		{
+			TerrainMesh mesh = {};
+			mesh.vertices.resize(VerticesPerQuad);
+			TerrainVertex::WriteFace(std::span<VertexDataTerrain, 4>(mesh.vertices.data(), VerticesPerQuad),
+				TerrainVertex::EncodePosition(blockPosition), faceIndex, textureIndex);
+
+			std::array<int, TerrainVertex::FaceCount> faceQuadCounts = {};
+			faceQuadCounts[faceIndex] = 1;
+			mesh.faceQuadOffsets = CalculateFaceQuadOffsets(faceQuadCounts);
+			return mesh;
+		}
+	};
+
+	/// <summary>
+	/// <para>視点から、どの向きの面が見えうるかを判定する (背面カリングを、メッシュの面の向きの範囲単位で CPU 側で行う)</para>
+	/// <para>範囲 (AABB) 内の全ての面について、表側に視点が来うる向きを残す (保守的に判定するので、見える面を省くことはない)</para>
+	/// </summary>
+	struct TerrainFaceCulling
+	{
+		static constexpr std::uint32_t AllFaceBits = (1u << TerrainVertex::FaceCount) - 1;
+
+		enum class Mode : std::uint8_t
+		{
+			None,         // カリングしない (全ての向きが見える)
+			Perspective,  // 視点の位置から判定する
+			Orthographic, // 視線の向きから判定する (平行投影)
+		};
+
+		Mode mode = Mode::None;
+		Vector3 view = Vector3::Zero(); // Perspective なら視点のワールド座標, Orthographic なら視線の向き
+
+		static TerrainFaceCulling CreatePerspective(const Vector3& viewWorldPosition) noexcept
+		{
+			return TerrainFaceCulling{ .mode = Mode::Perspective, .view = viewWorldPosition };
+		}
+		static TerrainFaceCulling CreateOrthographic(const Vector3& viewDirection) noexcept
+		{
+			return TerrainFaceCulling{ .mode = Mode::Orthographic, .view = viewDirection };
+		}
+
+		/// <summary>
+		/// <para>ワールド座標の範囲 [boundsMin, boundsMax] にある面のうち、見えうる向きを求める (ビット i が面の向き i)</para>
+		/// <para>Perspective : 範囲内の面の平面のどれかより、法線の側に視点があれば見えうる</para>
+		/// <para>Orthographic : 法線が視線と向かい合っていれば見える (範囲によらない)</para>
+		/// </summary>
+		std::uint32_t CalculateVisibleFaceBits(const Vector3& boundsMin, const Vector3& boundsMax) const noexcept
+		{
+			if (mode == Mode::None)
+				return AllFaceBits;
+
+			std::uint32_t faceBits = 0;
+			for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+			{
+				const Lattice3& normal = TerrainVertex::FaceNormals[faceIndex];
+				const float viewOnNormal = normal.x * view.x + normal.y * view.y + normal.z * view.z;
+
+				bool isVisible = false;
+				if (mode == Mode::Perspective)
+				{
+					// 範囲内で、法線の向きに最も奥にある平面
+					const float planeOnNormal =
+						normal.x * (normal.x > 0 ? boundsMin.x : boundsMax.x) +
+						normal.y * (normal.y > 0 ? boundsMin.y : boundsMax.y) +
+						normal.z * (normal.z > 0 ? boundsMin.z : boundsMax.z);
+					isVisible = viewOnNormal > planeOnNormal;
+				}
+				else
+				{
+					isVisible = viewOnNormal < 0.0f;
+				}
+
+				faceBits |= static_cast<std::uint32_t>(isVisible) << faceIndex;
+			}
+			return faceBits;
+		}
+	};
+}
\ No newline at end of file
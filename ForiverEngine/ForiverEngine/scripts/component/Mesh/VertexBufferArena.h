@@ -0,0 +1,209 @@
+﻿#pragma once
+
+#include <scripts/common/Include.h>
+#include <scripts/helper/Include.h>
+
+#include <cstring>
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>多数のメッシュの頂点を、少数の大きな頂点バッファ (ページ) に詰めて持つ</para>
+	/// <para>ページは Map() したままにしておき、メッシュの追加・解放では GPU のバッファを作らない (ページ内の区間は RangeAllocator で管理する)</para>
+	/// <para>同じページのメッシュは、頂点バッファを1度バインドするだけで、BaseVertexLocation をずらして続けて描画できる</para>
+	/// <para>ページの中身を書き換えるので、GPU が描画に使っていない間 (フレームの間) にのみ操作すること</para>
+	/// </summary>
+	template<typename TVertexData>
+	class VertexBufferArena
+	{
+	public:
+		static constexpr int DefaultPageVertexCount = 1 << 20; // ページ1つの頂点数 (これより大きなメッシュは、専用のページを作る)
+
+		// メッシュの頂点の区間 (page < 0 なら無効)
+		struct Slice
+		{
+			int page = -1;
+			RangeAllocator::Handle handle = RangeAllocator::InvalidHandle;
+
+			bool IsValid() const noexcept { return page >= 0; }
+		};
+
+		VertexBufferArena() = default;
+
+		explicit VertexBufferArena(int pageVertexCount)
+			: pageVertexCount(pageVertexCount)
+		{
+		}
+
+		/// <summary>
+		/// <para>頂点を既存のページの空き区間にコピーし、その区間を返す. どのページにも収まらなければ、新しいページを作る</para>
+		/// <para>頂点が空なら、無効な区間を返す</para>
+		/// </summary>
+		Slice Allocate(const Device& device, const std::vector<TVertexData>& vertices)
+		{
+			if (vertices.empty())
+				return Slice{};
+
+			const int vertexCount = static_cast<int>(vertices.size());
+
+			Slice slice = {};
+			for (int page = 0; page < static_cast<int>(pages.size()) && !slice.IsValid(); ++page)
+			{
+				if (!pages[page].buffer)
+					continue;
+				const RangeAllocator::Handle handle = pages[page].allocator.Allocate(vertexCount);
+				if (handle != RangeAllocator::InvalidHandle)
+					slice = Slice{ .page = page, .handle = handle };
+			}
+			if (!slice.IsValid())
+			{
+				const int page = CreatePage(device, std::max(pageVertexCount, vertexCount));
+				slice = Slice{ .page = page, .handle = pages[page].allocator.Allocate(vertexCount) };
+			}
+
+			std::memcpy(pages[slice.page].mappedVertices + GetFirstVertex(slice), vertices.data(), vertices.size() * sizeof(TVertexData));
+			return slice;
+		}
+
+		/// <summary>
+		/// 区間を解放し、無効な区間にする (無効な区間なら何もしない)
+		/// </summary>
+		void Free(Slice& slice)
+		{
+			if (!slice.IsValid())
+				return;
+
+			pages[slice.page].allocator.Free(slice.handle);
+			slice = Slice{};
+		}
+
+		/// <summary>
+		/// <para>断片化したページを1つだけ詰め直し (RangeAllocator::Defragment()), 空になったページを解放する</para>
+		/// <para>区間のハンドルは変わらないので、呼び出し側の Slice はそのまま使える (GetFirstVertex() の値は変わる)</para>
+		/// <para>ページは Map() したままのアップロードヒープなので、詰め直しの読み出しは遅い. 1回の呼び出しで1ページまでにする</para>
+		/// </summary>
+		void Compact()
+		{
+			bool hasDefragmented = false;
+			for (Page& page : pages)
+			{
+				if (!page.buffer)
+					continue;
+
+				if (page.allocator.GetAllocationCount() == 0)
+				{
+					D3D12Helper::ReleaseGraphicsBuffer(page.buffer);
+					page = Page{};
+					continue;
+				}
+
+				if (!hasDefragmented && IsFragmented(page.allocator))
+				{
+					for (const RangeAllocator::Move& move : page.allocator.Defragment())
+					{
+						std::memmove(page.mappedVertices + move.toOffset, page.mappedVertices + move.fromOffset,
+							static_cast<std::size_t>(move.size) * sizeof(TVertexData));
+					}
+					hasDefragmented = true;
+				}
+			}
+		}
+
+		/// <summary>
+		/// 全て解放する
+		/// </summary>
+		void Clear()
+		{
+			for (Page& page : pages)
+				D3D12Helper::ReleaseGraphicsBuffer(page.buffer);
+			pages.clear();
+		}
+
+		// 区間の最初の頂点の、ページ内でのインデックス (ドローコールの BaseVertexLocation)
+		int GetFirstVertex(const Slice& slice) const noexcept
+		{
+			return pages[slice.page].allocator.GetOffset(slice.handle);
+		}
+		int GetVertexCount(const Slice& slice) const noexcept
+		{
+			return slice.IsValid() ? pages[slice.page].allocator.GetSize(slice.handle) : 0;
+		}
+		// ページ全体を指す頂点バッファビュー
+		const VertexBufferView& GetPageVBV(int page) const noexcept
+		{
+			return pages[page].vbv;
+		}
+
+		int GetPageCount() const noexcept
+		{
+			return static_cast<int>(std::count_if(pages.begin(), pages.end(), [](const Page& page) { return static_cast<bool>(page.buffer); }));
+		}
+		// 確保済みの GPU のバッファのサイズ [byte]
+		std::size_t GetReservedSize() const noexcept
+		{
+			std::size_t size = 0;
+			for (const Page& page : pages)
+				size += static_cast<std::size_t>(page.allocator.GetCapacity()) * sizeof(TVertexData);
+			return size;
+		}
+		// 区間が使っているサイズ [byte]
+		std::size_t GetUsedSize() const noexcept
+		{
+			std::size_t size = 0;
+			for (const Page& page : pages)
+				size += static_cast<std::size_t>(page.allocator.GetUsedSize()) * sizeof(TVertexData);
+			return size;
+		}
+
+	private:
+		struct Page
+		{
+			GraphicsBuffer buffer = GraphicsBuffer();
+			VertexBufferView vbv = {};
+			TVertexData* mappedVertices = nullptr;
+			RangeAllocator allocator;
+		};
+
+		int pageVertexCount = DefaultPageVertexCount;
+		std::vector<Page> pages; // 解放したページは空のまま残す (Slice::page のインデックスを変えないため)
+
+		// ページを作成し、そのインデックスを返す (解放済みの枠があれば再利用する)
+		int CreatePage(const Device& device, int vertexCount)
+		{
+			const int size = vertexCount * static_cast<int>(sizeof(TVertexData));
+			const GraphicsBuffer buffer = D3D12Helper::CreateGraphicsBuffer1D(device, size, true);
+			if (!buffer)
+				ShowError(L"頂点バッファー (ページ) の作成に失敗しました");
+
+			// 0 で初期化して、Map() したままにする
+			const std::vector<TVertexData> zeros(static_cast<std::size_t>(vertexCount));
+			void* mappedPtr = nullptr;
+			if (!D3D12Helper::CopyDataFromCPUToGPUThroughGraphicsBuffer1D(buffer, zeros.data(), size, false, &mappedPtr))
+				ShowError(L"頂点バッファー (ページ) を GPU 側にコピーすることに失敗しました");
+
+			Page page = Page
+			{
+				.buffer = buffer,
+				.vbv = D3D12Helper::CreateVertexBufferView(buffer, size, static_cast<int>(sizeof(TVertexData))),
+				.mappedVertices = static_cast<TVertexData*>(mappedPtr),
+				.allocator = RangeAllocator(vertexCount),
+			};
+
+			const auto empty = std::find_if(pages.begin(), pages.end(), [](const Page& page) { return !page.buffer; });
+			if (empty != pages.end())
+			{
+				*empty = std::move(page);
+				return static_cast<int>(empty - pages.begin());
+			}
+			pages.push_back(std::move(page));
+			return static_cast<int>(pages.size()) - 1;
+		}
+
+		// 空きが容量の 1/4 以上あるのに、最大の空き区間が空きの半分未満なら、断片化しているとみなす
+		static bool IsFragmented(const RangeAllocator& allocator) noexcept
+		{
+			const int freeSize = allocator.GetFreeSize();
+			return freeSize * 4 >= allocator.GetCapacity() && allocator.GetLargestFreeSize() * 2 < freeSize;
+		}
+	};
+}
\ No newline at end of file
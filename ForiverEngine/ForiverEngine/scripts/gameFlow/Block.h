@@ -0,0 +1,171 @@
+﻿#pragma once
+
+#include <scripts/common/Include.h>
+
+namespace ForiverEngine
+{
+	enum Block : std::uint32_t
+	{
+		Air = 0,
+		Invalid = 1,
+		Grass = 2,
+		Stone = 3,
+		Dirt = 4,
+		Sand = 5,
+	};
+
+	/// <summary>
+	/// 1種類のブロックの定義
+	/// </summary>
+	struct BlockDefinition
+	{
+		static constexpr int FaceCount = 6; // 面の数 (順番は Up, Down, Right, Left, Forward, Backward)
+
+		Block block;
+		bool isSolid;      // 形を持つ (メッシュを生成する・レイで選択できる)
+		bool isOpaque;     // 不透明 (隣接するブロックの面を遮る)
+		bool isCollidable; // プレイヤーと衝突する
+		bool isEmissive;   // 自ら発光する
+		std::array<std::uint32_t, FaceCount> textureIndices; // 面ごとのテクスチャのインデックス
+
+		// 全ての面で同じテクスチャを使う
+		static constexpr std::array<std::uint32_t, FaceCount> SameTexture(Block block) noexcept
+		{
+			const std::uint32_t textureIndex = static_cast<std::uint32_t>(block);
+			return { textureIndex, textureIndex, textureIndex, textureIndex, textureIndex, textureIndex };
+		}
+	};
+
+	/// <summary>
+	/// <para>ブロックの種類ごとの性質の表 (コンパイル時に構築する)</para>
+	/// <para>性質ごとに配列を分けて持つので、ブロックの値をインデックスにして分岐なしで引ける</para>
+	/// <para>ブロックを追加するときは、enum Block と Definitions に1行ずつ追加するだけでよい</para>
+	/// </summary>
+	class BlockProperties final
+	{
+	public:
+		DELETE_DEFAULT_METHODS(BlockProperties);
+
+		static constexpr int FaceCount = BlockDefinition::FaceCount;
+
+		// enum Block の値の順に並べること
+		static constexpr BlockDefinition Definitions[] =
+		{
+			// block          solid  opaque collide emissive textures
+			{ Block::Air,     false, false, false,  false,   BlockDefinition::SameTexture(Block::Air) },
+			{ Block::Invalid, true,  true,  true,   false,   BlockDefinition::SameTexture(Block::Invalid) },
+			{ Block::Grass,   true,  true,  true,   false,   BlockDefinition::SameTexture(Block::Grass) },
+			{ Block::Stone,   true,  true,  true,   false,   BlockDefinition::SameTexture(Block::Stone) },
+			{ Block::Dirt,    true,  true,  true,   false,   BlockDefinition::SameTexture(Block::Dirt) },
+			{ Block::Sand,    true,  true,  true,   false,   BlockDefinition::SameTexture(Block::Sand) },
+		};
+		static constexpr int Count = static_cast<int>(std::size(Definitions)); // ブロックの種類数
+
+		/// <summary>
+		/// 形を持つか (空気は持たない)
+		/// </summary>
+		static constexpr bool IsSolid(Block block) noexcept
+		{
+			return Solid[GetTableIndex(block)];
+		}
+
+		/// <summary>
+		/// 不透明か (隣接するブロックの面を遮るか)
+		/// </summary>
+		static constexpr bool IsOpaque(Block block) noexcept
+		{
+			return Opaque[GetTableIndex(block)];
+		}
+
+		/// <summary>
+		/// プレイヤーと衝突するか
+		/// </summary>
+		static constexpr bool IsCollidable(Block block) noexcept
+		{
+			return Collidable[GetTableIndex(block)];
+		}
+
+		/// <summary>
+		/// 自ら発光するか
+		/// </summary>
+		static constexpr bool IsEmissive(Block block) noexcept
+		{
+			return Emissive[GetTableIndex(block)];
+		}
+
+		/// <summary>
+		/// 面のテクスチャのインデックスを取得する (faceIndex の順番は Up, Down, Right, Left, Forward, Backward)
+		/// </summary>
+		static constexpr std::uint32_t GetTextureIndex(Block block, int faceIndex) noexcept
+		{
+			return TextureIndices[faceIndex][GetTableIndex(block)];
+		}
+
+	private:
+		static constexpr int GetTableIndex(Block block) noexcept
+		{
+			assert(static_cast<int>(block) < Count);
+			return static_cast<int>(block);
+		}
+
+		// Definitions から、性質ごとの配列を作る
+		static constexpr std::array<bool, Count> Solid = []()
+			{
+				std::array<bool, Count> table{};
+				for (int i = 0; i < Count; ++i)
+					table[i] = Definitions[i].isSolid;
+				return table;
+			}();
+		static constexpr std::array<bool, Count> Opaque = []()
+			{
+				std::array<bool, Count> table{};
+				for (int i = 0; i < Count; ++i)
+					table[i] = Definitions[i].isOpaque;
+				return table;
+			}();
+		static constexpr std::array<bool, Count> Collidable = []()
+			{
+				std::array<bool, Count> table{};
+				for (int i = 0; i < Count; ++i)
+					table[i] = Definitions[i].isCollidable;
+				return table;
+			}();
+		static constexpr std::array<bool, Count> Emissive = []()
+			{
+				std::array<bool, Count> table{};
+				for (int i = 0; i < Count; ++i)
+					table[i] = Definitions[i].isEmissive;
+				return table;
+			}();
+		static constexpr std::array<std::array<std::uint32_t, Count>, FaceCount> TextureIndices = []()
+			{
+				std::array<std::array<std::uint32_t, Count>, FaceCount> table{};
+				for (int faceIndex = 0; faceIndex < FaceCount; ++faceIndex)
+					for (int i = 0; i < Count; ++i)
+						table[faceIndex][i] = Definitions[i].textureIndices[faceIndex];
+				return table;
+			}();
+
+		// 定義の整合性チェック
+		static_assert([]()
+			{
+				for (int i = 0; i < Count; ++i)
+				{
+					if (static_cast<int>(Definitions[i].block) != i)
+						return false;
+				}
+				return true;
+			}(), "BlockProperties::Definitions は、enum Block の値の順に並んでいる必要がある");
+		// ハイトマップは、形を持つブロックを基準にしているため
+		static_assert([]()
+			{
+				for (int i = 0; i < Count; ++i)
+				{
+					const BlockDefinition& d = Definitions[i];
+					if ((d.isOpaque || d.isCollidable) && !d.isSolid)
+						return false;
+				}
+				return true;
+			}(), "不透明・衝突するブロックは、形を持つ (isSolid) 必要がある");
+	};
+}
\ No newline at end of file
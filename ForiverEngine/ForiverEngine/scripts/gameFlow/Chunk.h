@@ -3,17 +3,32 @@
 #include <scripts/common/Include.h>
 #include <scripts/helper/Include.h>
 #include <scripts/component/Include.h>
+#include "./Block.h"
 
 namespace ForiverEngine
 {
-	enum Block : std::uint32_t
+	// チャンク内のブロック配列のメモリレイアウト
+	enum class ChunkBlockLayout : std::uint8_t
 	{
-		Air = 0,
-		Invalid = 1,
-		Grass = 2,
-		Stone = 3,
-		Dirt = 4,
-		Sand = 5,
+		ColumnMajor, // [x][z][y] の順 (1列(縦)が連続する. 列単位の走査・上下の隣接参照に強い)
+		YMajor,      // [y][x][z] の順 (1層(横)が連続する)
+		Morton,      // xyz をビットインターリーブする (全方向の隣接参照に強い)
+	};
+
+	// チャンクのメッシュの作り方
+	enum class ChunkMeshingMode : std::uint8_t
+	{
+		PerFace, // 見えている面ごとに、四角形を1枚ずつ作る
+		Greedy,  // 同じ平面上で同じテクスチャの面を、なるべく大きな長方形にまとめる (頂点数が大きく減る)
+	};
+
+	// 占有ビットマスクの種類 (ブロックの性質ごとに持つ. BlockProperties を参照)
+	enum class OccupancyKind : std::uint8_t
+	{
+		Solid,      // 形を持つブロック
+		Opaque,     // 不透明なブロック
+		Collidable, // 衝突するブロック
+		Count,
 	};
 
 	/// <summary>
@@ -26,34 +41,145 @@ namespace ForiverEngine
 		static constexpr int Size = 16;    // 1辺のサイズ (ブロック数)
 		static constexpr int Height = 256; // 高さ (ブロック数)
 		static constexpr int Count = 1024; // ワールド全体のチャンク数 (Count x Count 個)
+		static constexpr int RegionSize = 32; // チャンク単位のデータを確保する単位 (RegionSize x RegionSize 個)
 		static constexpr int DrawDistance = 8; // カメラからの描画チャンク数 (矩形)
 		static constexpr int DrawCountMax = DrawDistance * 2 + 1; // 描画するチャンク数の最大値 (カメラ中心に、最大 DrawCountMax x DrawCountMax 個)
+		static constexpr int Volume = Size * Height * Size; // 1チャンクのブロック数
+		static constexpr int SectionHeight = 16; // 1セクション (縦に分割したブロック群) の高さ (ブロック数)
+		static constexpr int SectionCount = Height / SectionHeight; // 1チャンクのセクション数
+		static constexpr int SectionVolume = Size * SectionHeight * Size; // 1セクションのブロック数
+		static constexpr ChunkBlockLayout BlockLayout = ChunkBlockLayout::ColumnMajor; // セクション内のブロック配列のメモリレイアウト
+		static constexpr int OccupancyWordsPerColumn = Height / 64; // 占有ビットマスクの、1列あたりのワード数 (1ワード = 縦64ブロック)
+		static constexpr int OccupancyWordCount = Size * Size * OccupancyWordsPerColumn; // 占有ビットマスクの、1チャンク・1種類あたりのワード数
+		// 1チャンクのメッシュの四角形の数の上限 (ブロックの面が来うる位置の数. 形を持つブロックは全て不透明なので、1つの位置に面は1枚まで)
+		// 全ての地形メッシュで共有するインデックスバッファは、この数だけ作る
+		static constexpr int MaxMeshQuadCount = (Size + 1) * Height * Size + Size * (Height + 1) * Size + Size * Height * (Size + 1);
+		static_assert([]()
+			{
+				for (int i = 0; i < BlockProperties::Count; ++i)
+					if (BlockProperties::IsSolid(static_cast<Block>(i)) && !BlockProperties::IsOpaque(static_cast<Block>(i)))
+						return false;
+				return true;
+			}(), "MaxMeshQuadCount は、形を持つブロックが全て不透明であることを前提にしている");
+		static_assert(Size == TerrainVertex::ChunkOffsetUnit, "頂点のチャンク数のずれは、チャンクの1辺のブロック数を単位にしている");
+		static_assert(RegionSize <= (1 << TerrainVertex::ChunkOffsetBits), "リージョン内のチャンク数のずれは、頂点のビット幅に収まる必要がある (MergeLodMeshes())");
 
-		Chunk() : data(nullptr) {}
-		Chunk(Chunk&& other) noexcept : data(std::move(other.data)) {}
+		Chunk() : sections(), occupancy(), heightMap(), minHeight(-1), maxHeight(-1)
+			, minHeightColumnCount(Size * Size), maxHeightColumnCount(Size * Size)
+		{
+			heightMap.fill(-1);
+			RefreshOccupancyView();
+		}
+		Chunk(Chunk&& other) noexcept
+			: sections(std::move(other.sections)), occupancy(std::exchange(other.occupancy, {}))
+			, heightMap(other.heightMap), minHeight(other.minHeight), maxHeight(other.maxHeight)
+			, minHeightColumnCount(other.minHeightColumnCount), maxHeightColumnCount(other.maxHeightColumnCount)
+		{
+			RefreshOccupancyView();
+			other.RefreshOccupancyView();
+		}
 
 		Chunk& operator=(Chunk&& other) noexcept
 		{
-			data = std::move(other.data);
-			other.data = nullptr;
+			sections = std::move(other.sections);
+			ReleaseOccupancy();
+			occupancy = std::exchange(other.occupancy, {});
+			heightMap = other.heightMap;
+			minHeight = other.minHeight;
+			maxHeight = other.maxHeight;
+			minHeightColumnCount = other.minHeightColumnCount;
+			maxHeightColumnCount = other.maxHeightColumnCount;
+			RefreshOccupancyView();
+			other.RefreshOccupancyView();
 			return *this;
 		}
 
+		~Chunk()
+		{
+			ReleaseOccupancy();
+		}
+
+		// 各面が見えているかの、64ブロック分のビットマスク
+		// 順番は Up, Down, Right, Left, Forward, Backward
+		using FaceMasks = std::array<std::uint64_t, 6>;
+
+		// 頂点の遮蔽を焼き込むための、チャンクとその周囲1列の各列の情報 (CalculateOcclusionGrid() で求める)
+		// opaque, tops のインデックスは (x + 1) * (Size + 2) + (z + 1)
+		struct OcclusionGrid
+		{
+			// 列の不透明ビットマスクの写し. 上下に 0 のワードを1つずつ足してあり、Y座標 y は [(y + 64) / 64] ワード目の (y % 64) ビット目
+			// (y = -1 や、ワードの境界をまたいで読んでも、分岐せずに済む)
+			std::array<std::array<std::uint64_t, OccupancyWordsPerColumn + 2>, (Size + 2) * (Size + 2)> opaque;
+			std::array<std::int16_t, (Size + 2) * (Size + 2)> tops;           // 列の最も高いブロックのY座標 (無いなら -1. これより上のマスは空が見える)
+			std::array<std::array<std::int16_t, 6>, Size * Size> occludableTops; // [列][面] 遮蔽がありうる面の、最も高いY座標 (これより上の面は遮蔽が無い)
+		};
+
+		// セクションごとのメッシュ (インデックスはセクションと同じ. 面の無いセクションは空)
+		using SectionMeshes = std::array<TerrainMesh, SectionCount>;
+
+		// セクションの集合 (ビット i がセクション i)
+		using SectionMask = std::uint16_t;
+		static_assert(SectionCount <= 16, "SectionMask のビット数が足りない");
+		static constexpr SectionMask AllSections = static_cast<SectionMask>((1u << SectionCount) - 1);
+
+		/// <summary>
+		/// sectionMask に含まれるセクションについて、インデックスの小さい順に func(セクションのインデックス) を呼ぶ
+		/// </summary>
+		template<typename TFunc>
+		static void ForEachSection(SectionMask sectionMask, const TFunc& func)
+		{
+			for (std::uint32_t bits = sectionMask; bits != 0; bits &= bits - 1)
+				func(std::countr_zero(bits));
+		}
+
+		// 各列の地表の高さ (インデックスは列. GetColumnIndex() と同じ並び)
+		// 地形の生成 (CreateFromHeights()) の入力
+		using ColumnHeights = std::array<std::int16_t, Size * Size>;
+
+		// 各列の、ブロックがあるマスのビットマスク (インデックスは列. 占有ビットマスクと同じく、Y座標 y は [y / 64] ワード目の (y % 64) ビット目)
+		// 3D の地形の生成 (CreateFromColumnMasks()) の入力
+		using ColumnMasks = std::array<std::array<std::uint64_t, OccupancyWordsPerColumn>, Size * Size>;
+
+		// 各列の地表 (インデックスは列. GetColumnIndex() と同じ並び)
+		// LOD のメッシュは、ブロック配列ではなくこれから作る
+		struct SurfaceMap
+		{
+			std::array<std::int16_t, Size * Size> heights; // 最も高い形を持つブロックのY座標 (無いなら -1)
+			std::array<Block, Size * Size> blocks;         // そのブロック (無いなら空気)
+		};
+
+		/// <summary>
+		/// <para>水平方向に隣接する4チャンクの、こちらに接する列と、斜めに隣接する4チャンクの、こちらの角に接する列の不透明ビットマスクの写し</para>
+		/// <para>メッシュ作成時に、チャンク境界の面が遮られているかの判定に使う</para>
+		/// <para>写しなので、隣接チャンクが後から書き換えられても影響を受けない (別スレッドに渡せる)</para>
+		/// </summary>
+		struct NeighborBorders
+		{
+			// 順番は Right(+x), Left(-x), Forward(+z), Backward(-z)
+			// 各辺 Size 列ぶん. Right/Left は z 順、Forward/Backward は x 順に、列ごとに OccupancyWordsPerColumn ワードずつ並ぶ
+			// 隣接チャンクが無いなら 0 (= 遮られていない扱い. 値初期化すること)
+			std::array<std::array<std::uint64_t, Size * OccupancyWordsPerColumn>, 4> opaque;
+			// 斜めの隣接チャンクの、角の1列ずつ. 順番は RightForward(+x, +z), RightBackward(+x, -z), LeftForward(-x, +z), LeftBackward(-x, -z)
+			// 頂点の遮蔽 (チャンクの角の面) にのみ使う
+			std::array<std::array<std::uint64_t, OccupancyWordsPerColumn>, 4> corners;
+		};
+
 		template<typename T>
-		using ChunksArray = HeapMultiDimAllocator::Array2D<T>;
+		using ChunksArray = PagedArray2D<T, RegionSize>;
 
 		template<typename T>
-		using DrawChunksArray = HeapMultiDimAllocator::Array2D<T>;
+		using DrawChunksArray = HeapMultiDimAllocator::ArrayND<T, 2>;
 
 		/// <summary>
 		/// <para>チャンク群の数だけ要素を持った、2次元配列を作成する</para>
 		/// <para>チャンクと1対1対応するデータを表現するのに使う</para>
+		/// <para>実際のメモリは、RegionSize x RegionSize 個のチャンク単位で、書き込み時に確保される (読み取りのみなら、デフォルト値が返る)</para>
 		/// <para>アクセスは [x][z] の順</para>
 		/// </summary>
 		template<typename T>
 		static ChunksArray<T> CreateChunksArray()
 		{
-			return HeapMultiDimAllocator::CreateArray2D<T>(Chunk::Count, Chunk::Count);
+			return ChunksArray<T>(Chunk::Count, Chunk::Count);
 		}
 
 		/// <summary>
@@ -65,7 +191,7 @@ namespace ForiverEngine
 		template<typename T>
 		static DrawChunksArray<T> CreateDrawChunksArray()
 		{
-			return HeapMultiDimAllocator::CreateArray2D<T>(DrawCountMax, DrawCountMax);
+			return HeapMultiDimAllocator::CreateArrayND<T>(DrawCountMax, DrawCountMax);
 		}
 
 		struct DrawChunksIndexRangeInfo
@@ -130,6 +256,15 @@ namespace ForiverEngine
 			);
 		}
 
+		/// <summary>
+		/// <para>チャンクの原点 (チャンク内のブロック (0, 0, 0) の中心) のワールド座標を取得</para>
+		/// <para>メッシュの頂点はチャンク内の座標なので、描画時にこれを足す</para>
+		/// </summary>
+		static Vector3 GetOriginWorldPosition(const Lattice2& chunkIndex) noexcept
+		{
+			return Vector3(static_cast<float>(chunkIndex.x * Size), 0.0f, static_cast<float>(chunkIndex.y * Size));
+		}
+
 		/// <summary>
 		/// チャンクインデックスが有効であるか = 上下限を超えた値でないか
 		/// </summary>
@@ -139,6 +274,51 @@ namespace ForiverEngine
 				&& MathUtils::IsInRange(chunkIndex.y, 0, Count);
 		}
 
+		/// <summary>
+		/// Y座標 (ブロック単位) が属するセクションのインデックスを取得
+		/// </summary>
+		static constexpr int GetSectionIndex(int y) noexcept
+		{
+			return y / SectionHeight;
+		}
+
+		/// <summary>
+		/// <para>チャンク内のローカルブロック座標を、そのブロックが属するセクションの、ブロック配列のインデックスに変換する</para>
+		/// <para>メモリレイアウトは BlockLayout に従う</para>
+		/// </summary>
+		static constexpr int GetBlockArrayIndex(const Lattice3& localBlockPosition) noexcept
+		{
+			static_assert(SectionHeight == 16, "セクション内の Y座標は、下位4bit で求めている");
+
+			const int x = localBlockPosition.x;
+			const int y = localBlockPosition.y & 0xf; // セクション内の Y座標
+			const int z = localBlockPosition.z;
+
+			if constexpr (BlockLayout == ChunkBlockLayout::ColumnMajor)
+			{
+				return (x * Size + z) * SectionHeight + y;
+			}
+			else if constexpr (BlockLayout == ChunkBlockLayout::YMajor)
+			{
+				return (y * Size + x) * Size + z;
+			}
+			else // BlockLayout == ChunkBlockLayout::Morton
+			{
+				// 4bit ずつを x,y,z の順にインターリーブする
+				static_assert(Size == 16, "Morton レイアウトは Size == 16 を前提にしている");
+				// 4bit の値を、3bit おきに散らしたテーブル
+				constexpr std::array<int, 16> Spread = []() constexpr
+					{
+						std::array<int, 16> table = {};
+						for (int v = 0; v < 16; ++v)
+							for (int bit = 0; bit < 4; ++bit)
+								table[v] |= ((v >> bit) & 1) << (bit * 3);
+						return table;
+					}();
+				return (Spread[y] << 2) | (Spread[z] << 1) | Spread[x];
+			}
+		}
+
 		/// <summary>
 		/// 何もない空気のみで作成する
 		/// </summary>
@@ -146,12 +326,15 @@ namespace ForiverEngine
 		{
 			Chunk chunk;
 
-			chunk.data = HeapMultiDimAllocator::CreateArray3D<Block>(Size, Height, Size);
-
-			for (int xi = 0; xi < Size; ++xi)
-				for (int yi = 0; yi < Height; ++yi)
-					for (int zi = 0; zi < Size; ++zi)
-						chunk.SetBlock({ xi, yi, zi }, Block::Air);
+			// 全セクションが一様 (空気のみ) なので、ブロック配列は確保されない
+			for (PaletteArray<Block>& section : chunk.sections)
+				section = PaletteArray<Block>(SectionVolume, Block::Air);
+			chunk.AllocateOccupancy();
+			chunk.heightMap.fill(-1);
+			chunk.minHeight = -1;
+			chunk.maxHeight = -1;
+			chunk.minHeightColumnCount = Size * Size;
+			chunk.maxHeightColumnCount = Size * Size;
 
 			return chunk;
 		}
@@ -169,275 +352,1585 @@ namespace ForiverEngine
 		/// <param name="seed">シード値</param>
 		static Chunk CreateFromNoise(const Lattice2& chunkIndex, const Vector2& noiseScale,
 			int heightBulk, int minDirtHeight, int minStoneHeight, std::uint32_t seed = DefaultCreationSeed)
+		{
+			return CreateFromHeights(CalculateNoiseHeights(chunkIndex, noiseScale, heightBulk, seed), minDirtHeight, minStoneHeight);
+		}
+
+		/// <summary>
+		/// <para>CreateFromNoise() で生成される地形の、地表のみを求める (ブロック配列は作らない)</para>
+		/// <para>引数は CreateFromNoise() と同じ. 同じ引数なら、生成したチャンクの CreateSurfaceMap() と一致する</para>
+		/// </summary>
+		static SurfaceMap CreateSurfaceMapFromNoise(const Lattice2& chunkIndex, const Vector2& noiseScale,
+			int heightBulk, int minDirtHeight, int minStoneHeight, std::uint32_t seed = DefaultCreationSeed)
+		{
+			return CreateSurfaceMapFromHeights(CalculateNoiseHeights(chunkIndex, noiseScale, heightBulk, seed), minDirtHeight, minStoneHeight);
+		}
+
+		/// <summary>
+		/// <para>各列の地表の高さから、チャンクを生成する</para>
+		/// <para>ブロックの種類は CreateFromNoise() と同じく、高度で決まる</para>
+		/// <para>各列の 砂, 土, 石 の範囲を求めて、FillColumn() で縦にまとめて埋める</para>
+		/// </summary>
+		/// <param name="heights">各列の地表の高さ [0, Height - 1]</param>
+		/// <param name="minDirtHeight">土が出てくる最低高度</param>
+		/// <param name="minStoneHeight">石が出てくる最低高度</param>
+		static Chunk CreateFromHeights(const ColumnHeights& heights, int minDirtHeight, int minStoneHeight)
 		{
 			Chunk chunk = CreateVoid();
 
-			const float seedX = static_cast<float>((seed & 0xFFFF0000) >> 16);
-			const float seedZ = static_cast<float>(seed & 0x0000FFFF);
+			for (int x = 0; x < Size; ++x)
+				for (int z = 0; z < Size; ++z)
+					chunk.FillTerrainRun({ x, z }, 0, heights[GetColumnIndex({ x, z })], minDirtHeight, minStoneHeight, true);
+
+			// 石だけで埋まったセクションなどを、一様に戻す
+			chunk.Compact();
+
+			return chunk;
+		}
+
+		/// <summary>
+		/// <para>各列のブロックがあるマスから、チャンクを生成する (洞窟・オーバーハングなど、列の途中に空気がある地形)</para>
+		/// <para>ブロックの種類は CreateFromHeights() と同じく高度で決まる. 草になるのは、列の最も高いブロックのみ (洞窟の床などは土のまま)</para>
+		/// </summary>
+		/// <param name="masks">各列の、ブロックがあるマスのビットマスク</param>
+		/// <param name="minDirtHeight">土が出てくる最低高度</param>
+		/// <param name="minStoneHeight">石が出てくる最低高度</param>
+		static Chunk CreateFromColumnMasks(const ColumnMasks& masks, int minDirtHeight, int minStoneHeight)
+		{
+			Chunk chunk = CreateVoid();
 
 			for (int x = 0; x < Size; ++x)
 				for (int z = 0; z < Size; ++z)
 				{
-					const float noise = Noise::Simplex2D(1.0f * (x + Size * chunkIndex.x + seedX) * noiseScale.x, 1.0f * (z + Size * chunkIndex.y + seedZ) * noiseScale.x);
-					const float heightNormed = (noise + 1.0f) * 0.5f; // [0, 1] に正規化
-					const int height = std::clamp(heightBulk + static_cast<int>(heightNormed * noiseScale.y), 0, Height - 1);
-
-					for (int y = 0; y <= height; ++y)
+					// 縦に連続したブロックごとに埋める
+					const std::array<std::uint64_t, OccupancyWordsPerColumn>& mask = masks[GetColumnIndex({ x, z })];
+					for (int runMinY = FindNextBit(mask, 0, true); runMinY < Height; )
 					{
-						if (y >= minStoneHeight)
-						{
-							chunk.SetBlock({ x, y, z }, Block::Stone);
-						}
-						else if (y >= minDirtHeight)
-						{
-							if (y == height)
-								chunk.SetBlock({ x, y, z }, Block::Grass); // 最上段は草
-							else
-								chunk.SetBlock({ x, y, z }, Block::Dirt);
-						}
-						else
-						{
-							chunk.SetBlock({ x, y, z }, Block::Sand);
-						}
+						const int runEndY = FindNextBit(mask, runMinY, false);
+						const int nextRunMinY = FindNextBit(mask, runEndY, true);
+						chunk.FillTerrainRun({ x, z }, runMinY, runEndY - 1, minDirtHeight, minStoneHeight, nextRunMinY >= Height);
+						runMinY = nextRunMinY;
 					}
 				}
 
+			chunk.Compact();
+
 			return chunk;
 		}
 
+		/// <summary>
+		/// <para>CreateFromHeights() で生成される地形の、地表のみを求める (ブロック配列は作らない)</para>
+		/// <para>同じ引数なら、生成したチャンクの CreateSurfaceMap() と一致する</para>
+		/// </summary>
+		static SurfaceMap CreateSurfaceMapFromHeights(const ColumnHeights& heights, int minDirtHeight, int minStoneHeight)
+		{
+			SurfaceMap surfaceMap = {};
+			surfaceMap.heights = heights;
+			for (int i = 0; i < Size * Size; ++i)
+				surfaceMap.blocks[i] = GetNoiseTerrainBlock(heights[i], heights[i], minDirtHeight, minStoneHeight);
+			return surfaceMap;
+		}
+
 		Block GetBlock(const Lattice3& position) const
 		{
-			return data[position.x][position.y][position.z];
+			return sections[GetSectionIndex(position.y)].Get(GetBlockArrayIndex(position));
 		}
 
 		void SetBlock(const Lattice3& position, Block block)
 		{
-			data[position.x][position.y][position.z] = block;
+			sections[GetSectionIndex(position.y)].Set(GetBlockArrayIndex(position), block);
+			UpdateOccupancy(position, block);
+			UpdateHeightMap(position, block);
 		}
 
 		/// <summary>
-		/// <para>地表ブロックのY座標を取得する (降順にY座標を見る. 無いならチャンクの高さの最小値-1)</para>
-		/// <para>ただし、Y座標の探索については、maxY 以下しか地表候補としてみない (地中でも正しく判定するため)</para>
+		/// <para>列の [minY, maxY] の範囲を、同じブロックで埋める (範囲外は切り詰める. 空なら何もしない)</para>
+		/// <para>SetBlock() を繰り返すのと同じ結果になるが、ブロック配列・占有ビットマスクはワード単位で、ハイトマップは1回だけ書き換える</para>
 		/// </summary>
-		int GetFloorHeight(const Lattice2& positionXZ, int maxY = Height - 1) const
+		void FillColumn(const Lattice2& positionXZ, int minY, int maxY, Block block)
 		{
-			for (int y = maxY; y >= 0; --y)
+			minY = std::max(minY, 0);
+			maxY = std::min(maxY, Height - 1);
+			if (minY > maxY)
+				return;
+
+			for (int sectionIndex = GetSectionIndex(minY); sectionIndex <= GetSectionIndex(maxY); ++sectionIndex)
 			{
-				if (GetBlock({ positionXZ.x, y, positionXZ.y }) != Block::Air)
-					return y;
+				const int sectionMinY = std::max(minY, sectionIndex * SectionHeight);
+				const int sectionMaxY = std::min(maxY, sectionIndex * SectionHeight + SectionHeight - 1);
+				if constexpr (BlockLayout == ChunkBlockLayout::ColumnMajor)
+				{
+					// 列のブロックは、セクション内で連続している
+					sections[sectionIndex].Fill(
+						GetBlockArrayIndex({ positionXZ.x, sectionMinY, positionXZ.y }), sectionMaxY - sectionMinY + 1, block);
+				}
+				else
+				{
+					for (int y = sectionMinY; y <= sectionMaxY; ++y)
+						sections[sectionIndex].Set(GetBlockArrayIndex({ positionXZ.x, y, positionXZ.y }), block);
+				}
 			}
+			FillOccupancy(positionXZ, minY, maxY, block);
 
-			return -1; // 地面が無い
+			const int oldHeight = heightMap[GetColumnIndex(positionXZ)];
+			if (BlockProperties::IsSolid(block))
+				SetColumnHeight(positionXZ, std::max(oldHeight, maxY));
+			else if (oldHeight >= minY && oldHeight <= maxY)
+				SetColumnHeight(positionXZ, ScanFloorHeight(positionXZ, minY - 1, OccupancyKind::Solid)); // 最上段が消えたので、その下を探す
 		}
 
 		/// <summary>
-		/// <para>天井ブロックのY座標を取得する (昇順にY座標を見る. 無いならチャンクの高さの最大値+1)</para>
-		/// <para>ただし、Y座標の探索については、minY 以上しか天井候補としてみない (地中でも正しく判定するため)</para>
+		/// <para>列の占有ビットマスクを取得する (OccupancyWordsPerColumn ワード)</para>
+		/// <para>Y座標 y のブロックが kind の性質を持つなら、[y / 64] ワード目の (y % 64) ビット目が立つ</para>
 		/// </summary>
-		int GetCeilHeight(const Lattice2& positionXZ, int minY = 0) const
+		const std::uint64_t* GetOccupancyColumn(const Lattice2& positionXZ, OccupancyKind kind = OccupancyKind::Solid) const noexcept
+		{
+			return occupancyView + static_cast<int>(kind) * OccupancyWordCount + GetColumnIndex(positionXZ) * OccupancyWordsPerColumn;
+		}
+
+		/// <summary>
+		/// 列の [minY, maxY] の範囲に、kind の性質を持つブロックがあるか
+		/// </summary>
+		bool IsAnyInColumn(const Lattice2& positionXZ, int minY, int maxY, OccupancyKind kind) const noexcept
 		{
-			for (int y = minY; y <= Height - 1; ++y)
+			minY = std::max(minY, 0);
+			maxY = std::min(maxY, Height - 1);
+			if (minY > maxY)
+				return false;
+
+			const std::uint64_t* column = GetOccupancyColumn(positionXZ, kind);
+			for (int wordIndex = minY >> 6; wordIndex <= (maxY >> 6); ++wordIndex)
 			{
-				if (GetBlock({ positionXZ.x, y, positionXZ.y }) != Block::Air)
-					return y;
+				const int lowBit = (wordIndex == (minY >> 6)) ? (minY & 63) : 0;
+				const int highBit = (wordIndex == (maxY >> 6)) ? (maxY & 63) : 63;
+				if ((column[wordIndex] & GetBitRangeMask(lowBit, highBit)) != 0)
+					return true;
 			}
-			return Height; // 天井が無い
+			return false;
 		}
 
-		Mesh CreateMesh(const Lattice2& chunkIndex) const
+		/// <summary>
+		/// <para>列の wordIndex ワード目 (縦64ブロック分) について、各面が見えているかをビット演算でまとめて求める</para>
+		/// <para>形を持つブロックの面は、隣接ブロックが不透明でなければ見えている</para>
+		/// <para>他チャンクに隣接する面は、neighbors の不透明ビットマスクで判定する</para>
+		/// </summary>
+		FaceMasks CalculateExposedFaceMasks(const Lattice2& positionXZ, int wordIndex, const NeighborBorders& neighbors = NoNeighbors) const noexcept
 		{
-			Mesh mesh = {};
-			// ある程度 reserve しておく
-			mesh.vertices.reserve(4096);
-			mesh.indices.reserve(1024);
+			const std::uint64_t solid = GetOccupancyColumn(positionXZ, OccupancyKind::Solid)[wordIndex];
+			const std::uint64_t* opaqueColumn = GetOccupancyColumn(positionXZ, OccupancyKind::Opaque);
+			const std::uint64_t opaque = opaqueColumn[wordIndex];
 
-			for (int xi = 0; xi < Chunk::Size; ++xi)
-				for (int yi = 0; yi < Chunk::Height; ++yi)
-					for (int zi = 0; zi < Chunk::Size; ++zi)
+			// 上下は、隣のワードとの境界のビットを繋ぐ
+			const std::uint64_t up = (opaque >> 1)
+				| ((wordIndex + 1 < OccupancyWordsPerColumn) ? (opaqueColumn[wordIndex + 1] << 63) : 0);
+			const std::uint64_t down = (opaque << 1)
+				| ((wordIndex - 1 >= 0) ? (opaqueColumn[wordIndex - 1] >> 63) : 0);
+
+			const int x = positionXZ.x;
+			const int z = positionXZ.y;
+			const std::uint64_t right = (x + 1 < Size)
+				? GetOccupancyColumn({ x + 1, z }, OccupancyKind::Opaque)[wordIndex] : neighbors.opaque[0][z * OccupancyWordsPerColumn + wordIndex];
+			const std::uint64_t left = (x - 1 >= 0)
+				? GetOccupancyColumn({ x - 1, z }, OccupancyKind::Opaque)[wordIndex] : neighbors.opaque[1][z * OccupancyWordsPerColumn + wordIndex];
+			const std::uint64_t forward = (z + 1 < Size)
+				? GetOccupancyColumn({ x, z + 1 }, OccupancyKind::Opaque)[wordIndex] : neighbors.opaque[2][x * OccupancyWordsPerColumn + wordIndex];
+			const std::uint64_t backward = (z - 1 >= 0)
+				? GetOccupancyColumn({ x, z - 1 }, OccupancyKind::Opaque)[wordIndex] : neighbors.opaque[3][x * OccupancyWordsPerColumn + wordIndex];
+
+			return FaceMasks
+			{
+				solid & ~up,
+				solid & ~down,
+				solid & ~right,
+				solid & ~left,
+				solid & ~forward,
+				solid & ~backward,
+			};
+		}
+
+		/// <summary>
+		/// <para>チャンクの周囲1列を含めた各列の、不透明ビットマスク・最も高いブロックを集める (メッシュ1つにつき1度だけ求める)</para>
+		/// <para>チャンク内はハイトマップ、隣接チャンク (斜めの角の列を含む) の列は neighbors の不透明ビットマスクから求める</para>
+		/// </summary>
+		OcclusionGrid CalculateOcclusionGrid(const NeighborBorders& neighbors = NoNeighbors) const noexcept
+		{
+			constexpr int PaddedSize = Size + 2;
+			OcclusionGrid grid;
+			const auto setColumn = [&](int x, int z, const std::uint64_t* column, int top)
+				{
+					std::array<std::uint64_t, OccupancyWordsPerColumn + 2>& paddedColumn = grid.opaque[GetPaddedColumnIndex(x, z)];
+					paddedColumn.front() = 0;
+					std::copy_n(column, OccupancyWordsPerColumn, &paddedColumn[1]);
+					paddedColumn.back() = 0;
+					grid.tops[GetPaddedColumnIndex(x, z)] = static_cast<std::int16_t>(top);
+				};
+			const auto findTop = [](const std::uint64_t* column)
+				{
+					for (int wordIndex = OccupancyWordsPerColumn - 1; wordIndex >= 0; --wordIndex)
 					{
-						const Block block = data[xi][yi][zi];
-						if (block == Block::Air) continue; // ブロックが無いならスキップ
+						if (column[wordIndex] != 0)
+							return (wordIndex << 6) + 63 - std::countl_zero(column[wordIndex]);
+					}
+					return -1;
+				};
 
-						// ブロックの座標 (格子点なので、配列のインデックスと同義)
-						const Lattice3 localBlockPosition = Lattice3(xi, yi, zi);
-						const Lattice3 worldBlockPosition = localBlockPosition + Lattice3(chunkIndex.x * Chunk::Size, 0, chunkIndex.y * Chunk::Size);
+			for (int x = 0; x < Size; ++x)
+				for (int z = 0; z < Size; ++z)
+					setColumn(x, z, GetOccupancyColumn({ x, z }, OccupancyKind::Opaque), heightMap[GetColumnIndex({ x, z })]);
+			for (int i = 0; i < Size; ++i)
+			{
+				const auto setNeighborColumn = [&](int x, int z, int side)
+					{
+						const std::uint64_t* column = &neighbors.opaque[side][i * OccupancyWordsPerColumn];
+						setColumn(x, z, column, findTop(column));
+					};
+				setNeighborColumn(Size, i, 0);
+				setNeighborColumn(-1, i, 1);
+				setNeighborColumn(i, Size, 2);
+				setNeighborColumn(i, -1, 3);
+			}
+			const auto setCornerColumn = [&](int x, int z, int corner)
+				{
+					const std::uint64_t* column = neighbors.corners[corner].data();
+					setColumn(x, z, column, findTop(column));
+				};
+			setCornerColumn(Size, Size, 0);
+			setCornerColumn(Size, -1, 1);
+			setCornerColumn(-1, Size, 2);
+			setCornerColumn(-1, -1, 3);
 
-						// 面一覧 (具体的には、面の法線ベクトル)
-						constexpr Lattice3 FaceNormals[] =
-						{
-							Lattice3::Up(),
-							Lattice3::Down(),
-							Lattice3::Right(),
-							Lattice3::Left(),
-							Lattice3::Forward(),
-							Lattice3::Backward(),
-						};
+			// 面の手前の層の列のうち、最も高いブロックから、遮蔽がありうる高さを求める
+			// 側面の層は3列 (高さは y - 1 から y + 1), 上下の面の層は 3x3 列 (高さは y + 法線の y)
+			// 3列の最大は、x 方向・z 方向に分けて求めておく
+			std::array<std::int16_t, PaddedSize * PaddedSize> maxTopsX;
+			std::array<std::int16_t, PaddedSize * PaddedSize> maxTopsZ;
+			for (int i = PaddedSize; i < PaddedSize * (PaddedSize - 1); ++i)
+				maxTopsX[i] = std::max(grid.tops[i - PaddedSize], std::max(grid.tops[i], grid.tops[i + PaddedSize]));
+			for (int i = 1; i < PaddedSize * PaddedSize - 1; ++i)
+				maxTopsZ[i] = std::max(grid.tops[i - 1], std::max(grid.tops[i], grid.tops[i + 1]));
+			for (int x = 0; x < Size; ++x)
+				for (int z = 0; z < Size; ++z)
+				{
+					const int i = GetPaddedColumnIndex(x, z);
+					const int maxTop = std::max(maxTopsZ[i - PaddedSize], std::max(maxTopsZ[i], maxTopsZ[i + PaddedSize]));
+					// 順番は Up, Down, Right, Left, Forward, Backward
+					grid.occludableTops[GetColumnIndex({ x, z })] =
+					{
+						static_cast<std::int16_t>(maxTop - 1),
+						static_cast<std::int16_t>(maxTop + 1),
+						static_cast<std::int16_t>(maxTopsZ[i + PaddedSize] + 1),
+						static_cast<std::int16_t>(maxTopsZ[i - PaddedSize] + 1),
+						static_cast<std::int16_t>(maxTopsX[i + 1] + 1),
+						static_cast<std::int16_t>(maxTopsX[i - 1] + 1),
+					};
+				}
+			return grid;
+		}
+
+		/// <summary>
+		/// <para>ブロックの faceIndex の向きの面の、4頂点の遮蔽を、1つの値に詰めて (PackOcclusionKey() の形で) 求める</para>
+		/// <para>環境遮蔽 : 頂点に接する、面の手前の層の3ブロック (側面2つ + 角) のうち、不透明なものの数 (側面が2つとも不透明なら最大)</para>
+		/// <para>空の遮蔽 : 面の手前のマスと、↑の3マスのうち、空が見えないものの数</para>
+		/// <para>空が見えないマスは、列の最も高いブロック以下のマス. ワールドの下 (y < 0) は、不透明ではないが空は見えないとする</para>
+		/// <para>4頂点の遮蔽は、9マスのビットから表を1度引くだけで求まる (頂点ごとに3マスを調べ直さない)</para>
+		/// <para>4頂点の値の配列ではなく1つの値で返すのは、配列を返すと、呼び出し側が値を読み出すのが遅くなるため</para>
+		/// </summary>
+		static std::uint32_t CalculateFaceOcclusionKey(const OcclusionGrid& grid, const Lattice3& position, int faceIndex) noexcept
+		{
+			// 手前の層の9マスが全て空の見えるマスなら、不透明なマスも無いので、遮蔽は無い (開けた地表の大半はこれ)
+			if (position.y > grid.occludableTops[GetColumnIndex({ position.x, position.z })][faceIndex])
+				return 0;
+			// ワールドの底の下向きの面は、手前の層が全てワールドの下 (不透明ではなく、空は見えない) なので、遮蔽は決まっている
+			if (position.y == 0 && faceIndex == BelowWorldFaceIndex)
+				return BelowWorldOcclusionKey;
+
+			return CalculateOccludableFaceOcclusionKey(grid, position, faceIndex);
+		}
+
+		/// <summary>
+		/// ブロックの faceIndex の向きの面の、4頂点の遮蔽 (頂点番号順. TerrainVertex::EncodeOcclusion() の値) を求める (CalculateFaceOcclusionKey() を頂点ごとに分けたもの)
+		/// </summary>
+		static std::array<std::uint32_t, 4> CalculateFaceCornerOcclusions(const OcclusionGrid& grid, const Lattice3& position, int faceIndex) noexcept
+		{
+			return UnpackOcclusionKey(CalculateFaceOcclusionKey(grid, position, faceIndex));
+		}
+
+		/// <summary>
+		/// <para>隣接する4チャンクから、こちらに接する列の不透明ビットマスクを写し取る</para>
+		/// <para>斜めに隣接する4チャンクからは、こちらの角に接する1列ずつを写し取る</para>
+		/// <para>隣接チャンクが無い (ワールドの端・未生成) なら nullptr を渡す</para>
+		/// </summary>
+		static NeighborBorders CaptureNeighborBorders(
+			const Chunk* right, const Chunk* left, const Chunk* forward, const Chunk* backward,
+			const Chunk* rightForward = nullptr, const Chunk* rightBackward = nullptr, const Chunk* leftForward = nullptr, const Chunk* leftBackward = nullptr)
+		{
+			NeighborBorders borders = {};
+			for (int i = 0; i < Size; ++i)
+			{
+				const auto copyColumn = [&](int side, const Chunk* neighbor, const Lattice2& positionXZ)
+					{
+						if (neighbor == nullptr)
+							return;
+						const std::uint64_t* column = neighbor->GetOccupancyColumn(positionXZ, OccupancyKind::Opaque);
+						std::copy_n(column, OccupancyWordsPerColumn, &borders.opaque[side][i * OccupancyWordsPerColumn]);
+					};
+				copyColumn(0, right, { 0, i });
+				copyColumn(1, left, { Size - 1, i });
+				copyColumn(2, forward, { i, 0 });
+				copyColumn(3, backward, { i, Size - 1 });
+			}
+
+			const auto copyCornerColumn = [&](int corner, const Chunk* neighbor, const Lattice2& positionXZ)
+				{
+					if (neighbor == nullptr)
+						return;
+					const std::uint64_t* column = neighbor->GetOccupancyColumn(positionXZ, OccupancyKind::Opaque);
+					std::copy_n(column, OccupancyWordsPerColumn, borders.corners[corner].data());
+				};
+			copyCornerColumn(0, rightForward, { 0, 0 });
+			copyCornerColumn(1, rightBackward, { 0, Size - 1 });
+			copyCornerColumn(2, leftForward, { Size - 1, 0 });
+			copyCornerColumn(3, leftBackward, { Size - 1, Size - 1 });
+			return borders;
+		}
+
+		/// <summary>
+		/// 各列の地表 (最も高い形を持つブロック) を写し取る
+		/// </summary>
+		SurfaceMap CreateSurfaceMap() const
+		{
+			SurfaceMap surfaceMap = {};
+			for (int x = 0; x < Size; ++x)
+				for (int z = 0; z < Size; ++z)
+				{
+					const int height = GetColumnHeight({ x, z });
+					surfaceMap.heights[GetColumnIndex({ x, z })] = static_cast<std::int16_t>(height);
+					surfaceMap.blocks[GetColumnIndex({ x, z })] = (height >= 0) ? GetBlock({ x, height, z }) : Block::Air;
+				}
+			return surfaceMap;
+		}
+
+		/// <summary>
+		/// <para>地表から、LOD (遠くのチャンク用の簡略化した) メッシュを作成する</para>
+		/// <para>1セル = 2^lodLevel ブロック四方の柱として、セルの高さは列の高さの最大値 (実際の地表より下にはならない) にする</para>
+		/// <para>セル間の段差は側面で塞ぎ、チャンクの境界の側面は Y=0 まで伸ばす (隣接チャンクの LOD レベルが違っても、隙間が出来ない)</para>
+		/// <para>同じ高さ・ブロックの上面は長方形に、同じ段差の側面は1列にまとめる</para>
+		/// <para>地表が無ければ、空のメッシュを返す</para>
+		/// </summary>
+		static TerrainMesh CreateLodMesh(const SurfaceMap& surfaceMap, int lodLevel)
+		{
+			assert(0 <= lodLevel && (1 << lodLevel) <= Size);
 
-						for (const Lattice3& faceNormal : FaceNormals)
+			const int cellSize = 1 << lodLevel;
+			const int cellCount = Size / cellSize;
+
+			// セルごとの高さと、表示するブロック (最も高い列のもの)
+			std::array<int, Size * Size> cellHeights;
+			std::array<Block, Size * Size> cellBlocks;
+			for (int cx = 0; cx < cellCount; ++cx)
+				for (int cz = 0; cz < cellCount; ++cz)
+				{
+					int height = -1;
+					Block block = Block::Air;
+					for (int x = cx * cellSize; x < (cx + 1) * cellSize; ++x)
+						for (int z = cz * cellSize; z < (cz + 1) * cellSize; ++z)
 						{
-							// ブロックのフェースが遮られているかチェックする
+							const int columnHeight = surfaceMap.heights[GetColumnIndex({ x, z })];
+							if (columnHeight > height)
 							{
-								// フェースに隣接するブロック
-								// ここにブロックがあるかないかで、面が遮られているか判定する
-								const Lattice3 checkPosition = localBlockPosition + faceNormal;
-
-								// 他チャンクに隣接するので、遮られていない扱いにする
-								if (!MathUtils::IsInRange(checkPosition.x, 0, Size));
-								else if (!MathUtils::IsInRange(checkPosition.y, 0, Height));
-								else if (!MathUtils::IsInRange(checkPosition.z, 0, Size));
-								// ブロックがある = 遮られている
-								else if (data[checkPosition.x][checkPosition.y][checkPosition.z] != Block::Air)
-									continue;
+								height = columnHeight;
+								block = surfaceMap.blocks[GetColumnIndex({ x, z })];
 							}
+						}
+					cellHeights[cx * cellCount + cz] = height;
+					cellBlocks[cx * cellCount + cz] = block;
+				}
+			const auto isSameCell = [&](int a, int b)
+				{
+					return cellHeights[a] == cellHeights[b] && cellBlocks[a] == cellBlocks[b];
+				};
 
-							// 指定されたフェースをメッシュに追加する
-							// ワールドから見た向きで、テクスチャの配置は固定する
-							// ワールド座標
-							{
-								// Indices
-								// [indexBegin, indexBegin+3] が今回追加した分のインデックス
-								const std::uint16_t indexBegin = static_cast<std::uint16_t>(mesh.vertices.size());
-								mesh.indices.push_back(indexBegin + 0);
-								mesh.indices.push_back(indexBegin + 1);
-								mesh.indices.push_back(indexBegin + 2);
-								mesh.indices.push_back(indexBegin + 2);
-								mesh.indices.push_back(indexBegin + 1);
-								mesh.indices.push_back(indexBegin + 3);
-
-								// Vertices
-								const Vector3 worldPosition = Vector3(worldBlockPosition);
-								const Vector3 faceNormalAsVector = Vector3(faceNormal);
-								const std::uint32_t textureIndex = static_cast<std::uint32_t>(block);
-								if (faceNormal == Lattice3::Up())
-								{
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, +0.5f, -0.5f)), Vector2(0.00f, 0.50f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, +0.5f, +0.5f)), Vector2(0.00f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, +0.5f, -0.5f)), Vector2(0.25f, 0.50f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, +0.5f, +0.5f)), Vector2(0.25f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-								}
-								else if (faceNormal == Lattice3::Down())
-								{
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, -0.5f, +0.5f)), Vector2(0.25f, 0.50f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, -0.5f, -0.5f)), Vector2(0.25f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, -0.5f, +0.5f)), Vector2(0.50f, 0.50f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, -0.5f, -0.5f)), Vector2(0.50f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-								}
-								else if (faceNormal == Lattice3::Right())
-								{
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, -0.5f, -0.5f)), Vector2(0.25f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, +0.5f, -0.5f)), Vector2(0.25f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, -0.5f, +0.5f)), Vector2(0.50f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, +0.5f, +0.5f)), Vector2(0.50f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-								}
-								else if (faceNormal == Lattice3::Left())
-								{
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, -0.5f, +0.5f)), Vector2(0.00f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, +0.5f, +0.5f)), Vector2(0.00f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, -0.5f, -0.5f)), Vector2(0.25f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, +0.5f, -0.5f)), Vector2(0.25f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-								}
-								else if (faceNormal == Lattice3::Forward())
-								{
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, -0.5f, +0.5f)), Vector2(0.75f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, +0.5f, +0.5f)), Vector2(0.75f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, -0.5f, +0.5f)), Vector2(1.00f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, +0.5f, +0.5f)), Vector2(1.00f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-								}
-								else // faceNormal == Lattice3::Backward()
-								{
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, -0.5f, -0.5f)), Vector2(0.50f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(-0.5f, +0.5f, -0.5f)), Vector2(0.50f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, -0.5f, -0.5f)), Vector2(0.75f, 0.25f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-									mesh.vertices.emplace_back(
-										Vector4(worldPosition + Vector3(+0.5f, +0.5f, -0.5f)), Vector2(0.75f, 0.00f),
-										faceNormalAsVector, worldPosition, textureIndex
-									);
-								}
-							}
+			// 四角形を先に全て求めて、数をちょうどに確保してから書き込む
+			// (1セルにつき、上面1枚 + 側面4枚まで)
+			struct LodQuad
+			{
+				int faceIndex;
+				int blockMin[3];
+				int size[3];
+				std::uint32_t textureIndex;
+			};
+			std::array<LodQuad, Size * Size * 5> quads;
+			int quadCount = 0;
+
+			// 上面 : 同じ高さ・ブロックのセルを、z方向 -> x方向 の順に伸ばして長方形にまとめる
+			std::array<bool, Size * Size> isMerged = {};
+			for (int cx = 0; cx < cellCount; ++cx)
+				for (int cz = 0; cz < cellCount; ++cz)
+				{
+					const int cell = cx * cellCount + cz;
+					if (cellHeights[cell] < 0 || isMerged[cell])
+						continue;
+
+					int depth = 1;
+					while (cz + depth < cellCount && !isMerged[cell + depth] && isSameCell(cell, cell + depth))
+						++depth;
+					int width = 1;
+					while (cx + width < cellCount)
+					{
+						const int rowBegin = (cx + width) * cellCount + cz;
+						bool isSameRow = true;
+						for (int i = 0; i < depth && isSameRow; ++i)
+							isSameRow = !isMerged[rowBegin + i] && isSameCell(cell, rowBegin + i);
+						if (!isSameRow)
+							break;
+						++width;
+					}
+					for (int dx = 0; dx < width; ++dx)
+						std::fill_n(&isMerged[(cx + dx) * cellCount + cz], depth, true);
+
+					quads[quadCount++] = LodQuad
+					{
+						.faceIndex = 0,
+						.blockMin = { cx * cellSize, cellHeights[cell], cz * cellSize },
+						.size = { width * cellSize, 1, depth * cellSize },
+						.textureIndex = BlockProperties::GetTextureIndex(cellBlocks[cell], 0),
+					};
+				}
+
+			// 側面 : 隣のセルより高い分を塞ぐ (チャンクの境界は Y=0 まで). 面に沿って、同じ段差のセルを1列にまとめる
+			// 順番は Right, Left, Forward, Backward (面のインデックスは 2..5)
+			constexpr Lattice2 SideOffsets[4] = { Lattice2(1, 0), Lattice2(-1, 0), Lattice2(0, 1), Lattice2(0, -1) };
+			for (int side = 0; side < 4; ++side)
+			{
+				const int faceIndex = 2 + side;
+				const bool isAlongZ = (side <= 1); // 面に沿う軸 (Right/Left は z, Forward/Backward は x)
+				for (int line = 0; line < cellCount; ++line)
+				{
+					// この列の i 番目のセルの、側面の下端の1つ下 (隣のセルの高さ) と、セルのインデックス
+					const auto getCell = [&](int i) { return isAlongZ ? line * cellCount + i : i * cellCount + line; };
+					const auto getFloorHeight = [&](int i)
+						{
+							const int nx = (isAlongZ ? line : i) + SideOffsets[side].x;
+							const int nz = (isAlongZ ? i : line) + SideOffsets[side].y;
+							if (nx < 0 || nx >= cellCount || nz < 0 || nz >= cellCount)
+								return -1;
+							return cellHeights[nx * cellCount + nz];
+						};
+
+					for (int i = 0; i < cellCount;)
+					{
+						const int cell = getCell(i);
+						const int floorHeight = getFloorHeight(i);
+						if (cellHeights[cell] < 0 || floorHeight >= cellHeights[cell])
+						{
+							++i;
+							continue;
 						}
+
+						int length = 1;
+						while (i + length < cellCount && isSameCell(cell, getCell(i + length)) && getFloorHeight(i + length) == floorHeight)
+							++length;
+
+						// 面に垂直な軸は、面の側の端のブロック1列
+						const int cx = isAlongZ ? line : i;
+						const int cz = isAlongZ ? i : line;
+						quads[quadCount++] = LodQuad
+						{
+							.faceIndex = faceIndex,
+							.blockMin =
+							{
+								(side == 0) ? (cx + 1) * cellSize - 1 : cx * cellSize,
+								floorHeight + 1,
+								(side == 2) ? (cz + 1) * cellSize - 1 : cz * cellSize,
+							},
+							.size =
+							{
+								isAlongZ ? 1 : length * cellSize,
+								cellHeights[cell] - floorHeight,
+								isAlongZ ? length * cellSize : 1,
+							},
+							.textureIndex = BlockProperties::GetTextureIndex(cellBlocks[cell], faceIndex),
+						};
+						i += length;
 					}
+				}
+			}
 
-			// 頂点が1つも無い場合、ダミーで何か入れておく
-			if (mesh.vertices.size() <= 0)
+			if (quadCount <= 0)
+				return TerrainMesh{};
+
+			std::array<int, TerrainVertex::FaceCount> faceQuadCounts = {};
+			for (int i = 0; i < quadCount; ++i)
+				++faceQuadCounts[quads[i].faceIndex];
+
+			TerrainMesh mesh = {};
+			mesh.vertices = VectorPool<VertexDataTerrain>::Acquire(static_cast<std::size_t>(quadCount) * TerrainMesh::VerticesPerQuad);
+			mesh.vertices.resize(static_cast<std::size_t>(quadCount) * TerrainMesh::VerticesPerQuad);
+			mesh.faceQuadOffsets = TerrainMesh::CalculateFaceQuadOffsets(faceQuadCounts);
+
+			// 面の向きごとの範囲に書き込む
+			const std::span<VertexDataTerrain> output = mesh.vertices;
+			std::array<int, TerrainVertex::FaceCount> writtenQuadCounts = {};
+			for (int i = 0; i < quadCount; ++i)
 			{
-				// 空気なので、表示はされない
-				mesh = Mesh::CreateCube(Vector3::Zero(), static_cast<std::uint32_t>(Block::Air));
+				const int quad = mesh.GetFaceQuadBegin(quads[i].faceIndex) + writtenQuadCounts[quads[i].faceIndex]++;
+				WriteGreedyQuad(output.subspan(static_cast<std::size_t>(quad) * TerrainMesh::VerticesPerQuad).first<4>(),
+					quads[i].faceIndex, quads[i].blockMin, quads[i].size, quads[i].textureIndex);
 			}
 
 			return mesh;
 		}
 
-	private:
-		// y, z, x の順番
-		HeapMultiDimAllocator::Array3D<Block> data;
+		/// <summary>
+		/// <para>複数チャンクの LOD のメッシュを、1回で描画できるように1つにまとめる (CreateLodMesh() の値を、リージョン単位でまとめる想定)</para>
+		/// <para>chunkOffsets[i] : meshes[i] のチャンクの、まとめたメッシュの原点からのチャンク数 (頂点の texIndex に詰める. [0, RegionSize) であること)</para>
+		/// <para>面の向きごとの範囲は保つ (向きごとに、各メッシュの範囲を順に並べる)</para>
+		/// </summary>
+		static TerrainMesh MergeLodMeshes(std::span<const TerrainMesh* const> meshes, std::span<const Lattice2> chunkOffsets)
+		{
+			assert(meshes.size() == chunkOffsets.size());
+
+			std::array<int, TerrainVertex::FaceCount> faceQuadCounts = {};
+			for (const TerrainMesh* const mesh : meshes)
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+					faceQuadCounts[faceIndex] += mesh->GetFaceQuadCount(faceIndex);
+
+			TerrainMesh merged = {};
+			merged.faceQuadOffsets = TerrainMesh::CalculateFaceQuadOffsets(faceQuadCounts);
+			const int quadCount = merged.faceQuadOffsets[TerrainVertex::FaceCount];
+			if (quadCount <= 0)
+				return merged;
+
+			const std::size_t vertexCount = static_cast<std::size_t>(quadCount) * TerrainMesh::VerticesPerQuad;
+			merged.vertices = VectorPool<VertexDataTerrain>::Acquire(vertexCount);
+			for (int slot = 0; slot < TerrainVertex::FaceCount; ++slot)
+			{
+				const int faceIndex = TerrainMesh::FaceLayoutOrder[slot];
+				for (std::size_t i = 0; i < meshes.size(); ++i)
+				{
+					const TerrainMesh& mesh = *meshes[i];
+					const std::size_t begin = static_cast<std::size_t>(mesh.GetFaceQuadBegin(faceIndex)) * TerrainMesh::VerticesPerQuad;
+					const std::size_t end = begin + static_cast<std::size_t>(mesh.GetFaceQuadCount(faceIndex)) * TerrainMesh::VerticesPerQuad;
+					for (std::size_t v = begin; v < end; ++v)
+						merged.vertices.push_back(TerrainVertex::AddChunkOffset(mesh.vertices[v], chunkOffsets[i]));
+				}
+			}
+
+			return merged;
+		}
+
+		/// <summary>
+		/// 列の、最も高いブロックのY座標を取得する (無いなら -1)
+		/// </summary>
+		int GetColumnHeight(const Lattice2& positionXZ) const noexcept
+		{
+			return heightMap[GetColumnIndex(positionXZ)];
+		}
+
+		/// <summary>
+		/// 全ての列のうち、最も高いブロックのY座標が最小のもの (ブロックが無い列があるなら -1)
+		/// </summary>
+		int GetMinHeight() const noexcept { return minHeight; }
+
+		/// <summary>
+		/// 全ての列のうち、最も高いブロックのY座標が最大のもの (ブロックが1つも無いなら -1)
+		/// </summary>
+		int GetMaxHeight() const noexcept { return maxHeight; }
+
+		/// <summary>
+		/// <para>各セクションのパレットを詰め直し、1種類のブロックのみになったセクションを一様 (ブロック配列なし) に戻す</para>
+		/// <para>まとめてブロックを書き換えた後に呼ぶ</para>
+		/// </summary>
+		void Compact()
+		{
+			for (PaletteArray<Block>& section : sections)
+				section.Compact();
+		}
+
+		/// <summary>
+		/// セクションが1種類のブロックのみで構成されているか
+		/// </summary>
+		bool IsSectionUniform(int sectionIndex) const noexcept
+		{
+			return sections[sectionIndex].IsUniform();
+		}
+
+		/// <summary>
+		/// セクションが空気のみで構成されているか
+		/// </summary>
+		bool IsSectionAir(int sectionIndex) const noexcept
+		{
+			const PaletteArray<Block>& section = sections[sectionIndex];
+			return section.IsUniform() && section.GetFirstPaletteValue() == Block::Air;
+		}
+
+		/// <summary>
+		/// セクションが空気以外の1種類のブロックのみで、隙間なく埋まっているか
+		/// </summary>
+		bool IsSectionSolid(int sectionIndex) const noexcept
+		{
+			const PaletteArray<Block>& section = sections[sectionIndex];
+			return section.IsUniform() && BlockProperties::IsSolid(section.GetFirstPaletteValue());
+		}
+
+		/// <summary>
+		/// ブロックデータが使用しているメモリ量 [byte] を返す
+		/// </summary>
+		std::size_t GetMemoryUsage() const noexcept
+		{
+			std::size_t usage = sizeof(Chunk) + occupancy.capacity() * sizeof(std::uint64_t);
+			for (const PaletteArray<Block>& section : sections)
+				usage += section.GetMemoryUsage();
+			return usage;
+		}
+
+		/// <summary>
+		/// ブロックデータの1ブロックあたりの平均 bit 数を返す (パレット圧縮後. 一様なセクションは 0 bit)
+		/// </summary>
+		float GetBitsPerBlock() const noexcept
+		{
+			int bitsSum = 0;
+			for (const PaletteArray<Block>& section : sections)
+				bitsSum += section.GetBitsPerEntry();
+			return static_cast<float>(bitsSum) / SectionCount;
+		}
+
+		/// <summary>
+		/// <para>地表ブロックのY座標を取得する (降順にY座標を見る. 無いならチャンクの高さの最小値-1)</para>
+		/// <para>ただし、Y座標の探索については、maxY 以下しか地表候補としてみない (地中でも正しく判定するため)</para>
+		/// <para>衝突するブロックのみを地表とみなす</para>
+		/// </summary>
+		int GetFloorHeight(const Lattice2& positionXZ, int maxY = Height - 1) const
+		{
+			// 衝突するブロックは形を持つので、ハイトマップの値より上には無い
+			return ScanFloorHeight(positionXZ, std::min(maxY, GetColumnHeight(positionXZ)), OccupancyKind::Collidable);
+		}
+
+		/// <summary>
+		/// <para>天井ブロックのY座標を取得する (昇順にY座標を見る. 無いならチャンクの高さの最大値+1)</para>
+		/// <para>ただし、Y座標の探索については、minY 以上しか天井候補としてみない (地中でも正しく判定するため)</para>
+		/// <para>衝突するブロックのみを天井とみなす</para>
+		/// </summary>
+		int GetCeilHeight(const Lattice2& positionXZ, int minY = 0) const
+		{
+			// 地表より上から探すなら、天井は無い
+			if (minY > GetColumnHeight(positionXZ))
+				return Height;
+
+			// 占有ビットマスクから、minY 以上で最も低いビットを探す
+			const std::uint64_t* column = GetOccupancyColumn(positionXZ, OccupancyKind::Collidable);
+			for (int wordIndex = std::max(minY, 0) >> 6; wordIndex < OccupancyWordsPerColumn; ++wordIndex)
+			{
+				const int lowBit = (wordIndex == (minY >> 6)) ? (minY & 63) : 0;
+				const std::uint64_t bits = column[wordIndex] & GetBitRangeMask(lowBit, 63);
+				if (bits != 0)
+					return (wordIndex << 6) + std::countr_zero(bits);
+			}
+			return Height; // 天井が無い
+		}
+
+		/// <summary>
+		/// <para>チャンクのメッシュを作成する (頂点はチャンク内の座標. ワールド座標は GetOriginWorldPosition() を足したもの)</para>
+		/// <para>mode によらず、見える面の範囲とテクスチャは同じになる</para>
+		/// <para>チャンク境界の面は、neighbors で隣接チャンクに遮られていれば作らない</para>
+		/// </summary>
+		TerrainMesh CreateMesh(ChunkMeshingMode mode = ChunkMeshingMode::PerFace, const NeighborBorders& neighbors = NoNeighbors) const
+		{
+			return FinalizeMesh(CreateMeshInRange(0, Height - 1, mode, neighbors, CalculateOcclusionGrid(neighbors)));
+		}
+
+		/// <summary>
+		/// <para>セクション1つ分 (sectionIndex のセクションのブロックの面のみ) のメッシュを作成する</para>
+		/// <para>全セクション分を合わせると、CreateMesh() と同じ面になる</para>
+		/// <para>面が無ければ、空のメッシュを返す (ダミーは入れない)</para>
+		/// </summary>
+		TerrainMesh CreateSectionMesh(int sectionIndex, ChunkMeshingMode mode = ChunkMeshingMode::PerFace, const NeighborBorders& neighbors = NoNeighbors) const
+		{
+			return CreateSectionMesh(sectionIndex, mode, neighbors, CalculateOcclusionGrid(neighbors));
+		}
+
+		/// <summary>
+		/// <para>全セクション分の CreateSectionMesh()</para>
+		/// <para>遮蔽のための周囲の列の情報 (CalculateOcclusionGrid()) は、1度だけ求めて全セクションで使い回す</para>
+		/// </summary>
+		SectionMeshes CreateSectionMeshes(ChunkMeshingMode mode = ChunkMeshingMode::PerFace, const NeighborBorders& neighbors = NoNeighbors) const
+		{
+			SectionMeshes meshes = {};
+			RecreateSectionMeshes(meshes, AllSections, mode, neighbors);
+			return meshes;
+		}
+
+		/// <summary>
+		/// <para>sectionMask のセクションのみ、meshes のメッシュを作り直す (古いメッシュはプールに返す)</para>
+		/// <para>遮蔽のための周囲の列の情報は、1度だけ求めて各セクションで使い回す</para>
+		/// </summary>
+		void RecreateSectionMeshes(SectionMeshes& meshes, SectionMask sectionMask, ChunkMeshingMode mode = ChunkMeshingMode::PerFace, const NeighborBorders& neighbors = NoNeighbors) const
+		{
+			if (sectionMask == 0)
+				return;
+
+			const OcclusionGrid occlusionGrid = CalculateOcclusionGrid(neighbors);
+			ForEachSection(sectionMask, [&](int sectionIndex)
+				{
+					ReleaseMesh(std::move(meshes[sectionIndex]));
+					meshes[sectionIndex] = CreateSectionMesh(sectionIndex, mode, neighbors, occlusionGrid);
+				});
+		}
+
+		/// <summary>
+		/// <para>localBlockPosition のブロックを書き換えた時に、メッシュが変わりうるセクションを求める</para>
+		/// <para>そのブロックのセクションと、上下の境界に接していれば上下のセクション (水平方向の隣接ブロックは、同じ高さなので同じセクション)</para>
+		/// <para>列の最も高いブロックが oldColumnHeight から newColumnHeight に変わったなら、その間の高さのセクションも加える</para>
+		/// <para>(空の遮蔽は列の最も高いブロックから求めるので、周囲の列の [min, max + 1] の高さのブロックの面が変わりうる)</para>
+		/// <para>チャンク境界の列なら、隣接チャンクの境界の列も、同じセクションが変わりうる</para>
+		/// </summary>
+		static constexpr SectionMask GetSectionsAffectedByBlock(const Lattice3& localBlockPosition, int oldColumnHeight = -1, int newColumnHeight = -1) noexcept
+		{
+			// 上下の境界に接するブロックは、y - 1 と y + 1 のセクションも含める (ワールドの上下の外は除く)
+			SectionMask sectionMask = GetSectionRangeMask(std::max(localBlockPosition.y - 1, 0), std::min(localBlockPosition.y + 1, Height - 1));
+
+			if (oldColumnHeight != newColumnHeight)
+			{
+				const int minY = std::max(std::min(oldColumnHeight, newColumnHeight), 0);
+				const int maxY = std::min(std::max(oldColumnHeight, newColumnHeight) + 1, Height - 1);
+				sectionMask |= GetSectionRangeMask(minY, maxY);
+			}
+			return sectionMask;
+		}
+
+		/// <summary>
+		/// Y座標 [minY, maxY] のブロックが属するセクションの集合
+		/// </summary>
+		static constexpr SectionMask GetSectionRangeMask(int minY, int maxY) noexcept
+		{
+			const std::uint32_t upTo = (2u << GetSectionIndex(maxY)) - 1;
+			const std::uint32_t below = (1u << GetSectionIndex(minY)) - 1;
+			return static_cast<SectionMask>(upTo & ~below);
+		}
+
+		/// <summary>
+		/// <para>見えている面の数を、占有ビットマスクの popcount で数える (PerFace のメッシュの四角形の数と同じ)</para>
+		/// <para>[minY, maxY] の範囲のブロックの面のみを数える</para>
+		/// </summary>
+		int CountExposedFaces(const NeighborBorders& neighbors = NoNeighbors, int minY = 0, int maxY = Height - 1) const noexcept
+		{
+			int count = 0;
+			for (const int faceCount : CountExposedFacesByDirection(neighbors, minY, maxY))
+				count += faceCount;
+			return count;
+		}
+		/// <summary>
+		/// CountExposedFaces() を、面の向きごとに数える
+		/// </summary>
+		std::array<int, TerrainVertex::FaceCount> CountExposedFacesByDirection(const NeighborBorders& neighbors = NoNeighbors, int minY = 0, int maxY = Height - 1) const noexcept
+		{
+			maxY = std::min(maxY, maxHeight);
+
+			std::array<int, TerrainVertex::FaceCount> counts = {};
+			for (int xi = 0; xi < Size; ++xi)
+				for (int zi = 0; zi < Size; ++zi)
+					for (int wordIndex = minY >> 6; wordIndex <= (maxY >> 6) && minY <= maxY; ++wordIndex)
+					{
+						const std::uint64_t rangeMask = GetWordRangeMask(wordIndex, minY, maxY);
+						const FaceMasks faceMasks = CalculateExposedFaceMasks({ xi, zi }, wordIndex, neighbors);
+						for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+							counts[faceIndex] += std::popcount(faceMasks[faceIndex] & rangeMask);
+					}
+
+			return counts;
+		}
+
+		/// <summary>
+		/// <para>CreateMesh() で作成したメッシュが不要になったら、これで配列をプールに返す</para>
+		/// <para>mesh は空になる</para>
+		/// </summary>
+		static void ReleaseMesh(TerrainMesh&& mesh)
+		{
+			VectorPool<VertexDataTerrain>::Release(std::exchange(mesh.vertices, {}));
+		}
+		/// <summary>
+		/// CreateSectionMeshes() で作成したメッシュを、全てプールに返す
+		/// </summary>
+		static void ReleaseSectionMeshes(SectionMeshes&& meshes)
+		{
+			for (TerrainMesh& mesh : meshes)
+				ReleaseMesh(std::move(mesh));
+		}
+
+	private:
+		// 縦に SectionHeight ブロックずつ分割したセクション (インデックスは下から順)
+		// セクション内のブロックは連続して格納する (インデックスは GetBlockArrayIndex() で計算する)
+		// ブロックの種類は少ないので、パレット圧縮して bit 単位で詰める
+		// 1種類のブロックのみのセクション (空や地中) は、ブロック配列を持たない
+		std::array<PaletteArray<Block>, SectionCount> sections;
+
+		// 占有ビットマスク (ブロックの性質ごとに、その性質を持つブロックのビットが立つ)
+		// OccupancyKind ごとに OccupancyWordCount ワード、その中で列ごとに OccupancyWordsPerColumn ワードずつ並ぶ
+		// SetBlock() の度に更新する. メモリは VectorPool から借りる
+		static constexpr int OccupancyTotalWordCount = OccupancyWordCount * static_cast<int>(OccupancyKind::Count);
+		std::vector<std::uint64_t> occupancy;
+		const std::uint64_t* occupancyView = nullptr; // 読み取り用 (未確保なら EmptyOccupancy を指す)
+		inline static const std::array<std::uint64_t, OccupancyTotalWordCount> EmptyOccupancy{};
+		// 隣接チャンクが1つも無い扱い (チャンク境界の面は全て見えている)
+		inline static const NeighborBorders NoNeighbors{};
+
+		// 各列の、最も高い形を持つブロックのY座標 (無いなら -1. インデックスは GetColumnIndex() で計算する)
+		// SetBlock() の度に差分更新する
+		std::array<std::int16_t, Size * Size> heightMap;
+		int minHeight; // heightMap の最小値
+		int maxHeight; // heightMap の最大値
+		int minHeightColumnCount; // 高さが minHeight の列の数
+		int maxHeightColumnCount; // 高さが maxHeight の列の数
+
+		static constexpr int GetColumnIndex(const Lattice2& positionXZ) noexcept
+		{
+			return positionXZ.x * Size + positionXZ.y;
+		}
+
+		// CreateFromNoise() の、各列の高さ (インデックスは GetColumnIndex(). ワールド座標で決まるので、チャンクの境界でも連続する)
+		// ノイズはチャンク全体の列をまとめて求める (Noise::Simplex2D() の配列版)
+		static ColumnHeights CalculateNoiseHeights(const Lattice2& chunkIndex, const Vector2& noiseScale, int heightBulk, std::uint32_t seed)
+		{
+			const float seedX = static_cast<float>((seed & 0xFFFF0000) >> 16);
+			const float seedZ = static_cast<float>(seed & 0x0000FFFF);
+
+			// 1列ずつ求めていた時と、同じ式で座標を求める (値が変わらないように)
+			std::array<float, Size * Size> noiseXs;
+			std::array<float, Size * Size> noiseZs;
+			for (int x = 0; x < Size; ++x)
+				for (int z = 0; z < Size; ++z)
+				{
+					noiseXs[GetColumnIndex({ x, z })] = 1.0f * (x + Size * chunkIndex.x + seedX) * noiseScale.x;
+					noiseZs[GetColumnIndex({ x, z })] = 1.0f * (z + Size * chunkIndex.y + seedZ) * noiseScale.x;
+				}
+			std::array<float, Size * Size> noises;
+			Noise::Simplex2D(noiseXs, noiseZs, noises);
+
+			ColumnHeights heights;
+			for (int i = 0; i < Size * Size; ++i)
+			{
+				const float heightNormed = (noises[i] + 1.0f) * 0.5f; // [0, 1] に正規化
+				heights[i] = static_cast<std::int16_t>(std::clamp(heightBulk + static_cast<int>(heightNormed * noiseScale.y), 0, Height - 1));
+			}
+			return heights;
+		}
+
+		// 列の [minY, maxY] を、CreateFromNoise() と同じく高度で決まるブロックで埋める
+		// isSurface なら maxY を地表として扱う (土なら草にする)
+		void FillTerrainRun(const Lattice2& positionXZ, int minY, int maxY, int minDirtHeight, int minStoneHeight, bool isSurface)
+		{
+			// 石が最優先. 土・砂は、石より下の範囲のみ
+			FillColumn(positionXZ, minY, std::min(maxY, std::min(minDirtHeight, minStoneHeight) - 1), Block::Sand);
+			FillColumn(positionXZ, std::max(minY, minDirtHeight), std::min(maxY, minStoneHeight - 1), Block::Dirt);
+			FillColumn(positionXZ, std::max(minY, minStoneHeight), maxY, Block::Stone);
+
+			// 土が最上段で終わっているなら、そこは草
+			if (isSurface && GetNoiseTerrainBlock(maxY, maxY, minDirtHeight, minStoneHeight) == Block::Grass)
+				FillColumn(positionXZ, maxY, maxY, Block::Grass);
+		}
+
+		// 列のビットマスクで、Y座標 fromY 以上で最初に value のビットの Y座標 (無いなら Height)
+		static int FindNextBit(const std::array<std::uint64_t, OccupancyWordsPerColumn>& mask, int fromY, bool value) noexcept
+		{
+			for (int wordIndex = fromY >> 6; wordIndex < OccupancyWordsPerColumn; ++wordIndex)
+			{
+				std::uint64_t bits = value ? mask[wordIndex] : ~mask[wordIndex];
+				if (wordIndex == (fromY >> 6))
+					bits &= ~static_cast<std::uint64_t>(0) << (fromY & 63);
+				if (bits != 0)
+					return (wordIndex << 6) + std::countr_zero(bits);
+			}
+			return Height;
+		}
+
+		// CreateFromNoise() の、高さ height の列の、Y座標 y のブロック
+		static constexpr Block GetNoiseTerrainBlock(int y, int height, int minDirtHeight, int minStoneHeight) noexcept
+		{
+			if (y >= minStoneHeight)
+				return Block::Stone;
+			if (y >= minDirtHeight)
+				return (y == height) ? Block::Grass : Block::Dirt; // 最上段は草
+			return Block::Sand;
+		}
+
+		// maxY 以下で最も高い kind の性質を持つブロックのY座標を、占有ビットマスクを走査して求める (無いなら -1)
+		int ScanFloorHeight(const Lattice2& positionXZ, int maxY, OccupancyKind kind) const
+		{
+			// 占有ビットマスクから、maxY 以下で最も高いビットを探す
+			const std::uint64_t* column = GetOccupancyColumn(positionXZ, kind);
+			for (int wordIndex = std::min(maxY, Height - 1) >> 6; wordIndex >= 0; --wordIndex)
+			{
+				const int highBit = (wordIndex == (maxY >> 6)) ? (maxY & 63) : 63;
+				const std::uint64_t bits = column[wordIndex] & GetBitRangeMask(0, highBit);
+				if (bits != 0)
+					return (wordIndex << 6) + 63 - std::countl_zero(bits);
+			}
+
+			return -1; // 地面が無い
+		}
+
+		// OcclusionGrid の opaque, tops の、列 (x, z) のインデックス (x, z は [-1, Size])
+		static constexpr int GetPaddedColumnIndex(int x, int z) noexcept
+		{
+			return (x + 1) * (Size + 2) + (z + 1);
+		}
+
+		// OcclusionGrid::opaque の列の、[y, y + 2] の3ビット (y は [-1, Height - 2]. 高さの範囲外は 0)
+		static std::uint32_t ReadOpaqueBits3(const std::uint64_t* paddedColumn, int y) noexcept
+		{
+			const int wordIndex = (y >> 6) + 1;
+			const int bitIndex = y & 63;
+			// ワードの境界をまたぐ分は、上のワードから足す (2回に分けてずらし、bitIndex = 0 でも 64 ビットずらさない)
+			const std::uint64_t bits = (paddedColumn[wordIndex] >> bitIndex) | ((paddedColumn[wordIndex + 1] << 1) << (63 - bitIndex));
+			return static_cast<std::uint32_t>(bits) & 0b111;
+		}
+
+		// 面の4頂点の遮蔽 (CalculateFaceCornerOcclusions() の値) を、頂点ごとに OcclusionKeyBits ビットずつ1つの値に詰める
+		// 貪欲メッシュで、同じ遮蔽の面だけをまとめるのに使う
+		static constexpr int OcclusionKeyBits = TerrainVertex::AmbientOcclusionBits + TerrainVertex::SkyOcclusionBits;
+		static constexpr std::uint32_t PackOcclusionKey(const std::array<std::uint32_t, 4>& cornerOcclusions) noexcept
+		{
+			std::uint32_t key = 0;
+			for (int corner = 0; corner < 4; ++corner)
+				key |= (cornerOcclusions[corner] >> TerrainVertex::AmbientOcclusionShift) << (corner * OcclusionKeyBits);
+			return key;
+		}
+		static constexpr std::array<std::uint32_t, 4> UnpackOcclusionKey(std::uint32_t key) noexcept
+		{
+			std::array<std::uint32_t, 4> cornerOcclusions = {};
+			for (int corner = 0; corner < 4; ++corner)
+				cornerOcclusions[corner] = ((key >> (corner * OcclusionKeyBits)) & ((1u << OcclusionKeyBits) - 1)) << TerrainVertex::AmbientOcclusionShift;
+			return cornerOcclusions;
+		}
+
+		// 面の手前の層の 3x3 マス (OcclusionGrid での、ブロックの列からのインデックスのずれと、高さのずれ)
+		struct OcclusionCell
+		{
+			int columnOffset;
+			int dy;
+		};
+		// cells : 手前の層の 3x3 マスを、面に沿う2軸 (a, b) の (b + 1) * 3 + (a + 1) の順に並べたもの. 中央 (4) は面の手前のマス
+		// cornerSides[頂点番号] : 頂点のある側 (a の側 * 2 + b の側. 負の側は 0, 正の側は 1)
+		// isVertical : 側面 (a が y 軸なので、cells の各行は、1つの列の縦に連続した3マス)
+		struct FaceOcclusionLayer
+		{
+			std::array<OcclusionCell, 9> cells;
+			std::array<int, 4> cornerSides;
+			bool isVertical;
+		};
+		static constexpr std::array<FaceOcclusionLayer, TerrainVertex::FaceCount> FaceOcclusionLayerTable = []()
+			{
+				std::array<FaceOcclusionLayer, TerrainVertex::FaceCount> table = {};
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+				{
+					const Lattice3& normal = TerrainVertex::FaceNormals[faceIndex];
+					const int n[3] = { normal.x, normal.y, normal.z };
+
+					// 面に沿う2軸 (側面は y 軸を先にする)
+					int tangents[2] = {};
+					int tangentCount = 0;
+					for (const int axis : { 1, 0, 2 })
+					{
+						if (n[axis] == 0)
+							tangents[tangentCount++] = axis;
+					}
+					table[faceIndex].isVertical = (tangents[0] == 1);
+
+					for (int b = -1; b <= 1; ++b)
+						for (int a = -1; a <= 1; ++a)
+						{
+							int d[3] = { n[0], n[1], n[2] };
+							d[tangents[0]] = a;
+							d[tangents[1]] = b;
+							// GetPaddedColumnIndex() の差 (クラスの定義中なので、メンバ関数は呼べない)
+							table[faceIndex].cells[(b + 1) * 3 + (a + 1)] = OcclusionCell{ .columnOffset = d[0] * (Size + 2) + d[2], .dy = d[1] };
+						}
+					for (int corner = 0; corner < 4; ++corner)
+					{
+						const int (&offset)[3] = TerrainVertex::FaceCornerOffsets[faceIndex][corner];
+						table[faceIndex].cornerSides[corner] = offset[tangents[0]] * 2 + offset[tangents[1]];
+					}
+				}
+				return table;
+			}();
+
+		// 手前の層の 3x3 マスのビット (FaceOcclusionLayer::cells の順) から、4つの側の遮蔽を引く表
+		// 側 s の値を s * OcclusionKeyBits ビット目から詰める (環境遮蔽の表と空の遮蔽の表の値を足すと、PackOcclusionKey() と同じ形になる)
+		// OcclusionLayerCornerCells[側] : その側の頂点に接する 側面 a, 側面 b, 角 のマスの、cells でのインデックス
+		static constexpr int OcclusionLayerCornerCells[4][3] = { { 3, 1, 0 }, { 3, 7, 6 }, { 5, 1, 2 }, { 5, 7, 8 } };
+		static constexpr std::array<std::uint32_t, 512> AmbientOcclusionTable = []()
+			{
+				std::array<std::uint32_t, 512> table = {};
+				for (std::uint32_t opaqueBits = 0; opaqueBits < 512; ++opaqueBits)
+					for (int side = 0; side < 4; ++side)
+					{
+						const int (&cells)[3] = OcclusionLayerCornerCells[side];
+						const std::uint32_t side1 = (opaqueBits >> cells[0]) & 1;
+						const std::uint32_t side2 = (opaqueBits >> cells[1]) & 1;
+						const std::uint32_t diagonal = (opaqueBits >> cells[2]) & 1;
+						const std::uint32_t ambientOcclusion = (side1 & side2) ? TerrainVertex::MaxAmbientOcclusion : side1 + side2 + diagonal;
+						table[opaqueBits] |= ambientOcclusion << (side * OcclusionKeyBits);
+					}
+				return table;
+			}();
+		static constexpr std::array<std::uint32_t, 512> SkyOcclusionTable = []()
+			{
+				std::array<std::uint32_t, 512> table = {};
+				for (std::uint32_t hiddenBits = 0; hiddenBits < 512; ++hiddenBits)
+					for (int side = 0; side < 4; ++side)
+					{
+						const int (&cells)[3] = OcclusionLayerCornerCells[side];
+						const std::uint32_t skyOcclusion = ((hiddenBits >> 4) & 1)
+							+ ((hiddenBits >> cells[0]) & 1) + ((hiddenBits >> cells[1]) & 1) + ((hiddenBits >> cells[2]) & 1);
+						table[hiddenBits] |= skyOcclusion << (side * OcclusionKeyBits + TerrainVertex::AmbientOcclusionBits);
+					}
+				return table;
+			}();
+		// 表の値 (側の順) を、PackOcclusionKey() の形 (頂点番号順) に並べ替える
+		static constexpr std::uint32_t ReorderOcclusionKeyToCorners(std::uint32_t sideKey, const std::array<int, 4>& cornerSides) noexcept
+		{
+			std::uint32_t key = 0;
+			for (int corner = 0; corner < 4; ++corner)
+				key |= ((sideKey >> (cornerSides[corner] * OcclusionKeyBits)) & ((1u << OcclusionKeyBits) - 1)) << (corner * OcclusionKeyBits);
+			return key;
+		}
+		// ワールドの底 (y = 0) の下向きの面の4頂点の遮蔽 (手前の層の9マスが、全て不透明ではなく、空が見えない)
+		static constexpr int BelowWorldFaceIndex = 1; // Down
+		static constexpr std::uint32_t BelowWorldOcclusionKey = []()
+			{
+				// ReorderOcclusionKeyToCorners() と同じ (クラスの定義中なので、メンバ関数は定数式で呼べない)
+				const std::uint32_t sideKey = AmbientOcclusionTable[0] + SkyOcclusionTable[0b111'111'111];
+				std::uint32_t key = 0;
+				for (int corner = 0; corner < 4; ++corner)
+					key |= ((sideKey >> (FaceOcclusionLayerTable[BelowWorldFaceIndex].cornerSides[corner] * OcclusionKeyBits)) & ((1u << OcclusionKeyBits) - 1)) << (corner * OcclusionKeyBits);
+				return key;
+			}();
+		// CalculateFaceOcclusionKey() の、遮蔽がありうる面の計算
+		// ↑の判定だけなら呼び出し側に展開されるよう、分けておく
+		static std::uint32_t CalculateOccludableFaceOcclusionKey(const OcclusionGrid& grid, const Lattice3& position, int faceIndex) noexcept
+		{
+			// 面の向きごとに、手前の層のマスのずれを定数にしたものを呼ぶ
+			switch (faceIndex)
+			{
+			case 0: return CalculateFaceOcclusionKeyOf<0>(grid, position);
+			case 1: return CalculateFaceOcclusionKeyOf<1>(grid, position);
+			case 2: return CalculateFaceOcclusionKeyOf<2>(grid, position);
+			case 3: return CalculateFaceOcclusionKeyOf<3>(grid, position);
+			case 4: return CalculateFaceOcclusionKeyOf<4>(grid, position);
+			default: return CalculateFaceOcclusionKeyOf<5>(grid, position);
+			}
+		}
+		// 面の向きをテンプレート引数にして、3x3 マスのずれを定数にしたもの
+		// マスごとの処理は、ループにせず展開する (ずれを表から読み直さずに済む)
+		template<int FaceIndex>
+		static std::uint32_t CalculateFaceOcclusionKeyOf(const OcclusionGrid& grid, const Lattice3& position) noexcept
+		{
+			// 手前の層の 3x3 マスの、空が見えない・不透明 のビットを集めて、表を引く
+			static constexpr const FaceOcclusionLayer& layer = FaceOcclusionLayerTable[FaceIndex];
+			const int columnIndex = GetPaddedColumnIndex(position.x, position.z);
+			std::uint32_t hiddenBits = 0;
+			std::uint32_t opaqueBits = 0;
+			if constexpr (layer.isVertical)
+			{
+				// 側面 : 3x3 マスの各行は、1つの列の y - 1 から y + 1 の連続した3マス
+				// 空が見えないのは列の最も高いブロック以下のマスなので、下から連続する
+				const auto gatherRow = [&](int row)
+					{
+						const int column = columnIndex + layer.cells[row * 3].columnOffset;
+						const int hiddenCount = std::clamp(grid.tops[column] - position.y + 2, 0, 3);
+						// 不透明なマスは、空が見えないマスに含まれるので、hidden で絞らなくてよい
+						hiddenBits |= ((1u << hiddenCount) - 1) << (row * 3);
+						opaqueBits |= ReadOpaqueBits3(grid.opaque[column].data(), position.y - 1) << (row * 3);
+					};
+				[&]<int... Rows>(std::integer_sequence<int, Rows...>) { (gatherRow(Rows), ...); }(std::make_integer_sequence<int, 3>{});
+			}
+			else
+			{
+				// 上下の面 : 9マスとも同じ高さ (ワールドの下になるのは、上で除いた底の下向きの面のみ) なので、同じワード・ビットを読む
+				// 分岐せずにビットを集める
+				const int y = position.y + layer.cells[0].dy;
+				const int wordIndex = (y >> 6) + 1;
+				const int bitIndex = y & 63;
+				const auto gatherCell = [&](int cellIndex)
+					{
+						const int column = columnIndex + layer.cells[cellIndex].columnOffset;
+						hiddenBits |= static_cast<std::uint32_t>(y <= grid.tops[column]) << cellIndex;
+						opaqueBits |= static_cast<std::uint32_t>((grid.opaque[column][wordIndex] >> bitIndex) & 1) << cellIndex;
+					};
+				[&]<int... Cells>(std::integer_sequence<int, Cells...>) { (gatherCell(Cells), ...); }(std::make_integer_sequence<int, 9>{});
+			}
+
+			return ReorderOcclusionKeyToCorners(AmbientOcclusionTable[opaqueBits] + SkyOcclusionTable[hiddenBits], layer.cornerSides);
+		}
+
+		// faceIndex の向きの面の遮蔽が、axis 方向に変わらないか (axis 方向にだけ位置が違う頂点どうしで、遮蔽が同じか)
+		// 変わらないなら、その方向に同じ遮蔽の面をまとめても、頂点間の補間で付く暗さは変わらない
+		static constexpr bool IsOcclusionKeyConstantAlong(std::uint32_t key, int faceIndex, int axis) noexcept
+		{
+			const auto cornerKey = [key](int corner) { return (key >> (corner * OcclusionKeyBits)) & ((1u << OcclusionKeyBits) - 1); };
+			for (int corner = 0; corner < 4; ++corner)
+				for (int other = corner + 1; other < 4; ++other)
+				{
+					const int (&offset)[3] = TerrainVertex::FaceCornerOffsets[faceIndex][corner];
+					const int (&otherOffset)[3] = TerrainVertex::FaceCornerOffsets[faceIndex][other];
+					bool isAlongAxis = offset[axis] != otherOffset[axis];
+					for (int i = 0; i < 3; ++i)
+						isAlongAxis = isAlongAxis && (i == axis || offset[i] == otherOffset[i]);
+					if (isAlongAxis && cornerKey(corner) != cornerKey(other))
+						return false;
+				}
+			return true;
+		}
+
+		// 貪欲メッシュで、面の向きごとの軸 (0 = x, 1 = y, 2 = z)
+		// 面に垂直な軸でスライスし、残りの2軸 (U, V. UV値の向きと同じ) のグリッド上で長方形にまとめる
+		struct GreedyFaceAxes
+		{
+			int slice;
+			int u;
+			int v;
+		};
+		static constexpr GreedyFaceAxes GreedyAxes[] =
+		{
+			{ 1, 0, 2 }, // Up
+			{ 1, 0, 2 }, // Down
+			{ 0, 2, 1 }, // Right
+			{ 0, 2, 1 }, // Left
+			{ 2, 0, 1 }, // Forward
+			{ 2, 0, 1 }, // Backward
+		};
+
+		// 遮蔽のための周囲の列の情報を、求めたものを渡して CreateSectionMesh() する
+		TerrainMesh CreateSectionMesh(int sectionIndex, ChunkMeshingMode mode, const NeighborBorders& neighbors, const OcclusionGrid& occlusionGrid) const
+		{
+			return CreateMeshInRange(sectionIndex * SectionHeight, (sectionIndex + 1) * SectionHeight - 1, mode, neighbors, occlusionGrid);
+		}
+
+		// [minY, maxY] の範囲のブロックの面のメッシュを作る (面が無ければ空のメッシュ)
+		// occlusionGrid は CalculateOcclusionGrid(neighbors) の値 (複数のセクションで使い回せる)
+		TerrainMesh CreateMeshInRange(int minY, int maxY, ChunkMeshingMode mode, const NeighborBorders& neighbors, const OcclusionGrid& occlusionGrid) const
+		{
+			if (mode == ChunkMeshingMode::Greedy)
+				return CreateMeshGreedy(minY, maxY, neighbors, occlusionGrid);
+
+			// 最も高いブロックより上には何も無いので、そこまでのワードだけを見る
+			maxY = std::min(maxY, maxHeight);
+
+			// 1パス目 : 見えている面の数を向きごとに数えて、頂点配列の大きさと、向きごとの書き込み先をちょうどに決める
+			const TerrainMesh::FaceQuadOffsets faceQuadOffsets = TerrainMesh::CalculateFaceQuadOffsets(CountExposedFacesByDirection(neighbors, minY, maxY));
+			const int quadCount = faceQuadOffsets[TerrainVertex::FaceCount];
+			if (quadCount <= 0)
+				return TerrainMesh{};
+
+			TerrainMesh mesh = {};
+			mesh.vertices = VectorPool<VertexDataTerrain>::Acquire(static_cast<std::size_t>(quadCount) * TerrainMesh::VerticesPerQuad);
+			mesh.vertices.resize(static_cast<std::size_t>(quadCount) * TerrainMesh::VerticesPerQuad);
+			mesh.faceQuadOffsets = faceQuadOffsets;
+
+			// 2パス目 : 見えている面の頂点を、表を引いて向きごとの範囲に直接書き込む
+			const std::span<VertexDataTerrain> output = mesh.vertices;
+			std::array<std::size_t, TerrainVertex::FaceCount> writtenCounts = {};
+			for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+				writtenCounts[faceIndex] = static_cast<std::size_t>(mesh.GetFaceQuadBegin(faceIndex)) * TerrainMesh::VerticesPerQuad;
+
+			// ColumnMajor レイアウトで連続アクセスになるよう、y を最内ループにする
+			for (int xi = 0; xi < Chunk::Size; ++xi)
+				for (int zi = 0; zi < Chunk::Size; ++zi)
+					for (int wordIndex = minY >> 6; wordIndex <= (maxY >> 6); ++wordIndex)
+					{
+						// 縦64ブロック分の面の可視判定を、ビット演算でまとめて行う
+						FaceMasks faceMasks = CalculateExposedFaceMasks({ xi, zi }, wordIndex, neighbors);
+						const std::uint64_t rangeMask = GetWordRangeMask(wordIndex, minY, maxY);
+						for (std::uint64_t& faceMask : faceMasks)
+							faceMask &= rangeMask;
+						std::uint64_t exposedMask = faceMasks[0] | faceMasks[1] | faceMasks[2] | faceMasks[3] | faceMasks[4] | faceMasks[5];
+
+						// 見えている面を1つ以上持つブロックだけを、下から順に処理する
+						while (exposedMask != 0)
+						{
+							const int bitIndex = std::countr_zero(exposedMask);
+							exposedMask &= exposedMask - 1;
+
+							const int yi = (wordIndex << 6) + bitIndex;
+							const Block block = GetBlock({ xi, yi, zi });
+							const std::uint32_t packedBlockPosition = TerrainVertex::EncodePosition(Lattice3(xi, yi, zi));
+
+							// このブロックの見えている面 (ビット i が 面 i)
+							std::uint32_t faceBits = 0;
+							for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+								faceBits |= static_cast<std::uint32_t>((faceMasks[faceIndex] >> bitIndex) & 1) << faceIndex;
+
+							// ワールドから見た向きで、テクスチャの配置は固定する
+							while (faceBits != 0)
+							{
+								const int faceIndex = std::countr_zero(faceBits);
+								faceBits &= faceBits - 1;
+
+								// 遮蔽がありえない面 (開けた地表の大半) は、遮蔽を求めずにそのまま書き込む
+								const std::span<VertexDataTerrain, 4> out = output.subspan(writtenCounts[faceIndex]).first<4>();
+								const std::uint32_t textureIndex = BlockProperties::GetTextureIndex(block, faceIndex);
+								if (yi > occlusionGrid.occludableTops[GetColumnIndex({ xi, zi })][faceIndex])
+									TerrainVertex::WriteFace(out, packedBlockPosition, faceIndex, textureIndex);
+								else
+									TerrainVertex::WriteFace(out, packedBlockPosition, faceIndex, textureIndex, UnpackOcclusionKey(CalculateFaceOcclusionKey(occlusionGrid, { xi, yi, zi }, faceIndex)));
+								writtenCounts[faceIndex] += TerrainMesh::VerticesPerQuad;
+							}
+						}
+					}
+
+			// 数えた数と書き込んだ数は一致する (プールのサイズクラスの配列をそのまま使うので、詰め替えも要らない)
+			for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+				assert(writtenCounts[faceIndex] == static_cast<std::size_t>(mesh.GetFaceQuadBegin(faceIndex) + mesh.GetFaceQuadCount(faceIndex)) * TerrainMesh::VerticesPerQuad);
+			return mesh;
+		}
+
+		// 同じ平面上で同じテクスチャの面を、長方形にまとめてメッシュを作る ([minY, maxY] の範囲のブロックの面のみ)
+		TerrainMesh CreateMeshGreedy(int minY, int maxY, const NeighborBorders& neighbors, const OcclusionGrid& occlusionGrid) const
+		{
+			constexpr int FaceCount = BlockProperties::FaceCount;
+			constexpr int NoFace = -1; // グリッドで、面が無いことを表す値
+
+			// 最も高いブロックより上には何も無いので、そこまでを見る
+			maxY = std::min(maxY, maxHeight);
+			if (minY > maxY)
+				return TerrainMesh{};
+			// 各軸の範囲 [mins, maxs)
+			const int mins[3] = { 0, minY, 0 };
+			const int maxs[3] = { Size, maxY + 1, Size };
+
+			// 全ての列について、面ごとの可視ビットマスクを先に求めておく
+			// インデックスは [面][列][ワード]
+			std::vector<std::uint64_t> exposedMasks = VectorPool<std::uint64_t>::Acquire(FaceCount * Size * Size * OccupancyWordsPerColumn);
+			exposedMasks.resize(FaceCount * Size * Size * OccupancyWordsPerColumn, 0);
+			const auto exposedMaskIndex = [](int faceIndex, int columnIndex, int wordIndex)
+				{
+					return (faceIndex * Size * Size + columnIndex) * OccupancyWordsPerColumn + wordIndex;
+				};
+			// 見えている面の頂点の遮蔽 (PackOcclusionKey() の値) も、ワード単位でまとめて求めておく
+			// インデックスは [面][列][Y座標 - 最初のワードの下端]
+			const int wordBottom = (minY >> 6) << 6;
+			const int keyColumnHeight = (((maxY >> 6) + 1) << 6) - wordBottom;
+			std::vector<std::uint32_t> occlusionKeys = VectorPool<std::uint32_t>::Acquire(static_cast<std::size_t>(FaceCount) * Size * Size * keyColumnHeight);
+			occlusionKeys.resize(static_cast<std::size_t>(FaceCount) * Size * Size * keyColumnHeight);
+			const auto occlusionKeyIndex = [&](int faceIndex, int columnIndex, int y)
+				{
+					return (static_cast<std::size_t>(faceIndex) * Size * Size + columnIndex) * keyColumnHeight + (y - wordBottom);
+				};
+
+			// 同時に見えている面の数を数える (まとめた四角形の数は、これを超えない)
+			int exposedFaceCount = 0;
+			for (int xi = 0; xi < Size; ++xi)
+				for (int zi = 0; zi < Size; ++zi)
+					for (int wordIndex = minY >> 6; wordIndex <= (maxY >> 6); ++wordIndex)
+					{
+						const FaceMasks faceMasks = CalculateExposedFaceMasks({ xi, zi }, wordIndex, neighbors);
+						const std::uint64_t rangeMask = GetWordRangeMask(wordIndex, minY, maxY);
+						for (int faceIndex = 0; faceIndex < FaceCount; ++faceIndex)
+						{
+							exposedMasks[exposedMaskIndex(faceIndex, GetColumnIndex({ xi, zi }), wordIndex)] = faceMasks[faceIndex] & rangeMask;
+							exposedFaceCount += std::popcount(faceMasks[faceIndex] & rangeMask);
+						}
+
+						// 頂点の遮蔽
+						for (int faceIndex = 0; faceIndex < FaceCount; ++faceIndex)
+						{
+							std::uint64_t faceMask = faceMasks[faceIndex] & rangeMask;
+							while (faceMask != 0)
+							{
+								const int y = (wordIndex << 6) + std::countr_zero(faceMask);
+								faceMask &= faceMask - 1;
+								occlusionKeys[occlusionKeyIndex(faceIndex, GetColumnIndex({ xi, zi }), y)] =
+									CalculateFaceOcclusionKey(occlusionGrid, { xi, y, zi }, faceIndex);
+							}
+						}
+					}
+
+			// 上限の大きさで借りて、そこに直接書き込む
+			TerrainMesh mesh = {};
+			mesh.vertices = VectorPool<VertexDataTerrain>::Acquire(static_cast<std::size_t>(exposedFaceCount) * TerrainMesh::VerticesPerQuad);
+			mesh.vertices.resize(static_cast<std::size_t>(exposedFaceCount) * TerrainMesh::VerticesPerQuad);
+			const std::span<VertexDataTerrain> output = mesh.vertices;
+			std::size_t writtenCount = 0;
+
+			// スライス内の2次元グリッド (面のテクスチャのインデックス. 面が無いなら NoFace) と、面の遮蔽 (PackOcclusionKey() の値)
+			// 最大で Size x Height
+			std::array<int, Size * Height> grid;
+			std::array<std::uint32_t, Size * Height> occlusionKeyGrid;
+
+			// 面の向きごとに、メッシュ内の並び順で作るので、四角形は向きごとにまとまって並ぶ
+			for (int slot = 0; slot < FaceCount; ++slot)
+			{
+				const int faceIndex = TerrainMesh::FaceLayoutOrder[slot];
+				mesh.faceQuadOffsets[slot] = static_cast<int>(writtenCount / TerrainMesh::VerticesPerQuad);
+				const GreedyFaceAxes& axes = GreedyAxes[faceIndex];
+				const int gridWidth = maxs[axes.u] - mins[axes.u];
+				const int gridHeight = maxs[axes.v] - mins[axes.v];
+
+				for (int slice = mins[axes.slice]; slice < maxs[axes.slice]; ++slice)
+				{
+					// グリッドを埋める
+					bool isAnyFace = false;
+					for (int gv = 0; gv < gridHeight; ++gv)
+						for (int gu = 0; gu < gridWidth; ++gu)
+						{
+							int position[3];
+							position[axes.slice] = slice;
+							position[axes.u] = mins[axes.u] + gu;
+							position[axes.v] = mins[axes.v] + gv;
+
+							const int columnIndex = GetColumnIndex({ position[0], position[2] });
+							const std::uint64_t mask = exposedMasks[exposedMaskIndex(faceIndex, columnIndex, position[1] >> 6)];
+							int& cell = grid[gv * gridWidth + gu];
+							if (((mask >> (position[1] & 63)) & 1) == 0)
+							{
+								cell = NoFace;
+								continue;
+							}
+
+							const Block block = GetBlock({ position[0], position[1], position[2] });
+							cell = static_cast<int>(BlockProperties::GetTextureIndex(block, faceIndex));
+							occlusionKeyGrid[gv * gridWidth + gu] = occlusionKeys[occlusionKeyIndex(faceIndex, columnIndex, position[1])];
+							isAnyFace = true;
+						}
+					if (!isAnyFace)
+						continue;
+
+					// 左上から順に、同じテクスチャ・同じ遮蔽の面を U方向 -> V方向 の順に伸ばして長方形にまとめる
+					// 遮蔽がその方向に変わる面は、その方向には伸ばさない (例: 地面に接する側面は、横にだけまとめる)
+					for (int gv = 0; gv < gridHeight; ++gv)
+						for (int gu = 0; gu < gridWidth; ++gu)
+						{
+							const int textureIndex = grid[gv * gridWidth + gu];
+							if (textureIndex == NoFace)
+								continue;
+							const std::uint32_t occlusionKey = occlusionKeyGrid[gv * gridWidth + gu];
+							const bool canMergeU = IsOcclusionKeyConstantAlong(occlusionKey, faceIndex, axes.u);
+							const bool canMergeV = IsOcclusionKeyConstantAlong(occlusionKey, faceIndex, axes.v);
+							const auto isSameFace = [&](int cellIndex)
+								{
+									return grid[cellIndex] == textureIndex && occlusionKeyGrid[cellIndex] == occlusionKey;
+								};
+
+							int width = 1;
+							while (canMergeU && gu + width < gridWidth && isSameFace(gv * gridWidth + gu + width))
+								++width;
+
+							int height = 1;
+							while (canMergeV && gv + height < gridHeight)
+							{
+								const int rowBegin = (gv + height) * gridWidth + gu;
+								bool isSameRow = true;
+								for (int i = 0; i < width && isSameRow; ++i)
+									isSameRow = isSameFace(rowBegin + i);
+								if (!isSameRow)
+									break;
+								++height;
+							}
+
+							// まとめた分は、グリッドから消す
+							for (int dv = 0; dv < height; ++dv)
+								std::fill_n(&grid[(gv + dv) * gridWidth + gu], width, NoFace);
+
+							int blockMin[3];
+							blockMin[axes.slice] = slice;
+							blockMin[axes.u] = mins[axes.u] + gu;
+							blockMin[axes.v] = mins[axes.v] + gv;
+							int size[3];
+							size[axes.slice] = 1;
+							size[axes.u] = width;
+							size[axes.v] = height;
+
+							WriteGreedyQuad(output.subspan(writtenCount).first<4>(), faceIndex, blockMin, size, static_cast<std::uint32_t>(textureIndex),
+								UnpackOcclusionKey(occlusionKey));
+							writtenCount += TerrainMesh::VerticesPerQuad;
+						}
+				}
+			}
+
+			VectorPool<std::uint64_t>::Release(std::move(exposedMasks));
+			VectorPool<std::uint32_t>::Release(std::move(occlusionKeys));
+			mesh.vertices.resize(writtenCount);
+			mesh.faceQuadOffsets[FaceCount] = mesh.GetQuadCount();
+
+			// 借りた配列より小さなサイズクラスで足りるなら、詰め替える
+			if (mesh.vertices.size() * 2 <= mesh.vertices.capacity())
+				mesh.vertices = VectorPool<VertexDataTerrain>::ShrinkToClass(std::move(mesh.vertices));
+			return mesh;
+		}
+
+		// blockMin から size ブロック分の範囲の、faceIndex の向きの面を、1枚の四角形として out に書き込む
+		// cornerOcclusions : 頂点番号順の遮蔽 (TerrainVertex::EncodeOcclusion() の値. 焼き込まないなら 0)
+		static void WriteGreedyQuad(std::span<VertexDataTerrain, 4> out, int faceIndex, const int (&blockMin)[3], const int (&size)[3], std::uint32_t textureIndex,
+			const std::array<std::uint32_t, 4>& cornerOcclusions = {})
+		{
+			// 頂点順は CreateMesh() と同じ (インデックスは共有のもの)
+			// 1ブロック分の面の頂点のずれを、ブロック数に合わせて伸ばす
+			// UV値は格子点から求まるので、シェーダー側で1ブロックごとに繰り返される
+			const std::array<int, 4> order = TerrainVertex::GetCornerWriteOrder(cornerOcclusions);
+			for (int i = 0; i < 4; ++i)
+			{
+				const int corner = order[i];
+				const int (&offset)[3] = TerrainVertex::FaceCornerOffsets[faceIndex][corner];
+				const Lattice3 cornerPosition = Lattice3(
+					blockMin[0] + offset[0] * size[0],
+					blockMin[1] + offset[1] * size[1],
+					blockMin[2] + offset[2] * size[2]);
+
+				out[i] = TerrainVertex::Encode(cornerPosition, faceIndex, corner, textureIndex);
+				out[i].packed |= cornerOcclusions[corner];
+			}
+		}
+
+		// 作成したメッシュの後処理 (空ならダミーにする)
+		static TerrainMesh FinalizeMesh(TerrainMesh&& mesh)
+		{
+			// 頂点が1つも無い場合、ダミーで何か入れておく
+			if (mesh.vertices.size() <= 0)
+			{
+				ReleaseMesh(std::move(mesh));
+
+				// 空気なので、表示はされない
+				return TerrainMesh::CreateFace(Lattice3::Zero(), 0, static_cast<std::uint32_t>(Block::Air));
+			}
+
+			return std::move(mesh);
+		}
+
+		// wordIndex ワード目のうち、Y座標が [minY, maxY] に入るビットが立ったマスク
+		static constexpr std::uint64_t GetWordRangeMask(int wordIndex, int minY, int maxY) noexcept
+		{
+			const int wordMinY = wordIndex << 6;
+			const int lowBit = std::max(minY - wordMinY, 0);
+			const int highBit = std::min(maxY - wordMinY, 63);
+			return (lowBit <= highBit) ? GetBitRangeMask(lowBit, highBit) : 0;
+		}
+
+		// [lowBit, highBit] のビットが立ったマスク
+		static constexpr std::uint64_t GetBitRangeMask(int lowBit, int highBit) noexcept
+		{
+			const std::uint64_t upToHigh = (highBit >= 63) ? ~static_cast<std::uint64_t>(0) : ((static_cast<std::uint64_t>(1) << (highBit + 1)) - 1);
+			return upToHigh & (~static_cast<std::uint64_t>(0) << lowBit);
+		}
+
+		void RefreshOccupancyView() noexcept
+		{
+			occupancyView = !occupancy.empty() ? occupancy.data() : EmptyOccupancy.data();
+		}
+
+		void AllocateOccupancy()
+		{
+			ReleaseOccupancy();
+			occupancy = VectorPool<std::uint64_t>::Acquire(OccupancyTotalWordCount);
+			occupancy.resize(OccupancyTotalWordCount, 0);
+			RefreshOccupancyView();
+		}
+
+		void ReleaseOccupancy()
+		{
+			if (occupancy.capacity() > 0)
+				VectorPool<std::uint64_t>::Release(std::exchange(occupancy, {}));
+			RefreshOccupancyView();
+		}
+
+		// ブロックの書き換えに合わせて、占有ビットマスクを更新する
+		void UpdateOccupancy(const Lattice3& position, Block block)
+		{
+			if (occupancy.empty())
+				AllocateOccupancy();
+
+			const int wordIndex = GetColumnIndex({ position.x, position.z }) * OccupancyWordsPerColumn + (position.y >> 6);
+			const int bitIndex = position.y & 63;
+			const std::uint64_t bit = static_cast<std::uint64_t>(1) << bitIndex;
+
+			// 性質の表から、分岐なしでビットを書き換える
+			const auto write = [&](OccupancyKind kind, bool value)
+				{
+					std::uint64_t& word = occupancy[static_cast<int>(kind) * OccupancyWordCount + wordIndex];
+					word = (word & ~bit) | (static_cast<std::uint64_t>(value) << bitIndex);
+				};
+			write(OccupancyKind::Solid, BlockProperties::IsSolid(block));
+			write(OccupancyKind::Opaque, BlockProperties::IsOpaque(block));
+			write(OccupancyKind::Collidable, BlockProperties::IsCollidable(block));
+		}
+
+		// 列の範囲 [minY, maxY] の書き換えに合わせて、占有ビットマスクを更新する
+		void FillOccupancy(const Lattice2& positionXZ, int minY, int maxY, Block block)
+		{
+			if (occupancy.empty())
+				AllocateOccupancy();
+
+			const int columnWordIndex = GetColumnIndex(positionXZ) * OccupancyWordsPerColumn;
+			const auto write = [&](OccupancyKind kind, bool value)
+				{
+					std::uint64_t* column = occupancy.data() + static_cast<int>(kind) * OccupancyWordCount + columnWordIndex;
+					for (int wordIndex = minY >> 6; wordIndex <= (maxY >> 6); ++wordIndex)
+					{
+						const int lowBit = (wordIndex == (minY >> 6)) ? (minY & 63) : 0;
+						const int highBit = (wordIndex == (maxY >> 6)) ? (maxY & 63) : 63;
+						const std::uint64_t mask = GetBitRangeMask(lowBit, highBit);
+						column[wordIndex] = value ? (column[wordIndex] | mask) : (column[wordIndex] & ~mask);
+					}
+				};
+			write(OccupancyKind::Solid, BlockProperties::IsSolid(block));
+			write(OccupancyKind::Opaque, BlockProperties::IsOpaque(block));
+			write(OccupancyKind::Collidable, BlockProperties::IsCollidable(block));
+		}
+
+		// ブロックの書き換えに合わせて、ハイトマップを更新する
+		void UpdateHeightMap(const Lattice3& position, Block block)
+		{
+			const Lattice2 positionXZ = Lattice2(position.x, position.z);
+			const int oldHeight = heightMap[GetColumnIndex(positionXZ)];
+
+			if (BlockProperties::IsSolid(block))
+				SetColumnHeight(positionXZ, std::max(oldHeight, position.y));
+			else if (position.y == oldHeight)
+				SetColumnHeight(positionXZ, ScanFloorHeight(positionXZ, position.y - 1, OccupancyKind::Solid)); // 最上段が消えたので、その下を探す
+		}
+
+		// 列の高さを書き換え、最小/最大を更新する
+		void SetColumnHeight(const Lattice2& positionXZ, int newHeight)
+		{
+			const int oldHeight = heightMap[GetColumnIndex(positionXZ)];
+			if (newHeight == oldHeight)
+				return;
+			heightMap[GetColumnIndex(positionXZ)] = static_cast<std::int16_t>(newHeight);
+
+			// 最小/最大だった最後の列が内側に動いた時だけ、全ての列から求め直す
+			// (生成直後は全列が最小なので、列ごとに求め直すと、列数の2乗かかる)
+			const bool leavesMin = (oldHeight == minHeight && newHeight > oldHeight) && (--minHeightColumnCount == 0);
+			const bool leavesMax = (oldHeight == maxHeight && newHeight < oldHeight) && (--maxHeightColumnCount == 0);
+			if (leavesMin || leavesMax)
+			{
+				RecalculateMinMaxHeights();
+				return;
+			}
+
+			if (newHeight < minHeight)
+			{
+				minHeight = newHeight;
+				minHeightColumnCount = 1;
+			}
+			else if (newHeight == minHeight)
+				++minHeightColumnCount;
+
+			if (newHeight > maxHeight)
+			{
+				maxHeight = newHeight;
+				maxHeightColumnCount = 1;
+			}
+			else if (newHeight == maxHeight)
+				++maxHeightColumnCount;
+		}
+
+		// 全ての列から、最小/最大とその列の数を求め直す
+		void RecalculateMinMaxHeights() noexcept
+		{
+			const auto [minIt, maxIt] = std::minmax_element(heightMap.begin(), heightMap.end());
+			minHeight = *minIt;
+			maxHeight = *maxIt;
+			minHeightColumnCount = static_cast<int>(std::count(heightMap.begin(), heightMap.end(), *minIt));
+			maxHeightColumnCount = static_cast<int>(std::count(heightMap.begin(), heightMap.end(), *maxIt));
+		}
 	};
 }
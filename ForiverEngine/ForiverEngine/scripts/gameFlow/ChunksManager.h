@@ -4,29 +4,126 @@
 #include <scripts/helper/Include.h>
 #include <scripts/component/Include.h>
 #include "./Chunk.h"
+#include "./TerrainGenerator.h"
 
 namespace ForiverEngine
 {
+	/// <summary>
+	/// <para>描画範囲 (Chunk::DrawDistance) の外側に、簡略化したメッシュ (LOD) で描画するチャンクの設定</para>
+	/// <para>LOD レベル L のチャンクは、2^L ブロック四方を1つの柱にまとめる (Chunk::CreateLodMesh())</para>
+	/// </summary>
+	struct ChunkLodSettings
+	{
+		static constexpr int LevelCount = 3;         // LOD レベル 1, 2, 3 (2x, 4x, 8x)
+		static constexpr int MaxDistance = 64;       // ringDistances に指定できる最大値
+
+		// LOD レベル i+1 で描画する、カメラからの最大チャンク数 (矩形)
+		// 昇順で、Chunk::DrawDistance より大きいこと. それ以下の値のレベルは使わない (0 なら全て使わない)
+		// デフォルトは、描画範囲の4倍までを、描画範囲の近くから粗いレベルに切り替えて描画する
+		// (頂点数は、描画範囲を詳細に描画する分の約 1.12 倍. 詳細に描画する分はそのままなので、LOD の分だけ必ず 1.0 倍を超える. 全て最も粗いレベルにしても約 1.09 倍)
+		std::array<int, LevelCount> ringDistances = { Chunk::DrawDistance + 2, Chunk::DrawDistance * 2, Chunk::DrawDistance * 4 };
+
+		/// <summary>
+		/// LOD で描画する最大のチャンク数 (矩形. LOD を使わないなら Chunk::DrawDistance)
+		/// </summary>
+		int GetOuterDistance() const noexcept
+		{
+			int outerDistance = Chunk::DrawDistance;
+			for (const int ringDistance : ringDistances)
+				outerDistance = std::max(outerDistance, std::min(ringDistance, MaxDistance));
+			return outerDistance;
+		}
+
+		/// <summary>
+		/// <para>カメラからのチャンク数 distance (矩形) のチャンクの LOD レベルを取得する</para>
+		/// <para>描画範囲内 (詳細に描画する) か、LOD の範囲外 (描画しない) なら 0</para>
+		/// </summary>
+		int GetLevel(int distance) const noexcept
+		{
+			if (distance <= Chunk::DrawDistance)
+				return 0;
+			for (int i = 0; i < LevelCount; ++i)
+			{
+				if (distance <= std::min(ringDistances[i], MaxDistance))
+					return i + 1;
+			}
+			return 0;
+		}
+	};
+
 	class ChunksManager
 	{
 	public:
+		static constexpr std::size_t DefaultMemoryBudget = 512ull * 1024 * 1024; // 生成済みチャンクが使うメモリ量の上限 [byte] (デフォルト値)
+		static constexpr int UnloadMargin = 2; // 描画範囲から、さらにこのチャンク数だけ離れたチャンクをアンロード対象にする
+
+		// セクションごとのデータ (インデックスはセクションと同じ)
+		template<typename T>
+		using SectionsArray = std::array<T, Chunk::SectionCount>;
+
+		// 地形のメッシュの頂点は、全チャンク (LOD 含む) で共有するページに詰める
+		using TerrainVertexArena = VertexBufferArena<VertexDataTerrain>;
+		using VertexSlice = TerrainVertexArena::Slice;
+
+		// PackDrawCommands() の結果 (全ての配列は、ドローコール数と同じ要素数. D3D12Utils::Draw() にそのまま渡す)
+		struct DrawCommands
+		{
+			std::vector<VertexBufferView> vbvs;   // 頂点バッファのページ全体
+			std::vector<IndexBufferView> ibvs;    // 共有のインデックスバッファ
+			std::vector<int> indicesCounts;
+			std::vector<Vector4> chunkOrigins;    // チャンクの原点のワールド座標 (xyz. w は使わない). ルート定数としてシェーダーに渡す
+			std::vector<int> baseVertices;        // ページ内での、描画する最初の四角形の頂点
+
+			void Clear()
+			{
+				vbvs.clear();
+				ibvs.clear();
+				indicesCounts.clear();
+				chunkOrigins.clear();
+				baseVertices.clear();
+			}
+		};
+
 		ChunksManager() = default;
 
-		ChunksManager(const Lattice2& playerFirstExistingChunkIndex)
+		/// <param name="memoryBudget">生成済みチャンクが使うメモリ量の上限 [byte]. 超えたら、遠くて長く使っていないチャンクからアンロードする</param>
+		/// <param name="meshingMode">チャンクのメッシュの作り方</param>
+		/// <param name="terrainSettings">地形の設定</param>
+		ChunksManager(const Lattice2& playerFirstExistingChunkIndex, std::size_t memoryBudget = DefaultMemoryBudget,
+			ChunkMeshingMode meshingMode = ChunkMeshingMode::PerFace,
+			const TerrainGenerationSettings& terrainSettings = TerrainGenerationSettings::CreateFractal())
+			: memoryBudget(memoryBudget), meshingMode(meshingMode)
 		{
+			terrainGenerator = TerrainGenerator(terrainSettings);
+
 			generationStates = Chunk::CreateChunksArray<std::atomic<ChunkGenerationState>>();
 			chunks = Chunk::CreateChunksArray<Chunk>();
-			meshes = Chunk::CreateChunksArray<Mesh>();
-			vbvs = Chunk::CreateChunksArray<VertexBufferView>();
-			ibvs = Chunk::CreateChunksArray<IndexBufferView>();
+			meshes = Chunk::CreateChunksArray<Chunk::SectionMeshes>();
+			vertexSlices = Chunk::CreateChunksArray<SectionsArray<VertexSlice>>();
+			lastUsedTimes = Chunk::CreateChunksArray<std::uint32_t>();
+			remeshRequests = Chunk::CreateChunksArray<bool>();
+			lodLevels = Chunk::CreateChunksArray<std::int8_t>();
+			lodMeshes = Chunk::CreateChunksArray<TerrainMesh>();
+			lodGroups = std::vector<LodGroup>(static_cast<std::size_t>(RegionCount) * RegionCount * ChunkLodSettings::LevelCount);
+			for (int groupIndex = 0; groupIndex < static_cast<int>(lodGroups.size()); ++groupIndex)
+			{
+				const int regionIndex = groupIndex / ChunkLodSettings::LevelCount;
+				lodGroups[groupIndex].regionOrigin = Lattice2(regionIndex / RegionCount, regionIndex % RegionCount) * Chunk::RegionSize;
+				lodGroups[groupIndex].level = groupIndex % ChunkLodSettings::LevelCount + 1;
+			}
 
-			drawVBVs = Chunk::CreateDrawChunksArray<VertexBufferView>();
-			drawIBVs = Chunk::CreateDrawChunksArray<IndexBufferView>();
-			drawMeshIndicesCounts = Chunk::CreateDrawChunksArray<int>();
+			drawVertexSlices = Chunk::CreateDrawChunksArray<SectionsArray<VertexSlice>>();
+			drawMeshIndicesCounts = Chunk::CreateDrawChunksArray<SectionsArray<int>>();
+			drawFaceQuadOffsets = Chunk::CreateDrawChunksArray<SectionsArray<TerrainMesh::FaceQuadOffsets>>();
 
-			packedDrawVBVs.reserve(Chunk::DrawCountMax * Chunk::DrawCountMax);
-			packedDrawIBVs.reserve(Chunk::DrawCountMax * Chunk::DrawCountMax);
-			packedDrawMeshIndicesCounts.reserve(Chunk::DrawCountMax * Chunk::DrawCountMax);
+			// 描画はセクション単位 (面の無いセクションは描画しない. 視点から見えない向きの面を省くと、1セクションが最大3つに分かれる)
+			constexpr int DrawCountReserved = Chunk::DrawCountMax * Chunk::DrawCountMax * Chunk::SectionCount;
+			packedDraws.reserve(DrawCountReserved);
+			packedDrawCommands.vbvs.reserve(DrawCountReserved);
+			packedDrawCommands.ibvs.reserve(DrawCountReserved);
+			packedDrawCommands.indicesCounts.reserve(DrawCountReserved);
+			packedDrawCommands.chunkOrigins.reserve(DrawCountReserved);
+			packedDrawCommands.baseVertices.reserve(DrawCountReserved);
 
 			drawRangeInfo = Chunk::CreateDrawChunksIndexRangeInfo(playerFirstExistingChunkIndex);
 		}
@@ -37,15 +134,11 @@ namespace ForiverEngine
 		{
 			return chunks;
 		}
-		const Chunk::DrawChunksArray<VertexBufferView>& GetDrawVBVs() const noexcept
-		{
-			return drawVBVs;
-		}
-		const Chunk::DrawChunksArray<IndexBufferView>& GetDrawIBVs() const noexcept
+		const TerrainVertexArena& GetVertexArena() const noexcept
 		{
-			return drawIBVs;
+			return vertexArena;
 		}
-		const Chunk::DrawChunksArray<int>& GetDrawMeshIndicesCounts() const noexcept
+		const Chunk::DrawChunksArray<SectionsArray<int>>& GetDrawMeshIndicesCounts() const noexcept
 		{
 			return drawMeshIndicesCounts;
 		}
@@ -53,9 +146,42 @@ namespace ForiverEngine
 		{
 			return drawRangeInfo;
 		}
+		std::size_t GetMemoryBudget() const noexcept
+		{
+			return memoryBudget;
+		}
+		ChunkMeshingMode GetMeshingMode() const noexcept
+		{
+			return meshingMode;
+		}
+		int GetLoadedChunkCount() const noexcept
+		{
+			return static_cast<int>(loadedChunkIndices.size());
+		}
+		const ChunkLodSettings& GetLodSettings() const noexcept
+		{
+			return lodSettings;
+		}
+		int GetDrawLodChunkCount() const noexcept
+		{
+			return drawLodChunkCount;
+		}
+		int GetDrawLodGroupCount() const noexcept
+		{
+			return static_cast<int>(drawLodGroupIndices.size());
+		}
 
 #pragma endregion
 
+		/// <summary>
+		/// <para>LOD の設定を変更する (次の UpdateDrawChunks() から反映される)</para>
+		/// <para>レベルが変わるチャンクは、その時に作り直す</para>
+		/// </summary>
+		void SetLodSettings(const ChunkLodSettings& settings) noexcept
+		{
+			lodSettings = settings;
+		}
+
 		/// <summary>
 		/// 指定されたチャンク・指定された座標のブロックを取得する
 		/// </summary>
@@ -66,85 +192,219 @@ namespace ForiverEngine
 
 		/// <summary>
 		/// <para>指定されたチャンク・指定された座標のブロックを更新する</para>
-		/// <para>その後、そのチャンクのデータを再生成する</para>
+		/// <para>その後、メッシュが変わりうるセクションのみ (Chunk::GetSectionsAffectedByBlock()) を作り直し、描画データにも反映する</para>
+		/// <para>列の最も高いブロックが変わったなら、空の遮蔽が変わりうる高さのセクションも作り直す</para>
+		/// <para>チャンク境界のブロックなら、隣接チャンクの同じセクションも作り直す (チャンクの角の列なら、斜めの隣接チャンクも)</para>
+		/// <para>チャンクが生成途中 (別スレッドで処理中など) なら何もせず、false を返す</para>
+		/// <para>周囲で装飾を並列処理中 (境界を写し取れない) なら、メッシュは後で全セクション作り直す</para>
 		/// </summary>
-		void UpdateChunkBlock(const Lattice2& chunkIndex, const Lattice3& localBlockPosition, const Block& newBlock, const Device& device)
+		bool UpdateChunkBlock(const Lattice2& chunkIndex, const Lattice3& localBlockPosition, const Block& newBlock, const Device& device)
 		{
-			chunks[chunkIndex.x][chunkIndex.y].SetBlock(localBlockPosition, newBlock);
-			meshes[chunkIndex.x][chunkIndex.y] = chunks[chunkIndex.x][chunkIndex.y].CreateMesh(chunkIndex);
+			if (generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire) != ChunkGenerationState::FinishedAll)
+				return false;
+
+			Chunk& chunk = chunks[chunkIndex.x][chunkIndex.y];
+			const Lattice2 positionXZ = Lattice2(localBlockPosition.x, localBlockPosition.z);
+			const int oldColumnHeight = chunk.GetColumnHeight(positionXZ);
+			chunk.SetBlock(localBlockPosition, newBlock);
+			const Chunk::SectionMask sectionMask = Chunk::GetSectionsAffectedByBlock(localBlockPosition, oldColumnHeight, chunk.GetColumnHeight(positionXZ));
+			RequestRemesh(chunkIndex, sectionMask, device);
+			CopyToDrawDataIfInRange(chunkIndex);
 
-			const auto [vbv, ibv] = D3D12Utils::CreateMeshViews(device, meshes[chunkIndex.x][chunkIndex.y]);
-			vbvs[chunkIndex.x][chunkIndex.y] = vbv;
-			ibvs[chunkIndex.x][chunkIndex.y] = ibv;
+			// 境界のブロックは、隣接チャンクの面を遮っているかもしれない (空の遮蔽も、境界の列の高さから求める)
+			// 角の列のブロックは、斜めの隣接チャンクの、角の面の頂点の遮蔽にも使われる
+			const auto remeshNeighborIf = [&](bool isOnBorder, const Lattice2& neighborChunkIndex)
+				{
+					if (!isOnBorder || !Chunk::IsValidIndex(neighborChunkIndex))
+						return;
+					RequestRemesh(neighborChunkIndex, sectionMask, device);
+					CopyToDrawDataIfInRange(neighborChunkIndex);
+				};
+			remeshNeighborIf(localBlockPosition.x == Chunk::Size - 1, chunkIndex + Lattice2(1, 0));
+			remeshNeighborIf(localBlockPosition.x == 0, chunkIndex - Lattice2(1, 0));
+			remeshNeighborIf(localBlockPosition.z == Chunk::Size - 1, chunkIndex + Lattice2(0, 1));
+			remeshNeighborIf(localBlockPosition.z == 0, chunkIndex - Lattice2(0, 1));
+			remeshNeighborIf(localBlockPosition.x == Chunk::Size - 1 && localBlockPosition.z == Chunk::Size - 1, chunkIndex + Lattice2(1, 1));
+			remeshNeighborIf(localBlockPosition.x == Chunk::Size - 1 && localBlockPosition.z == 0, chunkIndex + Lattice2(1, -1));
+			remeshNeighborIf(localBlockPosition.x == 0 && localBlockPosition.z == Chunk::Size - 1, chunkIndex + Lattice2(-1, 1));
+			remeshNeighborIf(localBlockPosition.x == 0 && localBlockPosition.z == 0, chunkIndex + Lattice2(-1, -1));
+
+			return true;
 		};
 
 		/// <summary>
 		/// <para>描画するチャンクの範囲を更新し、描画するチャンクが未生成ならば新規生成する (引数で並列生成か指定可能)</para>
-		/// <para>また、描画データに値をコピーする</para>
+		/// <para>生成は 地形 → 装飾 → メッシュ → GPU への転送 の順に、チャンクごとに、必要な周囲のチャンクが前の段階を終えたものから進める</para>
+		/// <para>また、描画データに値をコピーし、LOD の更新・アンロード (LRU) を行う</para>
+		/// <para>途中の段階のチャンクは、AdvanceGeneration() で毎フレーム進める</para>
 		/// </summary>
 		void UpdateDrawChunks(const Lattice2& playerExistingChunkIndex, bool parallelIfGenerate, const Device& deviceIfGenerate)
 		{
 			drawRangeInfo = Chunk::CreateDrawChunksIndexRangeInfo(playerExistingChunkIndex);
+			++currentTime;
 
-			for (int xi = drawRangeInfo.rangeX.x; xi <= drawRangeInfo.rangeX.y; ++xi)
-				for (int zi = drawRangeInfo.rangeZ.x; zi <= drawRangeInfo.rangeZ.y; ++zi)
+			ForEachTerrainRange([this](const Lattice2& chunkIndex)
 				{
-					GenerateChunk({ xi, zi }, parallelIfGenerate, deviceIfGenerate);
-					CopyToDrawData({ xi, zi });
-				}
+					lastUsedTimes[chunkIndex.x][chunkIndex.y] = currentTime;
+				});
+			AdvanceGenerationInRange(parallelIfGenerate, deviceIfGenerate, true);
+
+			UpdateLodChunks(playerExistingChunkIndex, deviceIfGenerate);
+			UnloadChunksOverBudget(playerExistingChunkIndex);
+
+			// 解放で断片化したページを詰め直す (前フレームの描画は完了しているので、頂点を動かしてよい)
+			vertexArena.Compact();
 		}
 
 		/// <summary>
-		/// 実際に描画するものを抽出して返す
+		/// <para>描画範囲 (と、その生成に必要な周囲) のチャンクの生成を、進められるだけ進める (毎フレーム呼ぶ)</para>
+		/// <para>並列処理が完了した段階の後処理・次の段階の開始・GPU への転送と、後回しにしたメッシュの作り直しを行い、変わったチャンクのみ描画データにコピーする</para>
+		/// <para>描画範囲は変えない (LOD の更新・アンロードは、UpdateDrawChunks() で行う)</para>
 		/// </summary>
-		const std::vector<VertexBufferView>& PackDrawVBVs()
+		void AdvanceGeneration(bool parallelIfGenerate, const Device& deviceIfGenerate)
 		{
-			PackDrawData(drawVBVs, packedDrawVBVs);
-			return packedDrawVBVs;
+			AdvanceGenerationInRange(parallelIfGenerate, deviceIfGenerate, false);
 		}
+
 		/// <summary>
-		/// 実際に描画するものを抽出して返す
+		/// <para>生成済みのチャンクが使っているメモリ量 [byte] を計算する (CPU・GPU の合計の概算)</para>
+		/// <para>並列処理中 (周囲の装飾で書き込まれうるものも) のチャンクは含まない. 使い回すためにプールが保持している分は含む</para>
 		/// </summary>
-		const std::vector<IndexBufferView>& PackDrawIBVs()
+		std::size_t CalculateLoadedMemoryUsage() const
 		{
-			PackDrawData(drawIBVs, packedDrawIBVs);
-			return packedDrawIBVs;
+			std::size_t usage = CalculatePooledMemoryUsage();
+			for (const Lattice2& chunkIndex : loadedChunkIndices)
+			{
+				if (!IsTouchedByParallel(chunkIndex))
+					usage += CalculateChunkMemoryUsage(chunkIndex);
+			}
+			return usage;
 		}
+
 		/// <summary>
-		/// 実際に描画するものを抽出して返す
+		/// <para>実際に描画するものを抽出して、ドローコールの配列にパックして返す</para>
+		/// <para>ドローコールはセクション単位. 面の無いセクションは描画しない. LOD のチャンクは、リージョン・レベルごとにまとめて描画する</para>
+		/// <para>culling を指定すると、セクション (LOD はまとめたチャンク全体) の範囲から見て裏を向く向きの面を省く (メッシュは面の向きごとに並ぶので、見える向きの範囲のみを描画する)</para>
+		/// <para>頂点バッファのページごとにまとめて並べる (同じページのドローコールは、頂点バッファをバインドし直さずに、BaseVertexLocation だけを変えて描画できる)</para>
+		/// <para>同じチャンクの、頂点バッファ上で続く範囲は1回のドローコールにまとめる. 同じメッシュの範囲なら、間の見えない向きの面も含めてまとめる (パイプラインの裏面カリングで捨てられる)</para>
 		/// </summary>
-		const std::vector<int>& PackDrawMeshIndicesCounts()
+		const DrawCommands& PackDrawCommands(const TerrainFaceCulling& culling = {})
 		{
-			PackDrawData(drawMeshIndicesCounts, packedDrawMeshIndicesCounts);
-			return packedDrawMeshIndicesCounts;
+			packedDraws.clear();
+			ForEachDrawRange(culling,
+				[this](const Lattice2& chunkIndex, const Lattice2& drawDataIndex, int sectionIndex, int firstQuad, int quadCount)
+				{
+					PushPackedDraw(drawVertexSlices[drawDataIndex.x][drawDataIndex.y][sectionIndex], chunkIndex, firstQuad, quadCount);
+				},
+				[this](const LodGroup& group, int firstQuad, int quadCount)
+				{
+					PushPackedDraw(group.slice, group.regionOrigin, firstQuad, quadCount);
+				});
+			std::stable_sort(packedDraws.begin(), packedDraws.end(),
+				[](const PackedDraw& a, const PackedDraw& b) { return a.page < b.page; });
+
+			packedDrawCommands.Clear();
+			for (const PackedDraw& draw : packedDraws)
+			{
+				packedDrawCommands.vbvs.push_back(vertexArena.GetPageVBV(draw.page));
+				packedDrawCommands.ibvs.push_back(quadIndexBufferView); // インデックスバッファは全チャンクで共有する
+				packedDrawCommands.indicesCounts.push_back(draw.quadCount * TerrainMesh::IndicesPerQuad);
+				packedDrawCommands.chunkOrigins.push_back(Vector4(Chunk::GetOriginWorldPosition(draw.chunkIndex)));
+				packedDrawCommands.baseVertices.push_back(draw.baseVertex);
+			}
+			return packedDrawCommands;
 		}
 
 	private:
-		// チャンク生成の進捗ステート
+		static constexpr int DecorationRangeMargin = 1; // 装飾は、描画範囲よりこのチャンク数だけ広く行う (メッシュの作成に、周囲 3x3 の装飾が必要なため)
+		static constexpr int TerrainRangeMargin = 2;    // 地形は、さらに1チャンク広く生成する (装飾に、周囲 3x3 の地形が必要なため)
+		static constexpr int RegionCount = Chunk::Count / Chunk::RegionSize; // ワールド全体の、1辺のリージョン数
+
+		// チャンク生成の進捗ステート (この順に進む)
+		// 各段階は、必要な周囲のチャンクが前の段階を終えてから始める. 段階の開始はメインスレッドのみで行い、並列処理中のチャンクのデータはロックせずに扱う
+		// ライティング (AO・空の遮蔽) はメッシュの頂点に焼き込むので、メッシュの段階に含む
 		enum class ChunkGenerationState : std::uint8_t
 		{
-			NotYet = 0,       // 未作成 (デフォルト値)
-			CreatingParallel, // 並列処理中
-			FinishedParallel, // 並列処理完了済み
-			FinishedAll,      // 全部完了済み
+			NotYet = 0,         // 未作成 (デフォルト値)
+			CreatingParallel,   // 地形を並列処理中
+			CreatedParallel,    // 地形の並列処理完了済み (メインスレッドでの後処理待ち)
+			TerrainFinished,    // 地形が完了済み (周囲 3x3 の地形が揃うのを待って、装飾する)
+			DecoratingParallel, // 装飾を並列処理中 (周囲 3x3 のチャンクにも書き込む)
+			Decorated,          // 装飾が完了済み (周囲 3x3 の装飾が揃うのを待って、メッシュを作成する)
+			MeshingParallel,    // メッシュを並列処理中 (以降、ブロックは確定済み. 装飾からは書き込まれない)
+			FinishedParallel,   // メッシュの並列処理完了済み
+			FinishedAll,        // 全部完了済み
 		};
 
 		// 全チャンクのデータ
 		Chunk::ChunksArray<std::atomic<ChunkGenerationState>> generationStates;
 		Chunk::ChunksArray<Chunk> chunks;
-		Chunk::ChunksArray<Mesh> meshes;
-		Chunk::ChunksArray<VertexBufferView> vbvs;
-		Chunk::ChunksArray<IndexBufferView> ibvs;
+		Chunk::ChunksArray<Chunk::SectionMeshes> meshes;                // セクションごと (ブロックの編集時に、そのセクションだけを作り直せるように)
+		Chunk::ChunksArray<SectionsArray<VertexSlice>> vertexSlices;     // vertexArena 内の頂点の区間 (面の無いセクションは、無効のまま)
+		Chunk::ChunksArray<std::uint32_t> lastUsedTimes;  // 最後に描画範囲に入っていた時刻 (currentTime の値)
+		Chunk::ChunksArray<bool> remeshRequests;          // メッシュの作成後に、隣接チャンクが変わったので作り直す必要がある (メインスレッドでのみ操作する)
+
+		// 地形の生成 (各列の高さを、リージョン単位でキャッシュする. 地形と LOD の地表で共有する)
+		TerrainGenerator terrainGenerator;
+
+		// 生成を開始したチャンクのインデックス一覧 (メインスレッドでのみ操作する)
+		std::vector<Lattice2> loadedChunkIndices;
+		// loadedChunkIndices のチャンクが使うメモリ量の上限 [byte]
+		std::size_t memoryBudget = DefaultMemoryBudget;
+		// チャンクのメッシュの作り方
+		ChunkMeshingMode meshingMode = ChunkMeshingMode::PerFace;
+		// UpdateDrawChunks() の呼び出し回数. LRU の時刻として使う
+		std::uint32_t currentTime = 0;
+
+		// LOD のチャンクを、リージョン・レベルごとにまとめたもの (1つのメッシュにして、1回で描画する)
+		// 頂点は、リージョンの原点からのチャンク数を texIndex に詰める (Chunk::MergeLodMeshes())
+		struct LodGroup
+		{
+			Lattice2 regionOrigin;
+			int level = 0;
+			VertexSlice slice = {};                              // まとめたメッシュの、vertexArena 内の頂点の区間
+			TerrainMesh::FaceQuadOffsets faceQuadOffsets = {};
+			Lattice2 chunkIndexMin = Lattice2::Zero();           // 面のあるチャンクの範囲 (カリング用)
+			Lattice2 chunkIndexMax = Lattice2::Zero();
+			int chunkCount = 0;                                  // 面のあるチャンクの数
+			bool isDirty = false;                                // チャンクが増減したので、まとめ直す必要がある
+		};
+
+		// LOD (描画範囲の外側の、簡略化したメッシュ) のデータ
+		// チャンクごとのメッシュは CPU 側に残し (頂点数が少ない)、チャンクが増減したグループだけを、まとめ直して GPU に送る
+		ChunkLodSettings lodSettings;
+		Chunk::ChunksArray<std::int8_t> lodLevels;             // 作成済みの LOD レベル (無いなら 0)
+		Chunk::ChunksArray<TerrainMesh> lodMeshes;             // チャンクごとの LOD のメッシュ (頂点は、チャンク内の座標)
+		std::vector<Lattice2> lodChunkIndices;                  // LOD のメッシュを持つチャンク一覧
+		std::vector<LodGroup> lodGroups;                        // 全リージョン・全レベル分 (GetLodGroupIndex())
+		std::vector<int> dirtyLodGroupIndices;                  // まとめ直すグループ一覧
+		std::vector<int> drawLodGroupIndices;                   // 描画するグループ一覧 (描画順)
+		int drawLodChunkCount = 0;                              // 描画するグループに含まれる、面のあるチャンクの数
+
+		// 全チャンク (LOD 含む) のメッシュの頂点を詰める、頂点バッファのページ
+		TerrainVertexArena vertexArena;
+		// 全チャンクで共有する、四角形のインデックスバッファ (メッシュの四角形の数の上限分)
+		GraphicsBuffer quadIndexBuffer;
+		IndexBufferView quadIndexBufferView;
 
 		// 描画するチャンクのみのデータ
-		Chunk::DrawChunksArray<VertexBufferView> drawVBVs;
-		Chunk::DrawChunksArray<IndexBufferView> drawIBVs;
-		Chunk::DrawChunksArray<int> drawMeshIndicesCounts;
+		Chunk::DrawChunksArray<SectionsArray<VertexSlice>> drawVertexSlices;
+		Chunk::DrawChunksArray<SectionsArray<int>> drawMeshIndicesCounts;
+		Chunk::DrawChunksArray<SectionsArray<TerrainMesh::FaceQuadOffsets>> drawFaceQuadOffsets; // 面の向きごとの範囲 (描画しないなら全て 0)
+
+		// ドローコール1回分 (ページごとに並べ替えてから、DrawCommands に展開する)
+		struct PackedDraw
+		{
+			int page;
+			int baseVertex;
+			int quadCount;
+			Lattice2 chunkIndex;
+			int sliceFirstVertex; // 描画するメッシュの区間の先頭 (同じメッシュの範囲かの判定に使う)
+		};
 
 		// 描画するチャンクのみのデータ (パック後. 配列を作成してキャッシュする)
-		std::vector<VertexBufferView> packedDrawVBVs;
-		std::vector<IndexBufferView> packedDrawIBVs;
-		std::vector<int> packedDrawMeshIndicesCounts;
+		std::vector<PackedDraw> packedDraws;
+		DrawCommands packedDrawCommands;
 
 		// 描画するチャンクの範囲を表すデータ
 		Chunk::DrawChunksIndexRangeInfo drawRangeInfo;
@@ -155,19 +415,119 @@ namespace ForiverEngine
 			return chunkIndex - drawRangeInfo.GetRangeMin();
 		}
 
-		// 地形のデータ・メッシュを作成し、キャッシュする
-		// 並列処理可能. 最初にこっちを実行する
-		void GenerateChunkParallel(const Lattice2& chunkIndex)
+		// 並列処理中か (並列処理中のチャンクのデータには、メインスレッドから触らない)
+		bool IsProcessingParallel(const Lattice2& chunkIndex) const
 		{
-			Chunk chunk = Chunk::CreateFromNoise(chunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+			const ChunkGenerationState state = generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire);
+			return state == ChunkGenerationState::CreatingParallel
+				|| state == ChunkGenerationState::DecoratingParallel
+				|| state == ChunkGenerationState::MeshingParallel;
+		}
+
+		// 周囲 (チェビシェフ距離 distance 以内. 自身を含む) に、装飾を並列処理中のチャンクがあるか
+		// 装飾は周囲 3x3 に書き込むので、distance = 1 なら、このチャンクのブロックが書き込まれうる
+		bool IsDecoratingAround(const Lattice2& chunkIndex, int distance) const
+		{
+			for (int xi = std::max(chunkIndex.x - distance, 0); xi <= std::min(chunkIndex.x + distance, Chunk::Count - 1); ++xi)
+				for (int zi = std::max(chunkIndex.y - distance, 0); zi <= std::min(chunkIndex.y + distance, Chunk::Count - 1); ++zi)
+				{
+					if (generationStates[xi][zi].load(std::memory_order_acquire) == ChunkGenerationState::DecoratingParallel)
+						return true;
+				}
+			return false;
+		}
 
-			meshes[chunkIndex.x][chunkIndex.y] = chunk.CreateMesh(chunkIndex);
-			chunks[chunkIndex.x][chunkIndex.y] = std::move(chunk);
+		// 並列処理中か、周囲の装飾の並列処理で書き込まれうるか (どちらも、メインスレッドからチャンクのデータに触らない)
+		bool IsTouchedByParallel(const Lattice2& chunkIndex) const
+		{
+			return IsProcessingParallel(chunkIndex) || IsDecoratingAround(chunkIndex, 1);
+		}
 
-			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::FinishedParallel, std::memory_order_release);
+		// 周囲 3x3 (自身を含む. ワールドの端の外側は除く) のチャンクが全て、state 以降の段階にあるか
+		bool IsNeighborhoodAtLeast(const Lattice2& chunkIndex, ChunkGenerationState state) const
+		{
+			for (int xi = std::max(chunkIndex.x - 1, 0); xi <= std::min(chunkIndex.x + 1, Chunk::Count - 1); ++xi)
+				for (int zi = std::max(chunkIndex.y - 1, 0); zi <= std::min(chunkIndex.y + 1, Chunk::Count - 1); ++zi)
+				{
+					if (generationStates[xi][zi].load(std::memory_order_acquire) < state)
+						return false;
+				}
+			return true;
+		}
+
+		// 地形が完了済みか (隣接チャンクから参照してよいか)
+		bool HasTerrain(const Lattice2& chunkIndex) const
+		{
+			return generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire) >= ChunkGenerationState::TerrainFinished;
+		}
+
+		// ブロックが確定済みか (周囲の装飾が全て完了して、メッシュの作成を始めた. 以降は並列処理から書き込まれない)
+		bool HasFinalBlocks(const Lattice2& chunkIndex) const
+		{
+			return generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire) >= ChunkGenerationState::MeshingParallel;
+		}
+
+		// 隣接する4チャンク (Right, Left, Forward, Backward の順)
+		static std::array<Lattice2, 4> GetNeighborChunkIndices(const Lattice2& chunkIndex) noexcept
+		{
+			return
+			{
+				chunkIndex + Lattice2(1, 0),
+				chunkIndex - Lattice2(1, 0),
+				chunkIndex + Lattice2(0, 1),
+				chunkIndex - Lattice2(0, 1),
+			};
+		}
+
+		// 隣接する4チャンクの境界と、斜めに隣接する4チャンクの角の列を写し取る (地形が無いチャンクは、無いものとして扱う)
+		// 隣接チャンクに装飾が書き込んでいない (IsDecoratingAround(chunkIndex, 2) でない) 時に呼ぶこと
+		Chunk::NeighborBorders CaptureNeighborBorders(const Lattice2& chunkIndex) const
+		{
+			// 順番は Right, Left, Forward, Backward, RightForward, RightBackward, LeftForward, LeftBackward
+			const std::array<Lattice2, 8> neighborChunkIndices =
+			{
+				chunkIndex + Lattice2(1, 0),
+				chunkIndex - Lattice2(1, 0),
+				chunkIndex + Lattice2(0, 1),
+				chunkIndex - Lattice2(0, 1),
+				chunkIndex + Lattice2(1, 1),
+				chunkIndex + Lattice2(1, -1),
+				chunkIndex + Lattice2(-1, 1),
+				chunkIndex + Lattice2(-1, -1),
+			};
+			std::array<const Chunk*, 8> neighbors = {};
+			for (int i = 0; i < 8; ++i)
+			{
+				const Lattice2& neighborChunkIndex = neighborChunkIndices[i];
+				if (Chunk::IsValidIndex(neighborChunkIndex) && HasTerrain(neighborChunkIndex))
+					neighbors[i] = &chunks[neighborChunkIndex.x][neighborChunkIndex.y];
+			}
+
+			return Chunk::CaptureNeighborBorders(
+				neighbors[0], neighbors[1], neighbors[2], neighbors[3],
+				neighbors[4], neighbors[5], neighbors[6], neighbors[7]);
+		}
+
+		// 地形を生成する (LOD の地表も、同じ各列の高さから求める)
+		Chunk CreateTerrain(const Lattice2& chunkIndex)
+		{
+			return terrainGenerator.CreateChunk(chunkIndex);
+		}
+		Chunk::SurfaceMap CreateTerrainSurfaceMap(const Lattice2& chunkIndex)
+		{
+			return terrainGenerator.CreateSurfaceMap(chunkIndex);
+		}
+
+		// 地形のデータを作成し、キャッシュする
+		// 並列処理可能. 最初にこっちを実行する
+		void GenerateTerrainParallel(const Lattice2& chunkIndex)
+		{
+			chunks[chunkIndex.x][chunkIndex.y] = CreateTerrain(chunkIndex);
+
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::CreatedParallel, std::memory_order_release);
 		};
-		// ↑の並列処理を実行開始する
-		void TryStartGenerateChunkParallel(const Lattice2& chunkIndex)
+		// ↑の処理を開始済みにする. 既に開始済みなら false を返す
+		bool TryBeginGenerateChunkParallel(const Lattice2& chunkIndex)
 		{
 			ChunkGenerationState expectedState = ChunkGenerationState::NotYet;
 
@@ -177,50 +537,267 @@ namespace ForiverEngine
 					ChunkGenerationState::CreatingParallel,
 					std::memory_order_acq_rel))
 			{
-				// 既に該当処理が開始済みなので、何もしない
-				return;
+				// 既に該当処理が開始済み
+				return false;
 			}
 
-			std::thread([=]()
+			loadedChunkIndices.push_back(chunkIndex);
+			return true;
+		}
+		// ↑の並列処理を実行開始する
+		void TryStartGenerateChunkParallel(const Lattice2& chunkIndex)
+		{
+			if (!TryBeginGenerateChunkParallel(chunkIndex))
+				return;
+
+			ThreadPool::Enqueue([this, chunkIndex]()
 				{
-					GenerateChunkParallel(chunkIndex);
-				}).detach();
+					GenerateTerrainParallel(chunkIndex);
+				});
 		};
 
-		// 地形の頂点・インデックスバッファビューを作成し、キャッシュしておく
-		// GPUが絡むので並列処理不可. 並列処理の方が完了した後、メインスレッドで実行する
-		void GenerateChunkNotParallel(const Lattice2& chunkIndex, const Device& device)
+		// 地形の並列処理が完了した後、メインスレッドで実行する
+		void FinishGenerateTerrain(const Lattice2& chunkIndex)
 		{
 			if (generationStates[chunkIndex.x][chunkIndex.y]
 				.load(std::memory_order_acquire)
-				!= ChunkGenerationState::FinishedParallel)
+				!= ChunkGenerationState::CreatedParallel)
 				return;
 
-			const auto [vbv, ibv] = D3D12Utils::CreateMeshViews(device, meshes[chunkIndex.x][chunkIndex.y]);
-			vbvs[chunkIndex.x][chunkIndex.y] = vbv;
-			ibvs[chunkIndex.x][chunkIndex.y] = ibv;
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::TerrainFinished, std::memory_order_release);
 
-			// メインスレッドで1フレーム内で終わらせるので、この状態更新でOK
-			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::FinishedAll, std::memory_order_release);
-		};
+			// 先にメッシュを作成した隣接チャンクは、境界の面が変わりうるので作り直す
+			// (アンロード後の再生成や、ワールドの端など)
+			for (const Lattice2& neighborChunkIndex : GetNeighborChunkIndices(chunkIndex))
+			{
+				if (!Chunk::IsValidIndex(neighborChunkIndex))
+					continue;
+				if (generationStates[neighborChunkIndex.x][neighborChunkIndex.y].load(std::memory_order_acquire) >= ChunkGenerationState::MeshingParallel)
+					remeshRequests[neighborChunkIndex.x][neighborChunkIndex.y] = true;
+			}
+		}
 
-		// 指定されたチャンクを生成する
+		// 指定されたチャンクの地形を生成する
 		// 並列で処理するか、指定できる
-		void GenerateChunk(const Lattice2& chunkIndex, bool parallel, const Device& device)
+		void GenerateChunkTerrain(const Lattice2& chunkIndex, bool parallel)
 		{
 			if (parallel)
 			{
 				// 作成中にやっぱり描画しないとなっても、スレッドは止まらず並列処理完了まで動き続ける
 				// そのため、並列処理でない部分をその後いつ呼んでも問題ない (状態ガードをちゃんと入れているので)
 				TryStartGenerateChunkParallel(chunkIndex);
-				GenerateChunkNotParallel(chunkIndex, device);
 			}
 			else
 			{
 				// メインスレッドで1フレームで全て終わらせる
-				GenerateChunkParallel(chunkIndex);
-				GenerateChunkNotParallel(chunkIndex, device);
+				if (TryBeginGenerateChunkParallel(chunkIndex))
+					GenerateTerrainParallel(chunkIndex);
 			}
+			FinishGenerateTerrain(chunkIndex);
+		}
+
+		// 装飾 (周囲 3x3 のチャンクにはみ出す岩) を置く
+		// 並列処理可能. 書き込むチャンク・置き直す隣接チャンクの装飾は、開始時にメインスレッドで決めたものを使う
+		void DecorateParallel(const Lattice2& chunkIndex, const TerrainGenerator::Neighborhood& targets, const std::vector<Lattice2>& pulledSourceChunkIndices)
+		{
+			terrainGenerator.Decorate(chunkIndex, targets);
+
+			// 先に装飾を済ませた隣接チャンクの岩のうち、このチャンクにはみ出す部分を置き直す
+			// (アンロード後に地形を作り直したなら、消えている. そうでなければ、同じブロックを上書きするだけ)
+			Chunk* const self = targets[TerrainGenerator::GetNeighborhoodIndex(Lattice2::Zero())];
+			for (const Lattice2& sourceChunkIndex : pulledSourceChunkIndices)
+			{
+				TerrainGenerator::Neighborhood selfOnly = {};
+				selfOnly[TerrainGenerator::GetNeighborhoodIndex(chunkIndex - sourceChunkIndex)] = self;
+				terrainGenerator.Decorate(sourceChunkIndex, selfOnly);
+			}
+
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::Decorated, std::memory_order_release);
+		}
+		// 周囲 3x3 の地形が揃っていたら、↑の処理を開始する (並列で処理するか、指定できる)
+		// 書き込む範囲が重なりうる (チェビシェフ距離 2 以内の) チャンクとは、同時に装飾しない
+		// 装飾の開始はメインスレッドのみなので、この判定から開始までの間に、周囲で装飾が始まることはない
+		void GenerateChunkDecoration(const Lattice2& chunkIndex, bool parallel)
+		{
+			if (generationStates[chunkIndex.x][chunkIndex.y]
+				.load(std::memory_order_acquire)
+				!= ChunkGenerationState::TerrainFinished)
+				return;
+
+			if (!IsNeighborhoodAtLeast(chunkIndex, ChunkGenerationState::TerrainFinished) || IsDecoratingAround(chunkIndex, 2))
+				return;
+
+			// ブロックが確定済みのチャンクには書き込まない (このチャンクの初回の装飾で、既に岩が置かれている)
+			TerrainGenerator::Neighborhood targets = {};
+			std::vector<Lattice2> pulledSourceChunkIndices = {};
+			for (int dx = -1; dx <= 1; ++dx)
+				for (int dz = -1; dz <= 1; ++dz)
+				{
+					const Lattice2 neighborChunkIndex = chunkIndex + Lattice2(dx, dz);
+					if (!Chunk::IsValidIndex(neighborChunkIndex))
+						continue;
+					if (!HasFinalBlocks(neighborChunkIndex))
+						targets[TerrainGenerator::GetNeighborhoodIndex({ dx, dz })] = &chunks[neighborChunkIndex.x][neighborChunkIndex.y];
+					if (neighborChunkIndex != chunkIndex &&
+						generationStates[neighborChunkIndex.x][neighborChunkIndex.y].load(std::memory_order_acquire) >= ChunkGenerationState::Decorated)
+						pulledSourceChunkIndices.push_back(neighborChunkIndex);
+				}
+
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::DecoratingParallel, std::memory_order_release);
+
+			if (parallel)
+			{
+				ThreadPool::Enqueue([this, chunkIndex, targets, pulledSourceChunkIndices]()
+					{
+						DecorateParallel(chunkIndex, targets, pulledSourceChunkIndices);
+					});
+			}
+			else
+			{
+				DecorateParallel(chunkIndex, targets, pulledSourceChunkIndices);
+			}
+		}
+
+		// メッシュを作成し、キャッシュする
+		// 並列処理可能. 隣接チャンクの境界は、開始時に写し取ったものを使う
+		void CreateMeshParallel(const Lattice2& chunkIndex, const Chunk::NeighborBorders& neighborBorders)
+		{
+			Chunk::ReleaseSectionMeshes(std::move(meshes[chunkIndex.x][chunkIndex.y]));
+			meshes[chunkIndex.x][chunkIndex.y] = chunks[chunkIndex.x][chunkIndex.y].CreateSectionMeshes(meshingMode, neighborBorders);
+
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::FinishedParallel, std::memory_order_release);
+		}
+		// 周囲 3x3 の装飾が揃っていたら、↑の処理を開始する
+		void TryStartCreateMesh(const Lattice2& chunkIndex, bool parallel)
+		{
+			if (generationStates[chunkIndex.x][chunkIndex.y]
+				.load(std::memory_order_acquire)
+				!= ChunkGenerationState::Decorated)
+				return;
+
+			// 周囲 3x3 の装飾が済めば、このチャンクのブロックは確定する (ワールドの端の外側は、チャンクが無いものとして扱う)
+			// 隣接チャンクのこちら側の境界も、残りの装飾では変わらない (岩は、隣接チャンクの向こう側の境界までは届かない)
+			if (!IsNeighborhoodAtLeast(chunkIndex, ChunkGenerationState::Decorated))
+				return;
+			// 隣接チャンクに装飾が書き込んでいる最中は、境界を写し取れないので待つ
+			if (IsDecoratingAround(chunkIndex, 2))
+				return;
+
+			const Chunk::NeighborBorders neighborBorders = CaptureNeighborBorders(chunkIndex);
+			remeshRequests[chunkIndex.x][chunkIndex.y] = false;
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::MeshingParallel, std::memory_order_release);
+
+			if (parallel)
+			{
+				ThreadPool::Enqueue([this, chunkIndex, neighborBorders]()
+					{
+						CreateMeshParallel(chunkIndex, neighborBorders);
+					});
+			}
+			else
+			{
+				CreateMeshParallel(chunkIndex, neighborBorders);
+			}
+		}
+
+		// 地形を生成する範囲 (描画範囲より TerrainRangeMargin だけ広い) のチャンクについて、func(チャンクのインデックス) を呼ぶ
+		template<typename TFunc>
+		void ForEachTerrainRange(const TFunc& func) const
+		{
+			ForEachRangeWithMargin(TerrainRangeMargin, func);
+		}
+		// 描画範囲より margin だけ広い範囲 (ワールドの端で切り詰める) のチャンクについて、func(チャンクのインデックス) を呼ぶ
+		template<typename TFunc>
+		void ForEachRangeWithMargin(int margin, const TFunc& func) const
+		{
+			for (int xi = std::max(drawRangeInfo.rangeX.x - margin, 0); xi <= std::min(drawRangeInfo.rangeX.y + margin, Chunk::Count - 1); ++xi)
+				for (int zi = std::max(drawRangeInfo.rangeZ.x - margin, 0); zi <= std::min(drawRangeInfo.rangeZ.y + margin, Chunk::Count - 1); ++zi)
+					func(Lattice2(xi, zi));
+		}
+
+		// 描画範囲のチャンクの生成を、地形 → 装飾 → メッシュ の順に進める
+		// copiesAllToDrawData なら (描画範囲が変わったので) 全チャンクを、そうでなければメッシュ・GPU のバッファが変わったチャンクのみ、描画データにコピーする
+		void AdvanceGenerationInRange(bool parallel, const Device& device, bool copiesAllToDrawData)
+		{
+			CreateQuadIndexBufferIfNeeded(device);
+
+			ForEachTerrainRange([&](const Lattice2& chunkIndex) { GenerateChunkTerrain(chunkIndex, parallel); });
+			ForEachRangeWithMargin(DecorationRangeMargin, [&](const Lattice2& chunkIndex) { GenerateChunkDecoration(chunkIndex, parallel); });
+			ForEachRangeWithMargin(0, [&](const Lattice2& chunkIndex)
+				{
+					if (GenerateChunkMesh(chunkIndex, parallel, device) || copiesAllToDrawData)
+						CopyToDrawData(chunkIndex);
+				});
+		}
+
+		// 地形の頂点・インデックスバッファビューを作成し、キャッシュしておく. 作成したら true を返す
+		// GPUが絡むので並列処理不可. メッシュの並列処理が完了した後、メインスレッドで実行する
+		bool GenerateChunkNotParallel(const Lattice2& chunkIndex, const Device& device)
+		{
+			if (generationStates[chunkIndex.x][chunkIndex.y]
+				.load(std::memory_order_acquire)
+				!= ChunkGenerationState::FinishedParallel)
+				return false;
+
+			CreateMeshBuffers(chunkIndex, device);
+
+			// メインスレッドで1フレーム内で終わらせるので、この状態更新でOK
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::FinishedAll, std::memory_order_release);
+			return true;
+		};
+
+		// 指定されたチャンクのメッシュを生成する (地形は生成済みであること)
+		// 並列で処理するか、指定できる. GPU のバッファを作成・作り直したら true を返す
+		bool GenerateChunkMesh(const Lattice2& chunkIndex, bool parallel, const Device& device)
+		{
+			TryStartCreateMesh(chunkIndex, parallel);
+			bool isChanged = GenerateChunkNotParallel(chunkIndex, device);
+
+			// 作成後に隣接チャンクが変わったなら、作り直す (境界を写し取れるようになるまで待つ)
+			if (remeshRequests[chunkIndex.x][chunkIndex.y] &&
+				generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire) == ChunkGenerationState::FinishedAll &&
+				!IsDecoratingAround(chunkIndex, 2))
+			{
+				RemeshChunk(chunkIndex, device);
+				isChanged = true;
+			}
+			return isChanged;
+		}
+
+		// メッシュ・GPU のバッファを、メインスレッドで全セクション作り直す (生成が完了済みのチャンクのみ)
+		void RemeshChunk(const Lattice2& chunkIndex, const Device& device)
+		{
+			Chunk::ReleaseSectionMeshes(std::move(meshes[chunkIndex.x][chunkIndex.y]));
+			meshes[chunkIndex.x][chunkIndex.y] = chunks[chunkIndex.x][chunkIndex.y].CreateSectionMeshes(meshingMode, CaptureNeighborBorders(chunkIndex));
+			remeshRequests[chunkIndex.x][chunkIndex.y] = false;
+
+			// 古いバッファは、もう使わないので解放する (フレームごとに GPU の完了を待っているので、使用中ではない)
+			ReleaseMeshBuffers(chunkIndex);
+			CreateMeshBuffers(chunkIndex, device);
+		}
+
+		// 指定したセクションのみ、メッシュ・GPU のバッファをメインスレッドで作り直す (生成が完了済みのチャンクのみ)
+		// 隣接チャンクの境界の写しと、そこから求める遮蔽の情報は、チャンクごとに1度だけ作って各セクションで使い回す
+		void RemeshSections(const Lattice2& chunkIndex, Chunk::SectionMask sectionMask, const Device& device)
+		{
+			chunks[chunkIndex.x][chunkIndex.y].RecreateSectionMeshes(meshes[chunkIndex.x][chunkIndex.y], sectionMask, meshingMode, CaptureNeighborBorders(chunkIndex));
+			Chunk::ForEachSection(sectionMask, [&](int sectionIndex)
+				{
+					ReleaseSectionBuffer(chunkIndex, sectionIndex);
+					CreateSectionBuffer(chunkIndex, sectionIndex, device);
+				});
+		}
+
+		// メッシュを作り直す. 生成が完了済みなら即座に (指定したセクションのみ)、メッシュの作成中なら完了後に (全セクション) 作り直す
+		// 生成が完了済みでも、隣接チャンクに装飾が書き込んでいる最中なら、後で (全セクション) 作り直す
+		void RequestRemesh(const Lattice2& chunkIndex, Chunk::SectionMask sectionMask, const Device& device)
+		{
+			const ChunkGenerationState state = generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire);
+			if (state == ChunkGenerationState::FinishedAll && !IsDecoratingAround(chunkIndex, 2))
+				RemeshSections(chunkIndex, sectionMask, device);
+			else if (state >= ChunkGenerationState::MeshingParallel)
+				remeshRequests[chunkIndex.x][chunkIndex.y] = true;
+			// メッシュの作成前なら、作成時に最新の境界を写し取るので何もしなくてよい
 		}
 
 		// 指定されたチャンクについて、描画するデータに値をコピーする
@@ -229,23 +806,431 @@ namespace ForiverEngine
 		{
 			const Lattice2 drawDataIndex = GetDrawDataIndex(chunkIndex);
 
-			drawVBVs[drawDataIndex.x][drawDataIndex.y] = vbvs[chunkIndex.x][chunkIndex.y];
-			drawIBVs[drawDataIndex.x][drawDataIndex.y] = ibvs[chunkIndex.x][chunkIndex.y];
-			drawMeshIndicesCounts[drawDataIndex.x][drawDataIndex.y] =
-				static_cast<int>(meshes[chunkIndex.x][chunkIndex.y].indices.size());
+			// GPU のバッファが出来るまでは描画しない (メッシュは別スレッドで作成中かもしれない)
+			const bool isReady = generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire) == ChunkGenerationState::FinishedAll;
+
+			drawVertexSlices[drawDataIndex.x][drawDataIndex.y] = vertexSlices[chunkIndex.x][chunkIndex.y];
+			for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+			{
+				const TerrainMesh& mesh = meshes[chunkIndex.x][chunkIndex.y][sectionIndex];
+				drawMeshIndicesCounts[drawDataIndex.x][drawDataIndex.y][sectionIndex] = isReady ? mesh.GetIndexCount() : 0;
+				drawFaceQuadOffsets[drawDataIndex.x][drawDataIndex.y][sectionIndex] = isReady ? mesh.faceQuadOffsets : TerrainMesh::FaceQuadOffsets{};
+			}
 		};
+		// 描画範囲内のチャンクなら、↑を行う
+		void CopyToDrawDataIfInRange(const Lattice2& chunkIndex)
+		{
+			if (MathUtils::IsInRange(chunkIndex.x, drawRangeInfo.rangeX.x, drawRangeInfo.rangeX.y + 1) &&
+				MathUtils::IsInRange(chunkIndex.y, drawRangeInfo.rangeZ.x, drawRangeInfo.rangeZ.y + 1))
+				CopyToDrawData(chunkIndex);
+		}
 
-		// 描画データの中から実際に描画するもののみを抽出し、1次元配列にパックする
-		template<typename T>
-		void PackDrawData(const Chunk::DrawChunksArray<T>& drawData, std::vector<T>& outPackedDrawData)
+		// メッシュの頂点を、全セクション分 GPU のバッファ (ページ) に詰める
+		void CreateMeshBuffers(const Lattice2& chunkIndex, const Device& device)
+		{
+			for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+				CreateSectionBuffer(chunkIndex, sectionIndex, device);
+		}
+		// 1セクション分の頂点を、GPU のバッファ (ページ) に詰める (面の無いセクションは詰めない)
+		void CreateSectionBuffer(const Lattice2& chunkIndex, int sectionIndex, const Device& device)
+		{
+			const TerrainMesh& mesh = meshes[chunkIndex.x][chunkIndex.y][sectionIndex];
+			vertexSlices[chunkIndex.x][chunkIndex.y][sectionIndex] = vertexArena.Allocate(device, mesh.vertices);
+		}
+
+		// 全チャンクで共有する、四角形のインデックスバッファを作成する (初回のみ)
+		void CreateQuadIndexBufferIfNeeded(const Device& device)
+		{
+			if (quadIndexBuffer)
+				return;
+
+			std::tie(quadIndexBuffer, quadIndexBufferView) =
+				D3D12Utils::CreateIndexBufferAndView(device, TerrainMesh::CreateQuadIndices(Chunk::MaxMeshQuadCount));
+		}
+
+		// GPU のバッファ (ページ) の区間を、全セクション分解放する
+		void ReleaseMeshBuffers(const Lattice2& chunkIndex)
+		{
+			for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+				ReleaseSectionBuffer(chunkIndex, sectionIndex);
+		}
+		// 1セクション分の GPU のバッファ (ページ) の区間を解放する
+		void ReleaseSectionBuffer(const Lattice2& chunkIndex, int sectionIndex)
+		{
+			vertexArena.Free(vertexSlices[chunkIndex.x][chunkIndex.y][sectionIndex]);
+		}
+
+		// 1チャンクが使っているメモリ量 [byte] を計算する (ブロックデータ, CPU のメッシュ, GPU のバッファ. 共有のインデックスバッファは含まない)
+		std::size_t CalculateChunkMemoryUsage(const Lattice2& chunkIndex) const
+		{
+			std::size_t usage = chunks[chunkIndex.x][chunkIndex.y].GetMemoryUsage();
+			for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+			{
+				usage += meshes[chunkIndex.x][chunkIndex.y][sectionIndex].vertices.capacity() * sizeof(VertexDataTerrain)
+					+ vertexArena.GetVertexCount(vertexSlices[chunkIndex.x][chunkIndex.y][sectionIndex]) * sizeof(VertexDataTerrain);
+			}
+			return usage;
+		}
+
+		// チャンク・メッシュの生成に使う VectorPool が、保持しているメモリ量 [byte] の合計
+		static std::size_t CalculatePooledMemoryUsage() noexcept
+		{
+			return VectorPool<std::uint64_t>::GetStats().retainedBytes
+				+ VectorPool<std::uint32_t>::GetStats().retainedBytes
+				+ VectorPool<int>::GetStats().retainedBytes
+				+ VectorPool<VertexDataTerrain>::GetStats().retainedBytes;
+		}
+
+		// チャンクのデータを全て解放し、未生成の状態に戻す
+		// 並列処理中のチャンクに対して呼んではいけない
+		void UnloadChunk(const Lattice2& chunkIndex)
+		{
+			// ブロック配列・メッシュの配列はプールに返る
+			chunks[chunkIndex.x][chunkIndex.y] = Chunk();
+			Chunk::ReleaseSectionMeshes(std::move(meshes[chunkIndex.x][chunkIndex.y]));
+			ReleaseMeshBuffers(chunkIndex);
+			remeshRequests[chunkIndex.x][chunkIndex.y] = false;
+
+			generationStates[chunkIndex.x][chunkIndex.y].store(ChunkGenerationState::NotYet, std::memory_order_release);
+		}
+
+		// 描画範囲の外側のチャンクについて、LOD のメッシュを作成・解放し、描画する LOD のグループ一覧を更新する
+		// 作成済みのレベルと違うレベルになったチャンクは、作り直す (描画範囲内に入ったら、解放する)
+		// チャンクが増減したグループのみ、まとめ直す
+		void UpdateLodChunks(const Lattice2& playerExistingChunkIndex, const Device& device)
+		{
+			const auto getLevel = [&](const Lattice2& chunkIndex)
+				{
+					const int distance = std::max(
+						std::abs(chunkIndex.x - playerExistingChunkIndex.x),
+						std::abs(chunkIndex.y - playerExistingChunkIndex.y));
+					return lodSettings.GetLevel(distance);
+				};
+
+			// レベルが変わったものを解放する
+			std::vector<Lattice2> releasedChunkIndices = {};
+			std::erase_if(lodChunkIndices,
+				[&](const Lattice2& chunkIndex)
+				{
+					if (getLevel(chunkIndex) == lodLevels[chunkIndex.x][chunkIndex.y])
+						return false;
+					ReleaseLodMesh(chunkIndex);
+					releasedChunkIndices.push_back(chunkIndex);
+					return true;
+				});
+
+			// LOD の範囲のチャンクを、未作成なら作成する
+			const int outerDistance = lodSettings.GetOuterDistance();
+			const int xMin = std::max(playerExistingChunkIndex.x - outerDistance, 0);
+			const int xMax = std::min(playerExistingChunkIndex.x + outerDistance, Chunk::Count - 1);
+			const int zMin = std::max(playerExistingChunkIndex.y - outerDistance, 0);
+			const int zMax = std::min(playerExistingChunkIndex.y + outerDistance, Chunk::Count - 1);
+			for (int xi = xMin; xi <= xMax; ++xi)
+				for (int zi = zMin; zi <= zMax; ++zi)
+				{
+					const int level = getLevel({ xi, zi });
+					if (level <= 0 || lodLevels[xi][zi] != 0)
+						continue;
+
+					CreateLodMesh({ xi, zi }, level);
+					lodChunkIndices.push_back({ xi, zi });
+				}
+
+			for (const int groupIndex : dirtyLodGroupIndices)
+				MergeLodGroup(groupIndex, device);
+			dirtyLodGroupIndices.clear();
+
+			ReleaseUnusedLodRegions(releasedChunkIndices);
+
+			// 面のあるグループを描画する
+			drawLodGroupIndices.clear();
+			drawLodChunkCount = 0;
+			for (int groupIndex = 0; groupIndex < static_cast<int>(lodGroups.size()); ++groupIndex)
+			{
+				if (lodGroups[groupIndex].chunkCount <= 0)
+					continue;
+				drawLodGroupIndices.push_back(groupIndex);
+				drawLodChunkCount += lodGroups[groupIndex].chunkCount;
+			}
+		}
+
+		// チャンクを含むリージョンの、LOD レベル level のグループのインデックス
+		static int GetLodGroupIndex(const Lattice2& chunkIndex, int level) noexcept
+		{
+			const int regionIndex = chunkIndex.x / Chunk::RegionSize * RegionCount + chunkIndex.y / Chunk::RegionSize;
+			return regionIndex * ChunkLodSettings::LevelCount + (level - 1);
+		}
+
+		// グループを、まとめ直す対象にする
+		void MarkLodGroupDirty(const Lattice2& chunkIndex, int level)
+		{
+			const int groupIndex = GetLodGroupIndex(chunkIndex, level);
+			if (lodGroups[groupIndex].isDirty)
+				return;
+			lodGroups[groupIndex].isDirty = true;
+			dirtyLodGroupIndices.push_back(groupIndex);
+		}
+
+		// LOD のメッシュを作成する (GPU には、グループをまとめ直す時に送る)
+		// ブロックが確定済みなら (編集されているかもしれないので) その地表から、そうでなければノイズから直接地表を求める
+		// (確定前のチャンクは、装飾の並列処理に書き込まれているかもしれない)
+		void CreateLodMesh(const Lattice2& chunkIndex, int level)
+		{
+			const Chunk::SurfaceMap surfaceMap = HasFinalBlocks(chunkIndex)
+				? chunks[chunkIndex.x][chunkIndex.y].CreateSurfaceMap()
+				: CreateTerrainSurfaceMap(chunkIndex);
+
+			lodLevels[chunkIndex.x][chunkIndex.y] = static_cast<std::int8_t>(level);
+			lodMeshes[chunkIndex.x][chunkIndex.y] = Chunk::CreateLodMesh(surfaceMap, level);
+			MarkLodGroupDirty(chunkIndex, level);
+		}
+
+		// LOD のメッシュを解放する (GPU からは、グループをまとめ直す時に消える)
+		void ReleaseLodMesh(const Lattice2& chunkIndex)
+		{
+			MarkLodGroupDirty(chunkIndex, lodLevels[chunkIndex.x][chunkIndex.y]);
+			Chunk::ReleaseMesh(std::move(lodMeshes[chunkIndex.x][chunkIndex.y]));
+			lodLevels[chunkIndex.x][chunkIndex.y] = 0;
+		}
+
+		// グループ (リージョン内の、同じレベルのチャンク) の LOD のメッシュを1つにまとめ直し、GPU に送る
+		void MergeLodGroup(int groupIndex, const Device& device)
+		{
+			LodGroup& group = lodGroups[groupIndex];
+			const Chunk::ChunksArray<std::int8_t>& levels = lodLevels;
+			const Chunk::ChunksArray<TerrainMesh>& meshesOfLod = lodMeshes;
+
+			std::vector<const TerrainMesh*> groupMeshes = {};
+			std::vector<Lattice2> chunkOffsets = {};
+			group.chunkIndexMin = Lattice2(Chunk::Count, Chunk::Count);
+			group.chunkIndexMax = Lattice2(-1, -1);
+			for (int xi = group.regionOrigin.x; xi < std::min(group.regionOrigin.x + Chunk::RegionSize, Chunk::Count); ++xi)
+				for (int zi = group.regionOrigin.y; zi < std::min(group.regionOrigin.y + Chunk::RegionSize, Chunk::Count); ++zi)
+				{
+					if (levels[xi][zi] != group.level || meshesOfLod[xi][zi].vertices.empty())
+						continue;
+
+					groupMeshes.push_back(&meshesOfLod[xi][zi]);
+					chunkOffsets.push_back(Lattice2(xi, zi) - group.regionOrigin);
+					group.chunkIndexMin = Lattice2(std::min(group.chunkIndexMin.x, xi), std::min(group.chunkIndexMin.y, zi));
+					group.chunkIndexMax = Lattice2(std::max(group.chunkIndexMax.x, xi), std::max(group.chunkIndexMax.y, zi));
+				}
+
+			TerrainMesh merged = Chunk::MergeLodMeshes(groupMeshes, chunkOffsets);
+
+			// 古い頂点は、もう使わないので解放する (フレームごとに GPU の完了を待っているので、使用中ではない)
+			vertexArena.Free(group.slice);
+			group.slice = vertexArena.Allocate(device, merged.vertices);
+			group.faceQuadOffsets = merged.faceQuadOffsets;
+			group.chunkCount = static_cast<int>(groupMeshes.size());
+			group.isDirty = false;
+			Chunk::ReleaseMesh(std::move(merged));
+		}
+
+		// LOD のメッシュを解放したチャンクを含むリージョンについて、リージョン内に LOD のメッシュが無ければ、LOD のデータのメモリを解放する
+		// (まとめ直した後に呼ぶこと. グループは、まとめ直しで空になっている)
+		void ReleaseUnusedLodRegions(const std::vector<Lattice2>& releasedChunkIndices)
+		{
+			for (const Lattice2& regionOrigin : GetRegionOrigins(releasedChunkIndices))
+			{
+				const Chunk::ChunksArray<std::int8_t>& levels = lodLevels;
+
+				bool isUnused = true;
+				for (int xi = regionOrigin.x; isUnused && xi < std::min(regionOrigin.x + Chunk::RegionSize, Chunk::Count); ++xi)
+					for (int zi = regionOrigin.y; isUnused && zi < std::min(regionOrigin.y + Chunk::RegionSize, Chunk::Count); ++zi)
+					{
+						if (levels[xi][zi] != 0)
+							isUnused = false;
+					}
+				if (!isUnused)
+					continue;
+
+				lodLevels.ReleasePage(regionOrigin.x, regionOrigin.y);
+				lodMeshes.ReleasePage(regionOrigin.x, regionOrigin.y);
+				ReleaseTerrainHeightsIfUnused(regionOrigin);
+			}
+		}
+
+		// チャンクを含むリージョンの原点 (重複なし)
+		static std::vector<Lattice2> GetRegionOrigins(const std::vector<Lattice2>& chunkIndices)
+		{
+			std::vector<Lattice2> regionOrigins = {};
+			for (const Lattice2& chunkIndex : chunkIndices)
+			{
+				const Lattice2 regionOrigin = Lattice2(
+					chunkIndex.x / Chunk::RegionSize * Chunk::RegionSize,
+					chunkIndex.y / Chunk::RegionSize * Chunk::RegionSize);
+				if (std::find(regionOrigins.begin(), regionOrigins.end(), regionOrigin) == regionOrigins.end())
+					regionOrigins.push_back(regionOrigin);
+			}
+			return regionOrigins;
+		}
+
+		// メモリ量が上限を超えていたら、描画範囲から十分離れたチャンクを、最後に使った時刻が古い順にアンロードする (LRU)
+		void UnloadChunksOverBudget(const Lattice2& playerExistingChunkIndex)
+		{
+			// プールが保持している分も数える (アンロードしたチャンクの配列は、プールの上限までプールに戻る)
+			std::size_t memoryUsage = CalculatePooledMemoryUsage();
+			std::vector<Lattice2> candidates = {};
+			for (const Lattice2& chunkIndex : loadedChunkIndices)
+			{
+				// 並列処理中のチャンク・周囲の装飾で書き込まれうるチャンクには触らない
+				if (IsTouchedByParallel(chunkIndex))
+					continue;
+
+				memoryUsage += CalculateChunkMemoryUsage(chunkIndex);
+
+				// すぐに戻ってきた時に再生成しないよう、描画範囲より UnloadMargin だけ広く残しておく
+				const int distance = std::max(
+					std::abs(chunkIndex.x - playerExistingChunkIndex.x),
+					std::abs(chunkIndex.y - playerExistingChunkIndex.y));
+				if (distance > Chunk::DrawDistance + UnloadMargin)
+					candidates.push_back(chunkIndex);
+			}
+
+			if (memoryUsage <= memoryBudget)
+				return;
+
+			std::sort(candidates.begin(), candidates.end(),
+				[this](const Lattice2& a, const Lattice2& b)
+				{
+					return lastUsedTimes[a.x][a.y] < lastUsedTimes[b.x][b.y];
+				});
+
+			std::vector<Lattice2> unloadedChunkIndices = {};
+			for (const Lattice2& chunkIndex : candidates)
+			{
+				if (memoryUsage <= memoryBudget)
+					break;
+
+				memoryUsage -= CalculateChunkMemoryUsage(chunkIndex);
+				UnloadChunk(chunkIndex);
+				unloadedChunkIndices.push_back(chunkIndex);
+			}
+
+			std::erase_if(loadedChunkIndices,
+				[this](const Lattice2& chunkIndex)
+				{
+					return generationStates[chunkIndex.x][chunkIndex.y].load(std::memory_order_acquire) == ChunkGenerationState::NotYet;
+				});
+
+			ReleaseUnusedRegions(unloadedChunkIndices);
+		}
+
+		// アンロードしたチャンクを含むリージョンについて、リージョン内の全チャンクが未生成ならば、そのリージョンのメモリを解放する
+		void ReleaseUnusedRegions(const std::vector<Lattice2>& unloadedChunkIndices)
+		{
+			for (const Lattice2& regionOrigin : GetRegionOrigins(unloadedChunkIndices))
+			{
+				const Chunk::ChunksArray<std::atomic<ChunkGenerationState>>& states = generationStates;
+
+				bool isUnused = true;
+				for (int xi = regionOrigin.x; isUnused && xi < std::min(regionOrigin.x + Chunk::RegionSize, Chunk::Count); ++xi)
+					for (int zi = regionOrigin.y; isUnused && zi < std::min(regionOrigin.y + Chunk::RegionSize, Chunk::Count); ++zi)
+					{
+						if (states[xi][zi].load(std::memory_order_acquire) != ChunkGenerationState::NotYet)
+							isUnused = false;
+					}
+				if (!isUnused)
+					continue;
+
+				generationStates.ReleasePage(regionOrigin.x, regionOrigin.y);
+				chunks.ReleasePage(regionOrigin.x, regionOrigin.y);
+				meshes.ReleasePage(regionOrigin.x, regionOrigin.y);
+				vertexSlices.ReleasePage(regionOrigin.x, regionOrigin.y);
+				lastUsedTimes.ReleasePage(regionOrigin.x, regionOrigin.y);
+				remeshRequests.ReleasePage(regionOrigin.x, regionOrigin.y);
+				ReleaseTerrainHeightsIfUnused(regionOrigin);
+			}
+		}
+
+		// リージョン内に、生成中・生成済みのチャンクも LOD のメッシュも無ければ、各列の高さのキャッシュを解放する
+		// (チャンクの状態のページが無ければ、そのリージョンのチャンクを生成しているスレッドは無い)
+		void ReleaseTerrainHeightsIfUnused(const Lattice2& regionOrigin)
+		{
+			if (generationStates.IsAllocated(regionOrigin.x, regionOrigin.y) || lodLevels.IsAllocated(regionOrigin.x, regionOrigin.y))
+				return;
+
+			terrainGenerator.ReleaseRegion(regionOrigin);
+		}
+
+		// 描画データの中から実際に描画するもの (面のあるセクション, LOD のグループ) のうち、culling で見えうる向きの面の範囲を列挙する
+		// func(チャンクのインデックス, 描画データのインデックス, セクションのインデックス, 最初の四角形, 四角形の数), lodFunc(LOD のグループ, 最初の四角形, 四角形の数) を呼ぶ
+		template<typename TFunc, typename TLodFunc>
+		void ForEachDrawRange(const TerrainFaceCulling& culling, const TFunc& func, const TLodFunc& lodFunc) const
 		{
-			outPackedDrawData.clear();
 			for (int xi = drawRangeInfo.rangeX.x; xi <= drawRangeInfo.rangeX.y; ++xi)
 				for (int zi = drawRangeInfo.rangeZ.x; zi <= drawRangeInfo.rangeZ.y; ++zi)
 				{
 					const Lattice2 drawDataIndex = GetDrawDataIndex({ xi, zi });
-					outPackedDrawData.push_back(drawData[drawDataIndex.x][drawDataIndex.y]);
+					for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+					{
+						if (drawMeshIndicesCounts[drawDataIndex.x][drawDataIndex.y][sectionIndex] <= 0)
+							continue;
+
+						const std::uint32_t visibleFaceBits = culling.CalculateVisibleFaceBits(
+							GetBoundsWorldMin({ xi, zi }, sectionIndex * Chunk::SectionHeight),
+							GetBoundsWorldMax({ xi, zi }, (sectionIndex + 1) * Chunk::SectionHeight));
+						TerrainMesh::ForEachFaceRange(drawFaceQuadOffsets[drawDataIndex.x][drawDataIndex.y][sectionIndex], visibleFaceBits,
+							[&](int firstQuad, int quadCount) { func(Lattice2(xi, zi), drawDataIndex, sectionIndex, firstQuad, quadCount); });
+					}
 				}
+
+			for (const int groupIndex : drawLodGroupIndices)
+			{
+				const LodGroup& group = lodGroups[groupIndex];
+				const std::uint32_t visibleFaceBits = culling.CalculateVisibleFaceBits(
+					GetBoundsWorldMin(group.chunkIndexMin, 0), GetBoundsWorldMax(group.chunkIndexMax, Chunk::Height));
+				TerrainMesh::ForEachFaceRange(group.faceQuadOffsets, visibleFaceBits,
+					[&](int firstQuad, int quadCount) { lodFunc(group, firstQuad, quadCount); });
+			}
+		}
+
+		// チャンク内の格子点の Y座標 [minY, maxY] の範囲の、ワールド座標の範囲 (頂点の位置は TerrainVertex::CalculateWorldPosition() と同じ)
+		static Vector3 GetBoundsWorldMin(const Lattice2& chunkIndex, int minY) noexcept
+		{
+			return Chunk::GetOriginWorldPosition(chunkIndex) + Vector3(0, minY, 0) - Vector3::One() * 0.5f;
+		}
+		static Vector3 GetBoundsWorldMax(const Lattice2& chunkIndex, int maxY) noexcept
+		{
+			return Chunk::GetOriginWorldPosition(chunkIndex) + Vector3(Chunk::Size, maxY, Chunk::Size) - Vector3::One() * 0.5f;
+		}
+
+		// vertexArena の区間のうち、[firstQuad, firstQuad + quadCount) の四角形を描画するドローコールを追加する (インデックスは共有のものを先頭から使う)
+		// chunkIndex : 頂点の座標の原点のチャンク (LOD のグループは、リージョンの原点)
+		// 共有のインデックスバッファより多い四角形 (LOD のグループのみ) は、ドローコールを分ける
+		// 直前のドローコールと同じページ・同じチャンクで、頂点バッファ上で続いているならまとめる
+		// 同じメッシュ (同じ区間) の中なら、間に挟まる見えない向きの範囲ごとまとめる (裏を向くので、パイプラインの裏面カリングで捨てられる)
+		void PushPackedDraw(const VertexSlice& slice, const Lattice2& chunkIndex, int firstQuad, int quadCount)
+		{
+			const int sliceFirstVertex = vertexArena.GetFirstVertex(slice);
+			const int baseVertex = sliceFirstVertex + firstQuad * TerrainMesh::VerticesPerQuad;
+			if (!packedDraws.empty())
+			{
+				PackedDraw& last = packedDraws.back();
+				const int lastEndVertex = last.baseVertex + last.quadCount * TerrainMesh::VerticesPerQuad;
+				const bool isContinuous = (baseVertex == lastEndVertex)
+					|| (baseVertex > lastEndVertex && sliceFirstVertex == last.sliceFirstVertex);
+				const int mergedQuadCount = (baseVertex - last.baseVertex) / TerrainMesh::VerticesPerQuad + quadCount;
+				if (last.page == slice.page && last.chunkIndex == chunkIndex && isContinuous && mergedQuadCount <= Chunk::MaxMeshQuadCount)
+				{
+					last.quadCount = mergedQuadCount;
+					last.sliceFirstVertex = sliceFirstVertex;
+					return;
+				}
+			}
+
+			for (int quadOffset = 0; quadOffset < quadCount; quadOffset += Chunk::MaxMeshQuadCount)
+			{
+				packedDraws.push_back(PackedDraw
+					{
+						.page = slice.page,
+						.baseVertex = baseVertex + quadOffset * TerrainMesh::VerticesPerQuad,
+						.quadCount = std::min(quadCount - quadOffset, Chunk::MaxMeshQuadCount),
+						.chunkIndex = chunkIndex,
+						.sliceFirstVertex = sliceFirstVertex,
+					});
+			}
 		}
 	};
 }
@@ -76,14 +76,45 @@ namespace ForiverEngine
 				return "Chunk Local Position : Invalid";
 		}
 
+		static std::string ChunkMemory(const PlayerController& playerController, const ChunksManager& chunksManager)
+		{
+			const Lattice3 blockPosition = playerController.GetFootBlockPosition();
+			const Lattice2 chunkIndex = Chunk::GetIndex(blockPosition);
+
+			if (Chunk::IsValidIndex(chunkIndex))
+			{
+				const Chunk& chunk = chunksManager.GetChunks()[chunkIndex.x][chunkIndex.y];
+				return std::format(
+					"Chunk Memory : {:.1f} KiB ({:.2f} bit/block)",
+					chunk.GetMemoryUsage() / 1024.0,
+					chunk.GetBitsPerBlock()
+				);
+			}
+			else
+				return "Chunk Memory : Invalid";
+		}
+
+		static std::string LoadedChunks(const ChunksManager& chunksManager)
+		{
+			return std::format(
+				"Loaded Chunks : {} ({:.1f} MiB / {:.1f} MiB)",
+				chunksManager.GetLoadedChunkCount(),
+				chunksManager.CalculateLoadedMemoryUsage() / (1024.0 * 1024.0),
+				chunksManager.GetMemoryBudget() / (1024.0 * 1024.0)
+			);
+		}
+
 		static std::string DrawChunksRange(const ChunksManager& chunksManager)
 		{
 			const auto& drawRangeInfo = chunksManager.GetDrawRangeInfo();
 
 			return std::format(
-				"Drawing Chunks : {}-{}",
+				"Drawing Chunks : {}-{} (LOD {} chunks in {} groups, radius {})",
 				ToString(drawRangeInfo.GetRangeMin()),
-				ToString(drawRangeInfo.GetRangeMax())
+				ToString(drawRangeInfo.GetRangeMax()),
+				chunksManager.GetDrawLodChunkCount(),
+				chunksManager.GetDrawLodGroupCount(),
+				chunksManager.GetLodSettings().GetOuterDistance()
 			);
 		}
 
@@ -48,6 +48,8 @@ namespace ForiverEngine
 			rowDatas.emplace_back(DebugText::DrawChunksRange(chunksManager), TextColor);                   // 5
 			rowDatas.emplace_back(DebugText::CollisionRange(playerController), TextColor);                 // 6
 			rowDatas.emplace_back(DebugText::FloorCeilHeight(playerController, chunksManager), TextColor); // 7
+			rowDatas.emplace_back(DebugText::ChunkMemory(playerController, chunksManager), TextColor);     // 8
+			rowDatas.emplace_back(DebugText::LoadedChunks(chunksManager), TextColor);                      // 9
 
 			textRenderer.data.ClearAll();
 			for (int i = 0; i < static_cast<int>(rowDatas.size()); ++i)
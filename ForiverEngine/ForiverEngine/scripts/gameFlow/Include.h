@@ -3,7 +3,9 @@
 #include "./TrackedValue.h"
 #include "./Timer.h"
 #include "./Renderer/Include.h"
+#include "./Block.h"
 #include "./Chunk.h"
+#include "./TerrainGenerator.h"
 #include "./ChunksManager.h"
 #include "./PlayerControl.h"
 #include "./PlayerController.h"
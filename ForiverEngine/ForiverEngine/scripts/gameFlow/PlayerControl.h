@@ -404,13 +404,13 @@ namespace ForiverEngine
 						return false;
 					const Chunk& chunk = chunks[chunkIndex.x][chunkIndex.y];
 
+					// 列ごとに、Y方向の範囲を占有ビットマスクでまとめて判定する
 					for (int x = rangeX.x; x <= rangeX.y; ++x)
-						for (int y = rangeY.x; y <= rangeY.y; ++y)
-							for (int z = rangeZ.x; z <= rangeZ.y; ++z)
-							{
-								if (chunk.GetBlock({ x, y, z }) != Block::Air)
-									return true;
-							}
+						for (int z = rangeZ.x; z <= rangeZ.y; ++z)
+						{
+							if (chunk.IsAnyInColumn({ x, z }, rangeY.x, rangeY.y, OccupancyKind::Collidable))
+								return true;
+						}
 
 					return false;
 				};
@@ -81,6 +81,12 @@ namespace ForiverEngine
 			return PlayerControl::GetFootPosition(transform.position, EyeHeight);
 		}
 
+		// カメラ (目) の位置
+		Vector3 GetEyePosition() const noexcept
+		{
+			return transform.position;
+		}
+
 		Lattice3 GetFootBlockPosition() const noexcept
 		{
 			return PlayerControl::GetBlockPosition(GetFootPosition());
@@ -274,7 +280,7 @@ namespace ForiverEngine
 				const Lattice3 rayLocalPosition = Chunk::GetLocalBlockPosition(rayBlockPosition);
 				const Block blockAtRay = targetingChunk.GetBlock(rayLocalPosition);
 
-				if (blockAtRay != Block::Air)
+				if (BlockProperties::IsSolid(blockAtRay))
 				{
 					// フェースの法線を計算する
 					// ブロック中心->レイヒット位置, フェース法線との内積を計算し、最も大きい(ベクトルが一致している)ものを採用する
@@ -307,8 +313,8 @@ namespace ForiverEngine
 								const Lattice3 adjacentLocalPosition = Chunk::GetLocalBlockPosition(adjacentBlockPosition);
 								const Block adjacentBlock = adjacentChunk.GetBlock(adjacentLocalPosition);
 
-								if (adjacentBlock != Block::Air)
-									continue; // 隣接ブロックがあるなら無視
+								if (BlockProperties::IsOpaque(adjacentBlock))
+									continue; // 隣接ブロックに遮られているなら無視
 							}
 						}
 
@@ -354,13 +360,13 @@ namespace ForiverEngine
 			const Lattice3 localBlockPosition = Chunk::GetLocalBlockPosition(worldBlockPosition);
 
 			// ブロックが無いならダメ (一応)
-			if (chunksManager.GetChunkBlock(chunkIndex, localBlockPosition) == Block::Air)
+			if (!BlockProperties::IsSolid(chunksManager.GetChunkBlock(chunkIndex, localBlockPosition)))
 				return false;
 
-			const Lattice2 playerExistingChunkIndex = Chunk::GetIndex(GetFootBlockPosition());
-
-			chunksManager.UpdateChunkBlock(chunkIndex, localBlockPosition, Block::Air, device);
-			chunksManager.UpdateDrawChunks(playerExistingChunkIndex, true, device);
+			// 生成途中のチャンクなら、ダメ
+			// (描画データへの反映も、UpdateChunkBlock() が行う)
+			if (!chunksManager.UpdateChunkBlock(chunkIndex, localBlockPosition, Block::Air, device))
+				return false;
 
 			return true;
 		}
@@ -386,17 +392,17 @@ namespace ForiverEngine
 			const Lattice3 localBlockPosition = Chunk::GetLocalBlockPosition(worldBlockPosition);
 
 			// 既にブロックがあるならダメ (一応)
-			if (chunksManager.GetChunkBlock(chunkIndex, localBlockPosition) != Block::Air)
+			if (BlockProperties::IsSolid(chunksManager.GetChunkBlock(chunkIndex, localBlockPosition)))
 				return false;
 
 			// 自身の当たり判定が被っているならダメ
 			if (IsOverlappingWithBlock(chunksManager.GetChunks(), worldBlockPosition))
 				return false;
 
-			const Lattice2 playerExistingChunkIndex = Chunk::GetIndex(GetFootBlockPosition());
-
-			chunksManager.UpdateChunkBlock(chunkIndex, localBlockPosition, Block::Stone, device);
-			chunksManager.UpdateDrawChunks(playerExistingChunkIndex, true, device);
+			// 生成途中のチャンクなら、ダメ
+			// (描画データへの反映も、UpdateChunkBlock() が行う)
+			if (!chunksManager.UpdateChunkBlock(chunkIndex, localBlockPosition, Block::Stone, device))
+				return false;
 
 			return true;
 		}
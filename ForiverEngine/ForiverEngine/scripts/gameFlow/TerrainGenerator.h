@@ -0,0 +1,539 @@
+﻿#pragma once
+
+#include <scripts/common/Include.h>
+#include <scripts/helper/Include.h>
+#include <scripts/component/Include.h>
+#include "./Chunk.h"
+
+namespace ForiverEngine
+{
+	/// <summary>
+	/// <para>TerrainGenerator の地形の設定</para>
+	/// <para>各列の高さは、複数オクターブのノイズの和 (fBm) を、ドメインワープで歪め、カーブで整形して求める</para>
+	/// <para>さらに 3D のノイズ (密度) で、地表を盛る/削り (オーバーハング・浮島)、地中をくり抜く (洞窟)</para>
+	/// <para>最後に、チャンクの境界をまたぐ地物 (岩) を置く (装飾. TerrainGenerator::Decorate())</para>
+	/// </summary>
+	struct TerrainGenerationSettings
+	{
+		float horizontalScale = 0.015f;  // 最初のオクターブの水平スケール (ブロック座標に掛ける)
+		int octaveCount = 1;             // オクターブ数 (1 以上)
+		float lacunarity = 2.0f;         // オクターブごとの周波数の倍率
+		float persistence = 0.5f;        // オクターブごとの振幅の倍率
+
+		float warpStrength = 0.0f;       // ドメインワープで座標をずらす最大量 [ブロック] (0 なら歪めない)
+		float warpScale = 0.005f;        // ドメインワープのノイズの水平スケール
+
+		int heightBulk = 16;             // この高さ分かさ増しする
+		float heightAmplitude = 12.0f;   // ノイズ [0, 1] に掛ける高さ
+		// 正規化したノイズ [0, 1] を [0, 1] に写すカーブ (区間を等分した点の値. 区分線形で補間する)
+		// 2点未満なら、そのまま使う
+		std::vector<float> heightCurve = {};
+
+		int minDirtHeight = 18;          // 土が出てくる最低高度
+		int minStoneHeight = 24;         // 石が出てくる最低高度
+		std::uint32_t seed = Chunk::DefaultCreationSeed;
+
+		// 3D の密度は、粗い格子の点でのみノイズを求め、ブロック単位には3線形補間する
+		// 格子の間隔 [ブロック] (x, z は Chunk::Size の約数). 大きいほど安く、形は滑らかになる
+		Lattice3 densityStride = Lattice3(4, 8, 4);
+		float overhangAmplitude = 0.0f;  // 地表を、最大この高さ [ブロック] だけ 3D ノイズで盛る/削る (オーバーハング・浮島. 0 なら盛り削りしない)
+		float overhangScale = 0.03f;     // そのノイズのスケール
+		float caveThreshold = 1.0f;      // 洞窟のノイズがこれを超えたマスをくり抜く (1 以上なら洞窟を作らない)
+		float caveScale = 0.05f;         // 洞窟のノイズのスケール
+		int caveMinDepth = 3;            // 地表からこの深さまでは、くり抜かない
+		int caveMinHeight = 1;           // この高度より下は、くり抜かない (ワールドの底を塞ぐ)
+
+		// 装飾: 地表に岩 (石の球) を置く. 中心はチャンク内の列だが、球は隣接チャンクにはみ出してよい
+		int boulderAttemptCount = 0;     // 1チャンクあたりの、岩を置く候補の数 (0 なら置かない)
+		float boulderChance = 0.5f;      // 候補ごとに、岩を置く確率
+		int boulderMinRadius = 1;        // 岩の半径 [ブロック]
+		int boulderMaxRadius = 3;        // (Chunk::Size 未満. 隣接チャンクの、向こう側の境界には届かないように)
+
+		/// <summary>
+		/// 3D の密度を使うか (使わないなら、各列の高さだけで地形が決まる)
+		/// </summary>
+		bool HasDensity() const noexcept
+		{
+			return overhangAmplitude > 0.0f || caveThreshold < 1.0f;
+		}
+
+		/// <summary>
+		/// 装飾 (岩) を置くか
+		/// </summary>
+		bool HasDecoration() const noexcept
+		{
+			return boulderAttemptCount > 0 && boulderChance > 0.0f;
+		}
+
+		/// <summary>
+		/// 1オクターブの、Chunk::CreateFromNoise() と同じ地形になる設定
+		/// </summary>
+		static TerrainGenerationSettings CreateSingleOctave()
+		{
+			return TerrainGenerationSettings{};
+		}
+
+		/// <summary>
+		/// <para>複数オクターブの、起伏に富んだ地形になる設定 (ゲームでのデフォルト)</para>
+		/// <para>低地はなだらかな砂浜・草原に、高地は石の山になる</para>
+		/// </summary>
+		static TerrainGenerationSettings CreateFractal()
+		{
+			TerrainGenerationSettings settings = {};
+			settings.horizontalScale = 0.006f;
+			settings.octaveCount = 5;
+			settings.warpStrength = 24.0f;
+			settings.warpScale = 0.004f;
+			settings.heightBulk = 12;
+			settings.heightAmplitude = 56.0f;
+			settings.heightCurve = { 0.0f, 0.12f, 0.22f, 0.4f, 0.68f, 1.0f };
+			settings.minDirtHeight = 20;
+			settings.minStoneHeight = 44;
+			settings.overhangAmplitude = 6.0f;
+			settings.caveThreshold = 0.55f;
+			settings.boulderAttemptCount = 2;
+			settings.boulderChance = 0.35f;
+			return settings;
+		}
+	};
+
+	/// <summary>
+	/// <para>設定 (TerrainGenerationSettings) に従って、チャンクの地形を生成する</para>
+	/// <para>各列の高さは、リージョン (Chunk::RegionSize x Chunk::RegionSize 個のチャンク) 単位のタイルにキャッシュし、地形と LOD の地表で共有する</para>
+	/// <para>タイルはチャンク単位で、初めて必要になった時に埋める. 異なるスレッドから同時に呼んでよい</para>
+	/// <para>3D の密度 (洞窟など) はチャンクの生成時にのみ求め、キャッシュしない. LOD の地表は、各列の高さのみから作る</para>
+	/// <para>装飾 (岩) は、周囲のチャンクの地形が揃ってから Decorate() で別に置く (CreateChunk() では置かない)</para>
+	/// </summary>
+	class TerrainGenerator
+	{
+	public:
+		// チャンクとその周囲 3x3 のチャンク (インデックスは GetNeighborhoodIndex(). 無いなら nullptr)
+		using Neighborhood = std::array<Chunk*, 9>;
+
+		// 岩 1つ分の配置
+		struct Boulder
+		{
+			Lattice3 center; // 中心のブロック (置くチャンクの原点からの相対座標)
+			int radius;
+		};
+
+		TerrainGenerator() = default;
+
+		explicit TerrainGenerator(const TerrainGenerationSettings& settings)
+			: settings(settings)
+		{
+			cachedHeights = Chunk::CreateChunksArray<CachedHeights>();
+		}
+
+		const TerrainGenerationSettings& GetSettings() const noexcept { return settings; }
+
+		/// <summary>
+		/// チャンクの地形を生成する
+		/// </summary>
+		Chunk CreateChunk(const Lattice2& chunkIndex)
+		{
+			const Chunk::ColumnHeights heights = GetColumnHeights(chunkIndex);
+			if (!settings.HasDensity())
+				return Chunk::CreateFromHeights(heights, settings.minDirtHeight, settings.minStoneHeight);
+
+			return Chunk::CreateFromColumnMasks(CalculateColumnMasks(settings, chunkIndex, heights), settings.minDirtHeight, settings.minStoneHeight);
+		}
+
+		/// <summary>
+		/// <para>CreateChunk() で生成される地形の、地表のみを求める (ブロック配列は作らない)</para>
+		/// <para>3D の密度を使わないなら、生成したチャンクの CreateSurfaceMap() と一致する (使うなら、近似になる)</para>
+		/// </summary>
+		Chunk::SurfaceMap CreateSurfaceMap(const Lattice2& chunkIndex)
+		{
+			return Chunk::CreateSurfaceMapFromHeights(GetColumnHeights(chunkIndex), settings.minDirtHeight, settings.minStoneHeight);
+		}
+
+		/// <summary>
+		/// <para>sourceChunkIndex のチャンクの装飾 (岩) を、targets のチャンクのうち、はみ出した部分も含めて重なる範囲に書き込む</para>
+		/// <para>配置はシード値・各列の高さ (キャッシュ) のみで決まり、ブロック配列は読まない. 何度・どの順に書き込んでも、結果は同じ</para>
+		/// <para>targets のチャンクを、他のスレッドが同時に読み書きしないことを、呼び出し側で保証すること</para>
+		/// </summary>
+		/// <param name="targets">sourceChunkIndex を中心とした 3x3 のチャンク. nullptr のチャンクには書き込まない</param>
+		void Decorate(const Lattice2& sourceChunkIndex, const Neighborhood& targets)
+		{
+			for (const Boulder& boulder : CalculateBoulders(sourceChunkIndex))
+				for (int dx = -1; dx <= 1; ++dx)
+					for (int dz = -1; dz <= 1; ++dz)
+					{
+						if (Chunk* const target = targets[GetNeighborhoodIndex({ dx, dz })])
+							PlaceBoulder(*target, boulder, Lattice2(dx, dz));
+					}
+		}
+
+		/// <summary>
+		/// <para>チャンクに置く岩の一覧を求める</para>
+		/// <para>候補の列はシード値とチャンクのインデックスから決め、砂浜 (土が出てくる高度より下) には置かない</para>
+		/// </summary>
+		std::vector<Boulder> CalculateBoulders(const Lattice2& chunkIndex)
+		{
+			if (!settings.HasDecoration())
+				return {};
+			assert(0 < settings.boulderMinRadius && settings.boulderMinRadius <= settings.boulderMaxRadius && settings.boulderMaxRadius < Chunk::Size
+				&& "岩の半径は [1, Chunk::Size) である必要がある");
+
+			const Chunk::ColumnHeights heights = GetColumnHeights(chunkIndex);
+			std::vector<Boulder> boulders = {};
+			for (int i = 0; i < settings.boulderAttemptCount; ++i)
+			{
+				// 下位ビットから順に、列の x, z・半径・置くか を決める
+				const std::uint32_t hash = HashChunkIndex(settings.seed, chunkIndex, i);
+				const int x = static_cast<int>(hash % Chunk::Size);
+				const int z = static_cast<int>(hash / Chunk::Size % Chunk::Size);
+				const int radius = settings.boulderMinRadius
+					+ static_cast<int>((hash >> 8) % static_cast<std::uint32_t>(settings.boulderMaxRadius - settings.boulderMinRadius + 1));
+				if (static_cast<float>(hash >> 16) >= settings.boulderChance * 65536.0f)
+					continue;
+
+				const int height = heights[x * Chunk::Size + z];
+				if (height < settings.minDirtHeight)
+					continue;
+
+				// 下半分は地面に埋める
+				boulders.push_back(Boulder{ .center = Lattice3(x, height, z), .radius = radius });
+			}
+			return boulders;
+		}
+
+		/// <summary>
+		/// Neighborhood の、中心からのチャンクの差 offset (各成分 [-1, 1]) のインデックス
+		/// </summary>
+		static constexpr int GetNeighborhoodIndex(const Lattice2& offset) noexcept
+		{
+			return (offset.x + 1) * 3 + (offset.y + 1);
+		}
+
+		/// <summary>
+		/// <para>チャンクの各列の地表の高さを取得する (キャッシュに無ければ求めて、キャッシュする)</para>
+		/// <para>他のスレッドが同じチャンクを求めている最中なら、待たずに自分でも求める (結果は同じ)</para>
+		/// </summary>
+		Chunk::ColumnHeights GetColumnHeights(const Lattice2& chunkIndex)
+		{
+			CachedHeights& cached = cachedHeights[chunkIndex.x][chunkIndex.y];
+
+			std::uint8_t state = cached.state.load(std::memory_order_acquire);
+			if (state == CachedHeights::Ready)
+				return cached.heights;
+
+			if (state == CachedHeights::Empty
+				&& cached.state.compare_exchange_strong(state, CachedHeights::Writing, std::memory_order_acquire, std::memory_order_acquire))
+			{
+				cached.heights = CalculateColumnHeights(settings, chunkIndex);
+				cached.state.store(CachedHeights::Ready, std::memory_order_release);
+				return cached.heights;
+			}
+
+			return CalculateColumnHeights(settings, chunkIndex);
+		}
+
+		/// <summary>
+		/// チャンクの各列の地表の高さが、キャッシュ済みか
+		/// </summary>
+		bool IsCached(const Lattice2& chunkIndex) const noexcept
+		{
+			const Chunk::ChunksArray<CachedHeights>& heights = cachedHeights;
+			return heights[chunkIndex.x][chunkIndex.y].state.load(std::memory_order_acquire) == CachedHeights::Ready;
+		}
+
+		/// <summary>
+		/// <para>チャンクを含むリージョンのタイルを解放する</para>
+		/// <para>そのリージョンのチャンクを、他のスレッドが生成していないことを、呼び出し側で保証すること</para>
+		/// </summary>
+		void ReleaseRegion(const Lattice2& chunkIndex) noexcept
+		{
+			cachedHeights.ReleasePage(chunkIndex.x, chunkIndex.y);
+		}
+
+		/// <summary>
+		/// キャッシュが使っているメモリ量 [byte] を返す
+		/// </summary>
+		std::size_t GetMemoryUsage() const noexcept
+		{
+			return cachedHeights.GetMemoryUsage();
+		}
+
+		/// <summary>
+		/// <para>チャンクの各列の地表の高さを求める (キャッシュを使わない)</para>
+		/// <para>ワールド座標で決まるので、チャンクの境界でも連続する</para>
+		/// <para>1オクターブでワープもカーブも無ければ、Chunk::CreateFromNoise() と同じ値になる</para>
+		/// </summary>
+		static Chunk::ColumnHeights CalculateColumnHeights(const TerrainGenerationSettings& settings, const Lattice2& chunkIndex)
+		{
+			constexpr int ColumnCount = Chunk::Size * Chunk::Size;
+
+			const float seedX = static_cast<float>((settings.seed & 0xFFFF0000) >> 16);
+			const float seedZ = static_cast<float>(settings.seed & 0x0000FFFF);
+
+			// 各列のワールド座標 (インデックスは Chunk::ColumnHeights と同じく x * Size + z)
+			std::array<float, ColumnCount> positionXs;
+			std::array<float, ColumnCount> positionZs;
+			for (int x = 0; x < Chunk::Size; ++x)
+				for (int z = 0; z < Chunk::Size; ++z)
+				{
+					positionXs[x * Chunk::Size + z] = static_cast<float>(x + Chunk::Size * chunkIndex.x);
+					positionZs[x * Chunk::Size + z] = static_cast<float>(z + Chunk::Size * chunkIndex.y);
+				}
+
+			std::array<float, ColumnCount> noiseXs;
+			std::array<float, ColumnCount> noiseZs;
+			std::array<float, ColumnCount> noises;
+
+			// ドメインワープ: 低周波のノイズで座標をずらし、地形の輪郭を不規則にする
+			if (settings.warpStrength != 0.0f)
+			{
+				std::array<float, ColumnCount> warpXs;
+				for (int i = 0; i < ColumnCount; ++i)
+				{
+					noiseXs[i] = (positionXs[i] + seedX + WarpOffsetX) * settings.warpScale;
+					noiseZs[i] = (positionZs[i] + seedZ) * settings.warpScale;
+				}
+				Noise::Simplex2D(noiseXs, noiseZs, warpXs);
+				for (int i = 0; i < ColumnCount; ++i)
+				{
+					noiseXs[i] = (positionXs[i] + seedX) * settings.warpScale;
+					noiseZs[i] = (positionZs[i] + seedZ + WarpOffsetZ) * settings.warpScale;
+				}
+				Noise::Simplex2D(noiseXs, noiseZs, noises);
+				for (int i = 0; i < ColumnCount; ++i)
+				{
+					positionXs[i] += settings.warpStrength * warpXs[i];
+					positionZs[i] += settings.warpStrength * noises[i];
+				}
+			}
+
+			// fBm: オクターブごとに周波数を上げ、振幅を下げて足し合わせる
+			std::array<float, ColumnCount> sums = {};
+			float amplitude = 1.0f;
+			float amplitudeSum = 0.0f;
+			float frequency = 1.0f;
+			for (int octave = 0; octave < std::max(settings.octaveCount, 1); ++octave)
+			{
+				// オクターブごとに原点をずらして、同じ模様が重ならないようにする (最初のオクターブはずらさない)
+				const float offset = OctaveOffset * octave;
+				const float scale = settings.horizontalScale * frequency;
+				for (int i = 0; i < ColumnCount; ++i)
+				{
+					noiseXs[i] = (positionXs[i] + seedX + offset) * scale;
+					noiseZs[i] = (positionZs[i] + seedZ + offset) * scale;
+				}
+				Noise::Simplex2D(noiseXs, noiseZs, noises);
+				for (int i = 0; i < ColumnCount; ++i)
+					sums[i] += amplitude * noises[i];
+
+				amplitudeSum += amplitude;
+				amplitude *= settings.persistence;
+				frequency *= settings.lacunarity;
+			}
+
+			Chunk::ColumnHeights heights;
+			for (int i = 0; i < ColumnCount; ++i)
+			{
+				const float heightNormed = ApplyHeightCurve(settings.heightCurve, (sums[i] / amplitudeSum + 1.0f) * 0.5f); // [0, 1] に正規化
+				heights[i] = static_cast<std::int16_t>(std::clamp(
+					settings.heightBulk + static_cast<int>(heightNormed * settings.heightAmplitude), 0, Chunk::Height - 1));
+			}
+			return heights;
+		}
+
+		/// <summary>
+		/// <para>チャンクの各列の、ブロックがあるマスを、3D の密度から求める</para>
+		/// <para>密度 = (列の高さ - y) + overhangAmplitude * ノイズ で、0 以上ならブロックがある. さらに、洞窟のノイズが caveThreshold を超えたらくり抜く</para>
+		/// <para>ノイズは densityStride 間隔の格子点 (ワールド座標で揃っているので、チャンクの境界でも連続する) でのみ求め、間は3線形補間する</para>
+		/// <para>求める高さは、最も高い列 + overhangAmplitude まで (それより上は、必ず空気)</para>
+		/// </summary>
+		static Chunk::ColumnMasks CalculateColumnMasks(const TerrainGenerationSettings& settings, const Lattice2& chunkIndex, const Chunk::ColumnHeights& heights)
+		{
+			constexpr int ColumnCount = Chunk::Size * Chunk::Size;
+			const Lattice3 stride = settings.densityStride;
+			assert(stride.x > 0 && stride.y > 0 && stride.z > 0 && Chunk::Size % stride.x == 0 && Chunk::Size % stride.z == 0
+				&& "densityStride の x, z は Chunk::Size の約数である必要がある");
+
+			const int maxHeight = *std::max_element(heights.begin(), heights.end());
+			const int maxY = std::min(maxHeight + static_cast<int>(std::ceil(std::max(settings.overhangAmplitude, 0.0f))), Chunk::Height - 1);
+			const Lattice3 latticeCount = Lattice3(Chunk::Size / stride.x + 1, maxY / stride.y + 2, Chunk::Size / stride.z + 1);
+
+			// 格子点のノイズを、各列に双線形補間する (レベル (格子の高さ) ごとに ColumnCount 個)
+			const std::vector<float> overhangLevels = (settings.overhangAmplitude > 0.0f)
+				? CalculateDensityLevels(settings, chunkIndex, latticeCount, settings.overhangScale, OverhangOffset)
+				: std::vector<float>(static_cast<std::size_t>(latticeCount.y) * ColumnCount, 0.0f);
+			const std::vector<float> caveLevels = (settings.caveThreshold < 1.0f)
+				? CalculateDensityLevels(settings, chunkIndex, latticeCount, settings.caveScale, CaveOffset)
+				: std::vector<float>(static_cast<std::size_t>(latticeCount.y) * ColumnCount, 0.0f);
+
+			std::array<float, ColumnCount> surfaceHeights;
+			std::array<float, ColumnCount> caveMaxYs; // これ以下の高さなら、くり抜いてよい
+			for (int i = 0; i < ColumnCount; ++i)
+			{
+				surfaceHeights[i] = static_cast<float>(heights[i]);
+				caveMaxYs[i] = static_cast<float>(heights[i] - settings.caveMinDepth);
+			}
+
+			// 高さごとに、全列をまとめて上下のレベルから線形補間する (連続した配列への同じ演算なので、ベクトル化される)
+			// ループ内で参照する値はローカルに写しておく (ストア先とのエイリアスを疑われて、ベクトル化されなくなるので)
+			const float overhangAmplitude = settings.overhangAmplitude;
+			const float caveThreshold = settings.caveThreshold;
+			Chunk::ColumnMasks masks = {};
+			std::array<std::uint32_t, ColumnCount> solids;
+			std::array<std::uint64_t, ColumnCount> words = {}; // 各列の、いま埋めているワード (縦64マス分)
+			for (int y = 0; y <= maxY; ++y)
+			{
+				const int level = y / stride.y;
+				const float t = static_cast<float>(y - level * stride.y) / static_cast<float>(stride.y);
+				const float* const overhangLower = overhangLevels.data() + static_cast<std::size_t>(level) * ColumnCount;
+				const float* const overhangUpper = overhangLower + ColumnCount;
+				const float* const caveLower = caveLevels.data() + static_cast<std::size_t>(level) * ColumnCount;
+				const float* const caveUpper = caveLower + ColumnCount;
+				const float fy = static_cast<float>(y);
+				// くり抜けない高さでは、閾値を超えないようにする
+				const float threshold = (y >= settings.caveMinHeight) ? caveThreshold : std::numeric_limits<float>::infinity();
+
+				for (int i = 0; i < ColumnCount; ++i)
+				{
+					const float overhang = overhangLower[i] + (overhangUpper[i] - overhangLower[i]) * t;
+					const float cave = caveLower[i] + (caveUpper[i] - caveLower[i]) * t;
+					const bool isDense = surfaceHeights[i] - fy + overhangAmplitude * overhang >= 0.0f;
+					const bool isCarved = (cave > threshold) & (fy <= caveMaxYs[i]);
+					solids[i] = static_cast<std::uint32_t>(isDense & !isCarved);
+				}
+
+				const int bitIndex = y & 63;
+				for (int i = 0; i < ColumnCount; ++i)
+					words[i] |= static_cast<std::uint64_t>(solids[i]) << bitIndex;
+
+				// ワードが埋まったら、列ごとのマスクに写す
+				if (bitIndex == 63 || y == maxY)
+				{
+					for (int i = 0; i < ColumnCount; ++i)
+						masks[i][y >> 6] = words[i];
+					words.fill(0);
+				}
+			}
+			return masks;
+		}
+
+	private:
+		// チャンクごとの、キャッシュした各列の高さ
+		struct CachedHeights
+		{
+			static constexpr std::uint8_t Empty = 0;   // 未計算 (デフォルト値)
+			static constexpr std::uint8_t Writing = 1; // あるスレッドが計算中
+			static constexpr std::uint8_t Ready = 2;   // 計算済み (以降は読み取りのみ)
+
+			std::atomic<std::uint8_t> state = Empty;
+			Chunk::ColumnHeights heights;
+		};
+
+		static constexpr float OctaveOffset = 1741.0f; // オクターブごとに原点をずらす量 [ブロック]
+		static constexpr float WarpOffsetX = 5113.0f;  // x のワープのノイズの原点をずらす量 [ブロック] (z のワープと別の模様にする)
+		static constexpr float WarpOffsetZ = 9277.0f;
+		static constexpr float OverhangOffset = 3329.0f; // 3D のノイズの原点をずらす量 [ブロック] (盛り削りと洞窟を別の模様にする)
+		static constexpr float CaveOffset = 7481.0f;
+		static constexpr std::uint32_t BoulderSalt = 0x6C8E9CF5; // 岩の配置のハッシュを、他の用途とずらす値
+
+		TerrainGenerationSettings settings = {};
+		Chunk::ChunksArray<CachedHeights> cachedHeights;
+
+		// 3D の格子点 (チャンクの原点から densityStride 間隔で latticeCount 個) でノイズを求め、各列に双線形補間する
+		// 戻り値はレベル (格子の高さ) ごとに、各列の値 (インデックスは Chunk::ColumnHeights と同じ) が並ぶ
+		static std::vector<float> CalculateDensityLevels(const TerrainGenerationSettings& settings, const Lattice2& chunkIndex,
+			const Lattice3& latticeCount, float scale, float offset)
+		{
+			constexpr int ColumnCount = Chunk::Size * Chunk::Size;
+			const Lattice3 stride = settings.densityStride;
+			const float seedX = static_cast<float>((settings.seed & 0xFFFF0000) >> 16);
+			const float seedZ = static_cast<float>(settings.seed & 0x0000FFFF);
+
+			// 格子点の座標は、ワールド座標 (整数) から毎回同じ式で求める (隣のチャンクと共有する点が、同じ値になるように)
+			const int sampleCount = latticeCount.x * latticeCount.y * latticeCount.z;
+			std::vector<float> xs(sampleCount);
+			std::vector<float> ys(sampleCount);
+			std::vector<float> zs(sampleCount);
+			for (int xi = 0; xi < latticeCount.x; ++xi)
+				for (int yi = 0; yi < latticeCount.y; ++yi)
+					for (int zi = 0; zi < latticeCount.z; ++zi)
+					{
+						const int i = (xi * latticeCount.y + yi) * latticeCount.z + zi;
+						xs[i] = (static_cast<float>(xi * stride.x + Chunk::Size * chunkIndex.x) + seedX + offset) * scale;
+						ys[i] = (static_cast<float>(yi * stride.y) + offset) * scale;
+						zs[i] = (static_cast<float>(zi * stride.z + Chunk::Size * chunkIndex.y) + seedZ + offset) * scale;
+					}
+			std::vector<float> samples(sampleCount);
+			Noise::Simplex3D(xs, ys, zs, samples);
+
+			// 補間の係数 t は [0, 1) なので、格子点 (t = 0) では、その点の値そのものになる
+			std::vector<float> levels(static_cast<std::size_t>(latticeCount.y) * ColumnCount);
+			for (int yi = 0; yi < latticeCount.y; ++yi)
+			{
+				float* const level = levels.data() + static_cast<std::size_t>(yi) * ColumnCount;
+				const auto sample = [&](int xi, int zi) { return samples[(xi * latticeCount.y + yi) * latticeCount.z + zi]; };
+				for (int x = 0; x < Chunk::Size; ++x)
+				{
+					const int xi = x / stride.x;
+					const float tx = static_cast<float>(x - xi * stride.x) / static_cast<float>(stride.x);
+					for (int z = 0; z < Chunk::Size; ++z)
+					{
+						const int zi = z / stride.z;
+						const float tz = static_cast<float>(z - zi * stride.z) / static_cast<float>(stride.z);
+						const float lower = sample(xi, zi) + (sample(xi + 1, zi) - sample(xi, zi)) * tx;
+						const float upper = sample(xi, zi + 1) + (sample(xi + 1, zi + 1) - sample(xi, zi + 1)) * tx;
+						level[x * Chunk::Size + z] = lower + (upper - lower) * tz;
+					}
+				}
+			}
+			return levels;
+		}
+
+		// シード値・チャンクのインデックス・候補の番号から、32bit のハッシュを求める (スレッドや呼び出し順によらず、同じ値になる)
+		static constexpr std::uint32_t HashChunkIndex(std::uint32_t seed, const Lattice2& chunkIndex, int i) noexcept
+		{
+			std::uint32_t hash = seed ^ BoulderSalt;
+			hash ^= static_cast<std::uint32_t>(chunkIndex.x) * 0x8DA6B343u;
+			hash ^= static_cast<std::uint32_t>(chunkIndex.y) * 0xD8163841u;
+			hash ^= static_cast<std::uint32_t>(i) * 0xCB1AB31Fu;
+
+			// MurmurHash3 の最後の撹拌 (近い入力でも、全ビットがばらけるように)
+			hash ^= hash >> 16;
+			hash *= 0x85EBCA6Bu;
+			hash ^= hash >> 13;
+			hash *= 0xC2B2AE35u;
+			hash ^= hash >> 16;
+			return hash;
+		}
+
+		// 岩のうち target に重なる部分を、列ごとに石で埋める
+		// targetOffset は、岩を置くチャンクから見た target のチャンクの差
+		static void PlaceBoulder(Chunk& target, const Boulder& boulder, const Lattice2& targetOffset)
+		{
+			const int centerX = boulder.center.x - targetOffset.x * Chunk::Size;
+			const int centerZ = boulder.center.z - targetOffset.y * Chunk::Size;
+			const int radius = boulder.radius;
+			const int radiusSquared = radius * radius + radius; // 半径 r + 0.5 の球 (軸の先端が1ブロックだけ尖らないように)
+
+			for (int x = std::max(centerX - radius, 0); x <= std::min(centerX + radius, Chunk::Size - 1); ++x)
+				for (int z = std::max(centerZ - radius, 0); z <= std::min(centerZ + radius, Chunk::Size - 1); ++z)
+				{
+					const int remaining = radiusSquared - (x - centerX) * (x - centerX) - (z - centerZ) * (z - centerZ);
+					if (remaining < 0)
+						continue;
+
+					const int halfHeight = static_cast<int>(std::sqrt(static_cast<float>(remaining)));
+					target.FillColumn({ x, z }, boulder.center.y - halfHeight, boulder.center.y + halfHeight, Block::Stone);
+				}
+		}
+
+		// 正規化したノイズ t [0, 1] を、カーブで写す
+		static float ApplyHeightCurve(const std::vector<float>& curve, float t) noexcept
+		{
+			if (curve.size() < 2)
+				return t;
+
+			const float position = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(curve.size() - 1);
+			const int i = std::min(static_cast<int>(position), static_cast<int>(curve.size()) - 2);
+			return std::lerp(curve[i], curve[i + 1], position - static_cast<float>(i));
+		}
+	};
+}
\ No newline at end of file
@@ -292,6 +292,8 @@ public: \
 
 		ShaderVisibility shaderVisibility;
 		std::vector<DescriptorRange> descriptorRanges; // この順に登録される
+		int constantAmount = 0; // ドローコールごとに設定する定数 (ルート定数) の数 (32bit 単位. 0 なら使わない)
+		ShaderRegister constantShaderRegister = ShaderRegister::b0; // ルート定数のレジスタ
 
 		/// <summary>
 		/// <para>CBV, SRV の順に、指定された数だけ並べて作成する</para>
@@ -313,6 +315,23 @@ public: \
 				},
 			};
 		}
+
+		/// <summary>
+		/// <para>CreateBasic() に加えて、ドローコールごとに設定する定数 (ルート定数) を constantAmount 個 (32bit 単位) 持たせる</para>
+		/// <para>ルート定数のレジスタは、CBV の次 (b{cbvAmount}) となる</para>
+		/// <para>ルート定数は、ルートパラメータのインデックス1に登録される</para>
+		/// </summary>
+		static constexpr RootParameter CreateBasicWithConstants(
+			int cbvAmount,
+			int srvAmount,
+			int constantAmount
+		)
+		{
+			RootParameter rootParameter = CreateBasic(cbvAmount, srvAmount);
+			rootParameter.constantAmount = constantAmount;
+			rootParameter.constantShaderRegister = static_cast<ShaderRegister>(cbvAmount);
+			return rootParameter;
+		}
 	};
 
 	// サンプラーの設定
@@ -346,12 +365,21 @@ public: \
 	struct VertexData
 	{
 		ForiverEngine::Vector4 pos; // モデル座標系
-		ForiverEngine::Vector2 uv; // 左上が原点
+		ForiverEngine::Vector2 uv; // 面の中での座標 (1ブロック = 1.0. テクスチャのどのマスを読むかは、シェーダーで法線から決める)
 		ForiverEngine::Vector3 normal; // 法線ベクトル (単位ベクトル)
 		ForiverEngine::Vector3 centerWorldPos; // モデル中心の、ワールド座標 (シェーダーからブロックのまとまりを判別するために使用する)
 		std::uint32_t texIndex; // 使用するテクスチャのインデックス (偶数ならテクスチャの上半分、奇数なら下半分となるはず)
 	};
 
+	// 頂点データ (地形. 8バイトに詰める)
+	// 法線・UV値は面の向きから、ワールド座標はチャンクの原点 (ドローコールごとのルート定数) から、シェーダーで復元する
+	// 詰め方は TerrainVertex (TerrainMesh.h) を参照
+	struct VertexDataTerrain
+	{
+		std::uint32_t packed; // チャンク内での頂点の格子点座標, 面の向き, 面の中での頂点番号
+		std::uint32_t texIndex; // 使用するテクスチャのインデックス (VertexData と同じ) と、ドローコールの原点からのチャンク数
+	};
+
 	// 頂点データ (板ポリ)
 	struct VertexDataQuad
 	{
@@ -376,6 +404,13 @@ public: \
 		{ "TEXINDEX" , Format::R_U32    },
 	};
 
+	// 頂点レイアウト (地形)
+	const std::vector<VertexLayout> VertexLayoutsTerrain =
+	{
+		{ "PACKED"   , Format::R_U32    },
+		{ "TEXINDEX" , Format::R_U32    },
+	};
+
 	// 頂点レイアウト (板ポリ)
 	const std::vector<VertexLayout> VertexLayoutsQuad =
 	{
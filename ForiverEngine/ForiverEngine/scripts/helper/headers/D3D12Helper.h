@@ -85,6 +85,12 @@ namespace ForiverEngine
 		static GraphicsBuffer CreateGraphicsBufferTexture2D(const Device& device, const Texture& texture,
 			GraphicsBufferUsagePermission usagePermission, GraphicsBufferState initState, const Color& clearColor);
 
+		/// <summary>
+		/// <para>GraphicsBuffer を解放し、nullptr にする (既に nullptr なら何もしない)</para>
+		/// <para>GPU が使用中でないことを、呼び出し側で保証すること</para>
+		/// </summary>
+		static void ReleaseGraphicsBuffer(GraphicsBuffer& graphicsBuffer);
+
 		/// <summary>
 		/// <para>RTV を作成し、RTV 用 DescriptorHeap に登録する</para>
 		/// <para>swapChain からRT群を取得し、それぞれに対して RTV を作成する</para>
@@ -258,6 +264,13 @@ namespace ForiverEngine
 		static void CommandLinkDescriptorHeapToRootSignature(
 			const CommandList& commandList, const DescriptorHandleAtGPU& firstDescriptor, int rootParameterIndex);
 
+		/// <summary>
+		/// <para>[Command]</para>
+		/// <para>rootParameterIndex 番目のルートパラメータ (ルート定数) に、constants から constantAmount 個 (32bit 単位) の値を書き込む</para>
+		/// </summary>
+		static void CommandSetGraphicsRootConstants(
+			const CommandList& commandList, int rootParameterIndex, const void* constants, int constantAmount);
+
 		/// <summary>
 		/// <para>[Command]</para>
 		/// Input Assembler : トポロジーを設定する
@@ -295,6 +308,13 @@ namespace ForiverEngine
 		/// </summary>
 		static void CommandDrawIndexedInstanced(const CommandList& commandList, int indexCount);
 
+		/// <summary>
+		/// <para>[Command]</para>
+		/// <para>描画命令を発行する (インスタンス数 = 1)</para>
+		/// <para>頂点のインデックスに baseVertex を足して描画する (1つの頂点バッファに詰めた、複数のメッシュを描き分ける)</para>
+		/// </summary>
+		static void CommandDrawIndexedInstanced(const CommandList& commandList, int indexCount, int baseVertex);
+
 		/// <summary>
 		/// <para>[Command]</para>
 		/// CommandList を閉じる
@@ -106,23 +106,39 @@ namespace ForiverEngine
 			descriptorRangesReal.push_back(Construct(rootParameter.descriptorRanges[i]));
 		}
 
-		const D3D12_ROOT_PARAMETER rootParameterReal =
-		{
-			.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE,
-			.DescriptorTable =
+		// [0] : DescriptorTable, [1] : ルート定数 (使う場合のみ)
+		std::vector<D3D12_ROOT_PARAMETER> rootParametersReal = {};
+		rootParametersReal.push_back(
 			{
-				.NumDescriptorRanges = static_cast<UINT>(descriptorRangesReal.size()),
-				.pDescriptorRanges = descriptorRangesReal.data()
-			},
-			.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(rootParameter.shaderVisibility)
-		};
+				.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE,
+				.DescriptorTable =
+				{
+					.NumDescriptorRanges = static_cast<UINT>(descriptorRangesReal.size()),
+					.pDescriptorRanges = descriptorRangesReal.data()
+				},
+				.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(rootParameter.shaderVisibility)
+			});
+		if (rootParameter.constantAmount > 0)
+		{
+			rootParametersReal.push_back(
+				{
+					.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS,
+					.Constants =
+					{
+						.ShaderRegister = static_cast<UINT>(rootParameter.constantShaderRegister),
+						.RegisterSpace = 0, // 規定値
+						.Num32BitValues = static_cast<UINT>(rootParameter.constantAmount)
+					},
+					.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(rootParameter.shaderVisibility)
+				});
+		}
 
 		const D3D12_STATIC_SAMPLER_DESC samplerDescReal = Construct(samplerConfig);
 
 		const D3D12_ROOT_SIGNATURE_DESC desc
 		{
-			.NumParameters = 1,
-			.pParameters = &rootParameterReal,
+			.NumParameters = static_cast<UINT>(rootParametersReal.size()),
+			.pParameters = rootParametersReal.data(),
 			.NumStaticSamplers = 1,
 			.pStaticSamplers = &samplerDescReal,
 			.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT, // 「頂点情報(入力アセンブラ) がある」
@@ -501,6 +517,14 @@ namespace ForiverEngine
 		return GraphicsBuffer();
 	}
 
+	void D3D12Helper::ReleaseGraphicsBuffer(GraphicsBuffer& graphicsBuffer)
+	{
+		if (graphicsBuffer)
+			graphicsBuffer->Release();
+
+		graphicsBuffer = GraphicsBuffer();
+	}
+
 	bool D3D12Helper::CreateRenderTargetViews(
 		const Device& device, const DescriptorHeap& descriptorHeapRTV, const SwapChain& swapChain, Format format)
 	{
@@ -927,6 +951,17 @@ namespace ForiverEngine
 		);
 	}
 
+	void D3D12Helper::CommandSetGraphicsRootConstants(
+		const CommandList& commandList, int rootParameterIndex, const void* constants, int constantAmount)
+	{
+		commandList->SetGraphicsRoot32BitConstants(
+			static_cast<UINT>(rootParameterIndex),
+			static_cast<UINT>(constantAmount),
+			constants,
+			0 // 先頭から書き込む
+		);
+	}
+
 	void D3D12Helper::CommandIASetPrimitiveTopology(const CommandList& commandList, PrimitiveTopology primitiveTopology)
 	{
 		commandList->IASetPrimitiveTopology(static_cast<D3D12_PRIMITIVE_TOPOLOGY>(primitiveTopology));
@@ -980,6 +1015,17 @@ namespace ForiverEngine
 		);
 	}
 
+	void D3D12Helper::CommandDrawIndexedInstanced(const CommandList& commandList, int indexCount, int baseVertex)
+	{
+		commandList->DrawIndexedInstanced(
+			static_cast<UINT>(indexCount),
+			1, // インスタンス数 (今回はインスタンシングしないので、1でOK)
+			0, // インデックスデータのオフセット
+			static_cast<INT>(baseVertex), // 頂点データのオフセット
+			0  // インスタンスのオフセット
+		);
+	}
+
 	void D3D12Helper::CommandClose(const CommandList& commandList)
 	{
 		commandList->Close();
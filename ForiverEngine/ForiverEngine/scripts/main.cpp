@@ -5,6 +5,7 @@
 #ifdef _DEBUG
 #include <scripts/test/Include.h>
 #endif
+#include <scripts/test/ChunkBenchmark.h> // ベンチマークは Release でも使う (テスト用のアサートに依存しない)
 
 int Main(hInstance)
 {
@@ -17,12 +18,23 @@ int Main(hInstance)
 #ifdef _DEBUG
 #if 0
 	Test::PlayerControl::RunAll();
+	Test::ChunkMesh::RunAll();
+	Test::RangeAllocator::RunAll();
+	Test::MultiDimArray::RunAll();
+	Test::Noise::RunAll();
+	Test::TerrainGenerator::RunAll();
 
 	ShowError(L"全てのテストに成功しました");
 	return 0;
 #endif
 #endif
 
+	// ベンチマーク実行 (最適化が効いた状態で計測したいので、Release でも実行可能)
+#if 0
+	ShowError(StringUtils::UTF8ToUTF16(Test::ChunkBenchmark::RunAll()));
+	return 0;
+#endif
+
 #ifdef _DEBUG
 	if (!D3D12Helper::EnableDebugLayer())
 		ShowError(L"DebugLayer の有効化に失敗しました");
@@ -68,12 +80,13 @@ int Main(hInstance)
 	const GraphicsBuffer shadowGraphicsBuffer = D3D12Helper::CreateGraphicsBufferTexture2D(device, shadowTextureMetadata,
 		GraphicsBufferUsagePermission::AllowRenderTarget, GraphicsBufferState::PixelShaderResource, Color(DepthBufferClearValue, 0, 0, 0));
 
-	const RootParameter rootParameterShadow = RootParameter::CreateBasic(1, 1);
+	// b1 : チャンクの原点 (ドローコールごとのルート定数)
+	const RootParameter rootParameterShadow = RootParameter::CreateBasicWithConstants(1, 1, 4);
 	const SamplerConfig samplerConfigShadow = SamplerConfig::CreateBasic(AddressingMode::Clamp, Filter::Point);
 	const auto [shaderVSShadow, shaderPSShadow] = D3D12Utils::CompileShader_VS_PS("./shaders/ShadowDepthWrite.hlsl");
 	const auto [rootSignatureShadow, graphicsPipelineStateShadow]
 		= D3D12Utils::CreateRootSignatureAndGraphicsPipelineState(
-			device, rootParameterShadow, samplerConfigShadow, shaderVSShadow, shaderPSShadow, VertexLayoutsQuad, FillMode::Solid, CullMode::Back, true);
+			device, rootParameterShadow, samplerConfigShadow, shaderVSShadow, shaderPSShadow, VertexLayoutsTerrain, FillMode::Solid, CullMode::Back, true);
 
 	// RTV, DSV
 	const DescriptorHandleAtCPU rtvShadow = D3D12Utils::InitRTV(device, shadowGraphicsBuffer, Format::R_F32);
@@ -101,12 +114,14 @@ int Main(hInstance)
 
 #pragma region MainRender
 
-	const RootParameter rootParameter = RootParameter::CreateBasic(2, 2);
+	// b2 : チャンクの原点 (ドローコールごとのルート定数)
+	const RootParameter rootParameter = RootParameter::CreateBasicWithConstants(2, 2, 4);
 	const SamplerConfig samplerConfig = SamplerConfig::CreateBasic(AddressingMode::Clamp, Filter::Point);
 	const auto [shaderVS, shaderPS] = D3D12Utils::CompileShader_VS_PS("./shaders/Basic.hlsl");
+	// 地形の面は表から見て時計回りなので、裏面をカリングする (PackDrawCommands() は、同じメッシュ内の裏を向く向きの面も挟んでまとめて描画する)
 	const auto [rootSignature, graphicsPipelineState]
 		= D3D12Utils::CreateRootSignatureAndGraphicsPipelineState(
-			device, rootParameter, samplerConfig, shaderVS, shaderPS, VertexLayouts, FillMode::Solid, CullMode::None, true);
+			device, rootParameter, samplerConfig, shaderVS, shaderPS, VertexLayoutsTerrain, FillMode::Solid, CullMode::Back, true);
 
 	const SwapChain swapChain = D3D12Helper::CreateSwapChain(factory, commandQueue, hwnd, WindowSize);
 	if (!swapChain)
@@ -248,11 +263,16 @@ int Main(hInstance)
 		}
 
 		// プレイヤーの存在チャンクが変化したなら、描画チャンクを更新する
+		// そうでなくても、生成途中のチャンク (並列処理の完了待ち・後回しにしたメッシュの作り直しなど) は毎フレーム進める
 		playerExistingChunkIndex = Chunk::GetIndex(playerController.GetFootBlockPosition());
 		if (playerExistingChunkIndex.DropDirty())
 		{
 			chunksManager.UpdateDrawChunks(playerExistingChunkIndex.GetValue(), true, device);
 		}
+		else
+		{
+			chunksManager.AdvanceGeneration(true, device);
+		}
 
 		// デバッグテキスト
 		{
@@ -289,31 +309,37 @@ int Main(hInstance)
 		if (!currentBackRT)
 			ShowError(L"現在のバックレンダーターゲットの取得に失敗しました");
 
-		const auto& packedDrawVBVs = chunksManager.PackDrawVBVs();
-		const auto& packedDrawIBVs = chunksManager.PackDrawIBVs();
-		const auto& packedDrawMeshIndicesCounts = chunksManager.PackDrawMeshIndicesCounts();
-
 		// 影のデプス書き込み
+		// 太陽から見て裏を向く面は、描画しない
 		if (cb1VirtualPtr->CastShadow == 1)
 		{
+			const TerrainFaceCulling shadowFaceCulling = TerrainFaceCulling::CreateOrthographic(SunCamera::Direction);
+			const ChunksManager::DrawCommands& drawCommands = chunksManager.PackDrawCommands(shadowFaceCulling);
+
 			D3D12Utils::Draw(
 				commandList, commandQueue, commandAllocator, device,
 				rootSignatureShadow, graphicsPipelineStateShadow, shadowGraphicsBuffer,
-				rtvShadow, dsvShadow, descriptorHeapBasicShadow, packedDrawVBVs, packedDrawIBVs,
+				rtvShadow, dsvShadow, descriptorHeapBasicShadow, drawCommands.vbvs, drawCommands.ibvs,
 				GraphicsBufferState::PixelShaderResource, GraphicsBufferState::RenderTarget,
 				viewportScissorRectShadow, PrimitiveTopology::TriangleList, Color(DepthBufferClearValue, 0, 0, 0), DepthBufferClearValue,
-				packedDrawMeshIndicesCounts
+				drawCommands.indicesCounts, drawCommands.chunkOrigins, drawCommands.baseVertices
 			);
 		}
 		// メインレンダリング
-		D3D12Utils::Draw(
-			commandList, commandQueue, commandAllocator, device,
-			rootSignature, graphicsPipelineState, postProcessRenderer->GetRT(),
-			postProcessRenderer->GetRTV(), dsv, descriptorHeapBasic, packedDrawVBVs, packedDrawIBVs,
-			GraphicsBufferState::PixelShaderResource, GraphicsBufferState::RenderTarget,
-			viewportScissorRect, PrimitiveTopology::TriangleList, BackgroundColor, DepthBufferClearValue,
-			packedDrawMeshIndicesCounts
-		);
+		// カメラから見て裏を向く面は、描画しない (影のパックは描画し終わっているので、上書きしてよい)
+		{
+			const TerrainFaceCulling faceCulling = TerrainFaceCulling::CreatePerspective(playerController.GetEyePosition());
+			const ChunksManager::DrawCommands& drawCommands = chunksManager.PackDrawCommands(faceCulling);
+
+			D3D12Utils::Draw(
+				commandList, commandQueue, commandAllocator, device,
+				rootSignature, graphicsPipelineState, postProcessRenderer->GetRT(),
+				postProcessRenderer->GetRTV(), dsv, descriptorHeapBasic, drawCommands.vbvs, drawCommands.ibvs,
+				GraphicsBufferState::PixelShaderResource, GraphicsBufferState::RenderTarget,
+				viewportScissorRect, PrimitiveTopology::TriangleList, BackgroundColor, DepthBufferClearValue,
+				drawCommands.indicesCounts, drawCommands.chunkOrigins, drawCommands.baseVertices
+			);
+		}
 		// ポストプロセス
 		postProcessRenderer->Draw(
 			commandList, commandQueue, commandAllocator, device,
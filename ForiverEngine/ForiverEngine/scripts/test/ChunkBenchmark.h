@@ -0,0 +1,928 @@
+﻿#pragma once
+
+// Release でも使うので、テスト用のアサート (IncludeInternal.h) には依存しない
+#include <scripts/common/Include.h>
+#include <scripts/helper/Include.h>
+#include <scripts/component/Include.h>
+#include <scripts/gameFlow/Include.h>
+
+#include <chrono>
+#include <map>
+
+namespace ForiverEngine
+{
+	namespace Test
+	{
+		/// <summary>
+		/// <para>チャンクの生成・メッシュ作成の計測</para>
+		/// <para>結果は文字列で返すので、呼び出し側で表示すること</para>
+		/// <para>計測した処理どうしの結果が一致しなければ、結果の先頭に不一致の一覧を載せる (Release でもアサートせずに報告する)</para>
+		/// </summary>
+		struct ChunkBenchmark final
+		{
+		public:
+			DELETE_DEFAULT_METHODS(ChunkBenchmark);
+
+			static constexpr int IterationCount = 64; // 各計測の反復回数
+
+			static std::string RunAll()
+			{
+				mismatches.clear();
+				std::string report = "";
+
+				report += Run_Allocation();
+				report += Run_Noise();
+				report += Run_TerrainGeneration();
+				report += Run_ChunkFill();
+				report += Run_Density();
+				report += Run_FaceScan();
+				report += Run_CreateMesh();
+				report += Run_Occlusion();
+				report += Run_MeshSizing();
+				report += Run_SectionRemesh();
+				report += Run_Lod();
+				report += Run_FaceCulling();
+				report += Run_Memory();
+				report += Run_ChunksManagerStartup();
+				report += Run_Pool();
+
+				return "[Chunk Benchmark]\n" + mismatches + report;
+			}
+
+#pragma region Helpers
+
+			// 計測した処理どうしの結果の不一致 (1行ずつ)
+			inline static std::string mismatches = "";
+
+			// 結果が一致しているか確かめ、一致していなければ不一致の一覧に載せる
+			static void Check(bool isMatched, std::string_view description)
+			{
+				if (!isMatched)
+					mismatches += std::format("MISMATCH : {}\n", description);
+			}
+
+			// 処理を IterationCount 回実行し、1回あたりの平均時間 [ms] を返す
+			template<typename TFunc>
+			static double MeasureMilliseconds(const TFunc& func)
+			{
+				const auto begin = std::chrono::steady_clock::now();
+				for (int i = 0; i < IterationCount; ++i)
+					func();
+				const auto end = std::chrono::steady_clock::now();
+
+				return std::chrono::duration<double, std::milli>(end - begin).count() / IterationCount;
+			}
+
+			// 計測用のチャンク (ワールド中央付近の、標準的な地形)
+			static Chunk CreateTerrainChunk()
+			{
+				return Chunk::CreateFromNoise(Lattice2(Chunk::Count / 2, Chunk::Count / 2), { 0.015f, 12.0f }, 16, 18, 24);
+			}
+
+			// 旧来の [x][y][z] の3重ポインタ配列に、チャンクのデータを書き写す
+			static HeapMultiDimAllocator::Array3D<Block> CopyToLegacyArray(const Chunk& chunk)
+			{
+				auto array3D = HeapMultiDimAllocator::CreateArray3D<Block>(Chunk::Size, Chunk::Height, Chunk::Size);
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int y = 0; y < Chunk::Height; ++y)
+						for (int z = 0; z < Chunk::Size; ++z)
+							array3D[x][y][z] = chunk.GetBlock({ x, y, z });
+
+				return array3D;
+			}
+
+			// 連続した [x][y][z] の3次元配列に、チャンクのデータを書き写す
+			static HeapMultiDimAllocator::ArrayND<Block, 3> CopyToArrayND(const Chunk& chunk)
+			{
+				auto arrayND = HeapMultiDimAllocator::CreateArrayND<Block>(Chunk::Size, Chunk::Height, Chunk::Size);
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int y = 0; y < Chunk::Height; ++y)
+						for (int z = 0; z < Chunk::Size; ++z)
+							arrayND[x][y][z] = chunk.GetBlock({ x, y, z });
+
+				return arrayND;
+			}
+
+			// 露出しているフェース数を数える (メッシュ作成時の隣接参照と同じアクセスパターン)
+			template<typename TGetter>
+			static int CountExposedFaces(const TGetter& getBlock)
+			{
+				constexpr Lattice3 FaceNormals[] =
+				{
+					Lattice3::Up(), Lattice3::Down(), Lattice3::Right(), Lattice3::Left(), Lattice3::Forward(), Lattice3::Backward(),
+				};
+
+				int count = 0;
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+						for (int y = 0; y < Chunk::Height; ++y)
+						{
+							if (getBlock(Lattice3(x, y, z)) == Block::Air)
+								continue;
+
+							for (const Lattice3& faceNormal : FaceNormals)
+							{
+								const Lattice3 p = Lattice3(x, y, z) + faceNormal;
+								if (!MathUtils::IsInRange(p.x, 0, Chunk::Size) ||
+									!MathUtils::IsInRange(p.y, 0, Chunk::Height) ||
+									!MathUtils::IsInRange(p.z, 0, Chunk::Size) ||
+									getBlock(p) == Block::Air)
+									++count;
+							}
+						}
+
+				return count;
+			}
+
+			// 露出しているフェース数を、占有ビットマスクのビット演算で数える (縦64ブロック分をまとめて判定する)
+			static int CountExposedFacesByOccupancy(const Chunk& chunk)
+			{
+				int count = 0;
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+						for (int wordIndex = 0; wordIndex < Chunk::OccupancyWordsPerColumn; ++wordIndex)
+						{
+							for (const std::uint64_t faceMask : chunk.CalculateExposedFaceMasks({ x, z }, wordIndex))
+								count += std::popcount(faceMask);
+						}
+
+				return count;
+			}
+
+			// 以前のメッシュ作成 (確保済みの vertices に、面ごとの分岐で頂点を1つずつ push_back する)
+			// 再確保の度に、新旧の配列が同時に存在するので、その合計の最大値を peakBytes に返す
+			static void CreateMeshByPushBack(const Chunk& chunk, std::vector<VertexDataTerrain>& vertices, std::size_t& peakBytes, int& reallocationCount)
+			{
+				peakBytes = vertices.capacity() * sizeof(VertexDataTerrain);
+				reallocationCount = 0;
+
+				const auto pushVertex = [&](const VertexDataTerrain& vertex)
+					{
+						const std::size_t capacity = vertices.capacity();
+						vertices.push_back(vertex);
+						if (vertices.capacity() != capacity)
+						{
+							peakBytes = std::max(peakBytes, (capacity + vertices.capacity()) * sizeof(VertexDataTerrain));
+							++reallocationCount;
+						}
+					};
+
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+						for (int wordIndex = 0; wordIndex < Chunk::OccupancyWordsPerColumn; ++wordIndex)
+						{
+							const auto faceMasks = chunk.CalculateExposedFaceMasks({ x, z }, wordIndex);
+							std::uint64_t exposedMask = faceMasks[0] | faceMasks[1] | faceMasks[2] | faceMasks[3] | faceMasks[4] | faceMasks[5];
+							while (exposedMask != 0)
+							{
+								const int bitIndex = std::countr_zero(exposedMask);
+								exposedMask &= exposedMask - 1;
+
+								const int y = (wordIndex << 6) + bitIndex;
+								for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+								{
+									if (((faceMasks[faceIndex] >> bitIndex) & 1) == 0)
+										continue;
+
+									const std::uint32_t textureIndex = BlockProperties::GetTextureIndex(chunk.GetBlock({ x, y, z }), faceIndex);
+									for (int corner = 0; corner < 4; ++corner)
+									{
+										const int (&offset)[3] = TerrainVertex::FaceCornerOffsets[faceIndex][corner];
+										pushVertex(TerrainVertex::Encode(Lattice3(x + offset[0], y + offset[1], z + offset[2]), faceIndex, corner, textureIndex));
+									}
+								}
+							}
+						}
+			}
+
+			// 四角形ごとに、遮蔽のビットを除いた頂点が同じか (遮蔽によって四角形の対角線を入れ替えると、頂点の並びが回るので、四角形内の順は問わない)
+			static bool IsSameMeshIgnoringOcclusion(const std::vector<VertexDataTerrain>& a, const std::vector<VertexDataTerrain>& b)
+			{
+				if (a.size() != b.size())
+					return false;
+
+				constexpr std::uint32_t OcclusionMask =
+					((1u << (TerrainVertex::AmbientOcclusionBits + TerrainVertex::SkyOcclusionBits)) - 1) << TerrainVertex::AmbientOcclusionShift;
+				const auto toQuadKey = [](const VertexDataTerrain* quad)
+					{
+						std::array<std::uint64_t, 4> key = {};
+						for (int i = 0; i < 4; ++i)
+							key[i] = (static_cast<std::uint64_t>(quad[i].packed & ~OcclusionMask) << 32) | quad[i].texIndex;
+						std::sort(key.begin(), key.end());
+						return key;
+					};
+				for (std::size_t quadBegin = 0; quadBegin < a.size(); quadBegin += TerrainMesh::VerticesPerQuad)
+				{
+					if (toQuadKey(&a[quadBegin]) != toQuadKey(&b[quadBegin]))
+						return false;
+				}
+				return true;
+			}
+
+			// 旧来の地形の生成 (全ブロックを空気で埋め直してから、1ブロックずつ SetBlock() する)
+			static Chunk CreateFromHeightsPerBlock(const Chunk::ColumnHeights& heights, int minDirtHeight, int minStoneHeight)
+			{
+				Chunk chunk = Chunk::CreateVoid();
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int y = 0; y < Chunk::Height; ++y)
+						for (int z = 0; z < Chunk::Size; ++z)
+							chunk.SetBlock({ x, y, z }, Block::Air);
+
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+					{
+						const int height = heights[x * Chunk::Size + z];
+						for (int y = 0; y <= height; ++y)
+						{
+							Block block = Block::Sand;
+							if (y >= minStoneHeight)
+								block = Block::Stone;
+							else if (y >= minDirtHeight)
+								block = (y == height) ? Block::Grass : Block::Dirt;
+							chunk.SetBlock({ x, y, z }, block);
+						}
+					}
+
+				chunk.Compact();
+				return chunk;
+			}
+
+#pragma endregion
+
+			static std::string Run_Allocation()
+			{
+				// 旧来の3重ポインタ配列は、外側から順に 1 + X + X*Y 回の確保を行う
+				constexpr int LegacyAllocationCount = 1 + Chunk::Size + Chunk::Size * Chunk::Height;
+				// 空のチャンクは、全セクションが一様なので確保を行わない (占有ビットマスクは、プールの再利用で賄う)
+				constexpr int AllocationCount = 0;
+
+				const double legacyMs = MeasureMilliseconds([]()
+					{
+						const auto array3D = HeapMultiDimAllocator::CreateArray3D<Block>(Chunk::Size, Chunk::Height, Chunk::Size);
+					});
+				const double ms = MeasureMilliseconds([]()
+					{
+						const Chunk chunk = Chunk::CreateVoid();
+					});
+
+				return std::format(
+					"Allocation : legacy {} allocs, {:.4f} ms / current {} allocs, {:.4f} ms\n",
+					LegacyAllocationCount, legacyMs, AllocationCount, ms
+				);
+			}
+
+			static std::string Run_Noise()
+			{
+				// 2D : チャンク 16 個分の列 (地形の高さ)
+				constexpr int ColumnCount = Chunk::Size * Chunk::Size * 16;
+				std::vector<float> xs(ColumnCount);
+				std::vector<float> zs(ColumnCount);
+				for (int i = 0; i < ColumnCount; ++i)
+				{
+					xs[i] = (i / (Chunk::Size * 4) + 10000.0f) * 0.015f;
+					zs[i] = (i % (Chunk::Size * 4) + 20000.0f) * 0.015f;
+				}
+
+				std::vector<float> scalarNoises2D(ColumnCount);
+				std::vector<float> batchNoises2D(ColumnCount);
+				const double scalar2DMs = MeasureMilliseconds([&]()
+					{
+						for (int i = 0; i < ColumnCount; ++i)
+							scalarNoises2D[i] = ForiverEngine::Noise::Simplex2D(xs[i], zs[i]);
+					});
+				const double batch2DMs = MeasureMilliseconds([&]()
+					{
+						ForiverEngine::Noise::Simplex2D(xs, zs, batchNoises2D);
+					});
+
+				// 3D : 1チャンク分の広さで、高さ 64 の格子
+				const Vector3 origin = Vector3(100.0f, 0.0f, 200.0f);
+				const Vector3 step = Vector3::One() * 0.05f;
+				const Lattice3 count = Lattice3(Chunk::Size, 64, Chunk::Size);
+				const int sampleCount3D = count.x * count.y * count.z;
+				std::vector<float> scalarNoises3D(sampleCount3D);
+				std::vector<float> batchNoises3D(sampleCount3D);
+				const double scalar3DMs = MeasureMilliseconds([&]()
+					{
+						for (int xi = 0; xi < count.x; ++xi)
+							for (int yi = 0; yi < count.y; ++yi)
+								for (int zi = 0; zi < count.z; ++zi)
+									scalarNoises3D[(xi * count.y + yi) * count.z + zi] =
+										ForiverEngine::Noise::Simplex3D(origin.x + step.x * xi, origin.y + step.y * yi, origin.z + step.z * zi);
+					});
+				const double batch3DMs = MeasureMilliseconds([&]()
+					{
+						ForiverEngine::Noise::Simplex3DGrid(batchNoises3D, origin, step, count);
+					});
+
+				for (int i = 0; i < ColumnCount; ++i)
+					Check(std::abs(batchNoises2D[i] - scalarNoises2D[i]) <= 1.0e-3f, "Noise 2D batch != scalar");
+				for (int i = 0; i < sampleCount3D; ++i)
+					Check(std::abs(batchNoises3D[i] - scalarNoises3D[i]) <= 1.0e-3f, "Noise 3D grid != scalar");
+
+				const auto nsPerSample = [](double ms, int samples) { return ms * 1.0e6 / samples; };
+				return std::format(
+					"Noise ({} lanes) : 2D scalar {:.2f} ns / batch {:.2f} ns per sample (x{:.1f}) / 3D scalar {:.2f} ns / grid {:.2f} ns per sample (x{:.1f})\n",
+					SimplexNoiseBatch::GetLaneCount(),
+					nsPerSample(scalar2DMs, ColumnCount), nsPerSample(batch2DMs, ColumnCount), scalar2DMs / batch2DMs,
+					nsPerSample(scalar3DMs, sampleCount3D), nsPerSample(batch3DMs, sampleCount3D), scalar3DMs / batch3DMs
+				);
+			}
+
+			static std::string Run_TerrainGeneration()
+			{
+				// 8x8 チャンクの各列の高さ・地形を求める
+				constexpr int ChunkCountPerSide = 8;
+				constexpr int ChunkCount = ChunkCountPerSide * ChunkCountPerSide;
+				const auto forEachChunk = [](const auto& func)
+					{
+						for (int xi = 0; xi < ChunkCountPerSide; ++xi)
+							for (int zi = 0; zi < ChunkCountPerSide; ++zi)
+								func(Lattice2(Chunk::Count / 2 + xi, Chunk::Count / 2 + zi));
+					};
+
+				const TerrainGenerationSettings settings = TerrainGenerationSettings::CreateFractal();
+				ForiverEngine::TerrainGenerator generator = ForiverEngine::TerrainGenerator(settings);
+
+				int checksum = 0;
+				const double singleOctaveMs = MeasureMilliseconds([&]()
+					{
+						forEachChunk([&](const Lattice2& chunkIndex)
+							{
+								checksum += Chunk::CreateSurfaceMapFromNoise(chunkIndex, { 0.015f, 12.0f }, 16, 18, 24).heights[0];
+							});
+					});
+				const double fractalMs = MeasureMilliseconds([&]()
+					{
+						forEachChunk([&](const Lattice2& chunkIndex)
+							{
+								checksum += ForiverEngine::TerrainGenerator::CalculateColumnHeights(settings, chunkIndex)[0];
+							});
+					});
+				// 空のタイルを埋める場合と、埋まったタイルから読む場合 (地形の生成後に LOD の地表を求める場合など)
+				const double fillMs = MeasureMilliseconds([&]()
+					{
+						generator.ReleaseRegion(Lattice2(Chunk::Count / 2, Chunk::Count / 2));
+						forEachChunk([&](const Lattice2& chunkIndex) { checksum += generator.GetColumnHeights(chunkIndex)[0]; });
+					});
+				const double cachedMs = MeasureMilliseconds([&]()
+					{
+						forEachChunk([&](const Lattice2& chunkIndex) { checksum += generator.GetColumnHeights(chunkIndex)[0]; });
+					});
+
+				// ブロックを埋めるところまで含めた、チャンク1つの生成 (fractal は、キャッシュ済みの高さから)
+				const double legacyChunkMs = MeasureMilliseconds([&]()
+					{
+						forEachChunk([&](const Lattice2& chunkIndex)
+							{
+								checksum += Chunk::CreateFromNoise(chunkIndex, { 0.015f, 12.0f }, 16, 18, 24).GetColumnHeight({ 0, 0 });
+							});
+					});
+				const double chunkMs = MeasureMilliseconds([&]()
+					{
+						forEachChunk([&](const Lattice2& chunkIndex) { checksum += generator.CreateChunk(chunkIndex).GetColumnHeight({ 0, 0 }); });
+					});
+				Check(checksum > 0, "Terrain checksum is 0");
+
+				const auto usPerChunk = [](double ms) { return ms * 1.0e3 / ChunkCount; };
+				return std::format(
+					"Terrain Heights ({} octaves) : single octave {:.1f} us / fractal {:.1f} us / fill {:.1f} us / cached {:.2f} us per chunk"
+					" / Chunk : single octave {:.1f} us / fractal {:.1f} us per chunk / tile {:.0f} KiB\n",
+					settings.octaveCount,
+					usPerChunk(singleOctaveMs), usPerChunk(fractalMs), usPerChunk(fillMs), usPerChunk(cachedMs),
+					usPerChunk(legacyChunkMs), usPerChunk(chunkMs),
+					(generator.GetMemoryUsage() - ForiverEngine::TerrainGenerator().GetMemoryUsage()) / 1024.0
+				);
+			}
+
+			static std::string Run_ChunkFill()
+			{
+				// 標準的な地形と、起伏の大きい地形 (地表のセクションが多い)
+				const Chunk::ColumnHeights heights = CreateTerrainChunk().CreateSurfaceMap().heights;
+				const TerrainGenerationSettings fractalSettings = TerrainGenerationSettings::CreateFractal();
+				const Chunk::ColumnHeights fractalHeights = ForiverEngine::TerrainGenerator::CalculateColumnHeights(fractalSettings, Lattice2(Chunk::Count / 2, Chunk::Count / 2));
+
+				const double legacyMs = MeasureMilliseconds([&]()
+					{
+						const Chunk chunk = CreateFromHeightsPerBlock(heights, 18, 24);
+					});
+				const double ms = MeasureMilliseconds([&]()
+					{
+						const Chunk chunk = Chunk::CreateFromHeights(heights, 18, 24);
+					});
+				const double fractalLegacyMs = MeasureMilliseconds([&]()
+					{
+						const Chunk chunk = CreateFromHeightsPerBlock(fractalHeights, fractalSettings.minDirtHeight, fractalSettings.minStoneHeight);
+					});
+				const double fractalMs = MeasureMilliseconds([&]()
+					{
+						const Chunk chunk = Chunk::CreateFromHeights(fractalHeights, fractalSettings.minDirtHeight, fractalSettings.minStoneHeight);
+					});
+
+				// 同じチャンクになる
+				const Chunk legacyChunk = CreateFromHeightsPerBlock(fractalHeights, fractalSettings.minDirtHeight, fractalSettings.minStoneHeight);
+				const Chunk chunk = Chunk::CreateFromHeights(fractalHeights, fractalSettings.minDirtHeight, fractalSettings.minStoneHeight);
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+						for (int y = 0; y <= chunk.GetMaxHeight() + 1; ++y)
+							Check(chunk.GetBlock({ x, y, z }) == legacyChunk.GetBlock({ x, y, z }), "Chunk Fill span != per-block");
+
+				return std::format(
+					"Chunk Fill : per-block {:.1f} us / span {:.1f} us (x{:.1f}) / fractal per-block {:.1f} us / span {:.1f} us (x{:.1f})\n",
+					legacyMs * 1.0e3, ms * 1.0e3, legacyMs / ms,
+					fractalLegacyMs * 1.0e3, fractalMs * 1.0e3, fractalLegacyMs / fractalMs
+				);
+			}
+
+			static std::string Run_Density()
+			{
+				// 3D の密度 (洞窟・オーバーハング) を、格子の間隔を変えて求める
+				// 間隔 1 は全ブロックでノイズを求める場合 (地表 + 盛る高さより上は、どの間隔でも求めない)
+				TerrainGenerationSettings settings = TerrainGenerationSettings::CreateFractal();
+				const Lattice2 chunkIndex = Lattice2(Chunk::Count / 2, Chunk::Count / 2);
+				const Chunk::ColumnHeights heights = ForiverEngine::TerrainGenerator::CalculateColumnHeights(settings, chunkIndex);
+
+				const auto measureMasks = [&](const Lattice3& stride)
+					{
+						settings.densityStride = stride;
+						return MeasureMilliseconds([&]()
+							{
+								const Chunk::ColumnMasks masks = ForiverEngine::TerrainGenerator::CalculateColumnMasks(settings, chunkIndex, heights);
+							});
+					};
+				const double fullMs = measureMasks(Lattice3(1, 1, 1));
+				const double fineMs = measureMasks(Lattice3(2, 4, 2));
+				const double coarseMs = measureMasks(Lattice3(4, 8, 4));
+
+				// チャンクの生成全体 (各列の高さはキャッシュ済み)
+				settings.densityStride = TerrainGenerationSettings{}.densityStride;
+				TerrainGenerationSettings heightOnlySettings = settings;
+				heightOnlySettings.overhangAmplitude = 0.0f;
+				heightOnlySettings.caveThreshold = 1.0f;
+				ForiverEngine::TerrainGenerator generator = ForiverEngine::TerrainGenerator(settings);
+				ForiverEngine::TerrainGenerator heightOnlyGenerator = ForiverEngine::TerrainGenerator(heightOnlySettings);
+				const double heightOnlyChunkMs = MeasureMilliseconds([&]()
+					{
+						const Chunk chunk = heightOnlyGenerator.CreateChunk(chunkIndex);
+					});
+				const double chunkMs = MeasureMilliseconds([&]()
+					{
+						const Chunk chunk = generator.CreateChunk(chunkIndex);
+					});
+
+				return std::format(
+					"Density : stride 1x1x1 {:.1f} us / 2x4x2 {:.1f} us / 4x8x4 {:.1f} us (x{:.1f}) per chunk"
+					" / Chunk : height only {:.1f} us / with density {:.1f} us\n",
+					fullMs * 1.0e3, fineMs * 1.0e3, coarseMs * 1.0e3, fullMs / coarseMs,
+					heightOnlyChunkMs * 1.0e3, chunkMs * 1.0e3
+				);
+			}
+
+			static std::string Run_FaceScan()
+			{
+				const Chunk chunk = CreateTerrainChunk();
+				const auto legacyArray = CopyToLegacyArray(chunk);
+				const auto contiguousArray = CopyToArrayND(chunk);
+
+				int legacyFaceCount = 0;
+				int contiguousFaceCount = 0;
+				int faceCount = 0;
+				int bitwiseFaceCount = 0;
+				const double legacyMs = MeasureMilliseconds([&]()
+					{
+						legacyFaceCount = CountExposedFaces([&](const Lattice3& p) { return legacyArray[p.x][p.y][p.z]; });
+					});
+				const double contiguousMs = MeasureMilliseconds([&]()
+					{
+						contiguousFaceCount = CountExposedFaces([&](const Lattice3& p) { return contiguousArray[p.x][p.y][p.z]; });
+					});
+				const double ms = MeasureMilliseconds([&]()
+					{
+						faceCount = CountExposedFaces([&](const Lattice3& p) { return chunk.GetBlock(p); });
+					});
+				const double bitwiseMs = MeasureMilliseconds([&]()
+					{
+						bitwiseFaceCount = CountExposedFacesByOccupancy(chunk);
+					});
+
+				Check(faceCount == legacyFaceCount, "Face Scan per-block != legacy");
+				Check(contiguousFaceCount == legacyFaceCount, "Face Scan ArrayND != legacy");
+				Check(bitwiseFaceCount == legacyFaceCount, "Face Scan bitwise != legacy");
+
+				return std::format(
+					"Face Scan ({} faces) : legacy {:.4f} ms / ArrayND {:.4f} ms / per-block {:.4f} ms / bitwise {:.4f} ms (x{:.1f})\n",
+					faceCount, legacyMs, contiguousMs, ms, bitwiseMs, ms / bitwiseMs
+				);
+			}
+
+			static std::string Run_CreateMesh()
+			{
+				const Chunk chunk = CreateTerrainChunk();
+
+				int vertexCount = 0;
+				std::size_t uploadSize = 0;
+				std::size_t legacyUploadSize = 0;
+				const double ms = MeasureMilliseconds([&]()
+					{
+						TerrainMesh mesh = chunk.CreateMesh();
+						vertexCount = static_cast<int>(mesh.vertices.size());
+						// インデックスは共有のものを使うので、頂点のみ
+						uploadSize = mesh.vertices.size() * sizeof(VertexDataTerrain);
+						// 以前の頂点データ (座標・UV値・法線などを全て float で持つ) と、チャンクごとのインデックスだった場合
+						legacyUploadSize = mesh.vertices.size() * sizeof(VertexData) + mesh.GetIndexCount() * sizeof(std::uint32_t);
+						Chunk::ReleaseMesh(std::move(mesh));
+					});
+
+				int greedyVertexCount = 0;
+				std::size_t greedyUploadSize = 0;
+				const double greedyMs = MeasureMilliseconds([&]()
+					{
+						TerrainMesh mesh = chunk.CreateMesh(ChunkMeshingMode::Greedy);
+						greedyVertexCount = static_cast<int>(mesh.vertices.size());
+						greedyUploadSize = mesh.vertices.size() * sizeof(VertexDataTerrain);
+						Chunk::ReleaseMesh(std::move(mesh));
+					});
+
+				const std::size_t vertexBytes = vertexCount * sizeof(VertexDataTerrain);
+				const std::size_t legacyVertexBytes = vertexCount * sizeof(VertexData);
+
+				return std::format(
+					"CreateMesh : per-face {} vertices, {:.1f} KiB, {:.4f} ms / greedy {} vertices, {:.1f} KiB, {:.4f} ms (x{:.1f} smaller)\n"
+					"Vertex Format : legacy {} B/vertex, {:.1f} KiB / packed {} B/vertex, {:.1f} KiB (vertices x{:.1f} / with per-chunk indices x{:.1f} smaller)\n",
+					vertexCount, uploadSize / 1024.0, ms,
+					greedyVertexCount, greedyUploadSize / 1024.0, greedyMs,
+					static_cast<double>(uploadSize) / greedyUploadSize,
+					sizeof(VertexData), legacyVertexBytes / 1024.0, sizeof(VertexDataTerrain), vertexBytes / 1024.0,
+					static_cast<double>(legacyVertexBytes) / vertexBytes, static_cast<double>(legacyUploadSize) / uploadSize
+				);
+			}
+
+			static std::string Run_Occlusion()
+			{
+				// メッシュ作成のうち、頂点の遮蔽 (環境遮蔽・空の遮蔽) の計算にかかる分
+				const Chunk chunk = CreateTerrainChunk();
+
+				const double meshMs = MeasureMilliseconds([&]()
+					{
+						TerrainMesh mesh = chunk.CreateMesh();
+						Chunk::ReleaseMesh(std::move(mesh));
+					});
+
+				// 見えている面の一覧は先に求めておき、遮蔽の計算 (周囲の列を集める + 面ごとに4頂点の遮蔽を求める) の分だけを計る
+				std::vector<std::pair<Lattice3, int>> faces = {};
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+						for (int wordIndex = 0; wordIndex < Chunk::OccupancyWordsPerColumn; ++wordIndex)
+						{
+							const auto faceMasks = chunk.CalculateExposedFaceMasks({ x, z }, wordIndex);
+							for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+								for (std::uint64_t mask = faceMasks[faceIndex]; mask != 0; mask &= mask - 1)
+									faces.emplace_back(Lattice3(x, (wordIndex << 6) + std::countr_zero(mask), z), faceIndex);
+						}
+
+				int occludedFaceCount = 0;
+				const double occlusionMs = MeasureMilliseconds([&]()
+					{
+						const Chunk::OcclusionGrid occlusionGrid = chunk.CalculateOcclusionGrid();
+						occludedFaceCount = 0;
+						for (const auto& [position, faceIndex] : faces)
+						{
+							occludedFaceCount += Chunk::CalculateFaceOcclusionKey(occlusionGrid, position, faceIndex) != 0;
+						}
+					});
+
+				return std::format(
+					"Occlusion ({} / {} faces occluded) : CreateMesh {:.4f} ms / occlusion only {:.4f} ms ({:.1f}% of meshing)\n",
+					occludedFaceCount, faces.size(), meshMs, occlusionMs, occlusionMs / meshMs * 100.0
+				);
+			}
+
+			static std::string Run_MeshSizing()
+			{
+				// 以前の見積もり (頂点 4096 個分)
+				constexpr std::size_t GuessedCapacity = 4096;
+				// 以前の作業用の配列 (プールから借りる、頂点 2^15 個分. 作成後に要素数に見合った配列に詰め替える)
+				constexpr std::size_t WorkCapacity = 1 << 15;
+
+				const Chunk chunk = CreateTerrainChunk();
+
+				std::vector<VertexDataTerrain> guessVertices = {};
+				std::size_t guessPeakBytes = 0;
+				int guessReallocationCount = 0;
+				const double guessMs = MeasureMilliseconds([&]()
+					{
+						std::vector<VertexDataTerrain> vertices = {};
+						vertices.reserve(GuessedCapacity);
+						CreateMeshByPushBack(chunk, vertices, guessPeakBytes, guessReallocationCount);
+						guessVertices = std::move(vertices);
+					});
+
+				std::size_t workPeakBytes = 0;
+				const double workMs = MeasureMilliseconds([&]()
+					{
+						std::vector<VertexDataTerrain> work = VectorPool<VertexDataTerrain>::Acquire(WorkCapacity);
+						std::size_t peakBytes = 0;
+						int reallocationCount = 0;
+						CreateMeshByPushBack(chunk, work, peakBytes, reallocationCount);
+						std::vector<VertexDataTerrain> vertices = VectorPool<VertexDataTerrain>::ShrinkToClass(std::move(work));
+						workPeakBytes = peakBytes + vertices.capacity() * sizeof(VertexDataTerrain);
+						VectorPool<VertexDataTerrain>::Release(std::move(vertices));
+					});
+
+				// 今のメッシュは、面の向きごとにまとめて並べる (向きの中では同じ順)
+				const auto getFaceLayoutSlot = [](const VertexDataTerrain& vertex) { return TerrainMesh::FaceLayoutSlots[TerrainVertex::Decode(vertex).faceIndex]; };
+				std::stable_sort(guessVertices.begin(), guessVertices.end(),
+					[&](const VertexDataTerrain& a, const VertexDataTerrain& b) { return getFaceLayoutSlot(a) < getFaceLayoutSlot(b); });
+
+				std::size_t exactBytes = 0;
+				std::size_t peakBytes = 0;
+				bool isSameMesh = false;
+				const double ms = MeasureMilliseconds([&]()
+					{
+						TerrainMesh mesh = chunk.CreateMesh();
+						exactBytes = mesh.vertices.size() * sizeof(VertexDataTerrain);
+						peakBytes = mesh.vertices.capacity() * sizeof(VertexDataTerrain);
+						isSameMesh = IsSameMeshIgnoringOcclusion(mesh.vertices, guessVertices);
+						Chunk::ReleaseMesh(std::move(mesh));
+					});
+
+				// 作り方によらず、同じ頂点が (面の向きごとに) 同じ順に並ぶ (以前のメッシュには遮蔽が無いので、遮蔽のビットは除く)
+				Check(isSameMesh, "Mesh Sizing meshes differ");
+
+				return std::format(
+					"Mesh Sizing ({:.1f} KiB) : guess {:.4f} ms, peak {:.1f} KiB, {} reallocs / work buffer {:.4f} ms, peak {:.1f} KiB / two-pass {:.4f} ms, peak {:.1f} KiB\n",
+					exactBytes / 1024.0,
+					guessMs, guessPeakBytes / 1024.0, guessReallocationCount,
+					workMs, workPeakBytes / 1024.0,
+					ms, peakBytes / 1024.0
+				);
+			}
+
+			static std::string Run_SectionRemesh()
+			{
+				// 地表のブロックを1つ掘った時の、メッシュの作り直し
+				Chunk chunk = CreateTerrainChunk();
+				const Lattice2 positionXZ = Lattice2(8, 8);
+				const Lattice3 position = Lattice3(positionXZ.x, chunk.GetFloorHeight(positionXZ), positionXZ.y);
+				const Block originalBlock = chunk.GetBlock(position);
+				Chunk::SectionMeshes meshes = chunk.CreateSectionMeshes(ChunkMeshingMode::PerFace, Chunk::CaptureNeighborBorders(&chunk, &chunk, &chunk, &chunk));
+
+				// 以前は、チャンク全体を作り直していた
+				const double chunkMs = MeasureMilliseconds([&]()
+					{
+						TerrainMesh mesh = chunk.CreateMesh();
+						Chunk::ReleaseMesh(std::move(mesh));
+					});
+
+				// 1回の編集 (ChunksManager::UpdateChunkBlock() と同じ流れ) : 書き換え → 影響するセクションを求める → 境界を1度だけ写し取る → そのセクションのみ作り直す
+				// 掘る・埋め戻すを交互に行う
+				Chunk::SectionMask sectionMask = 0;
+				bool isDug = false;
+				const double editMs = MeasureMilliseconds([&]()
+					{
+						const int oldColumnHeight = chunk.GetColumnHeight(positionXZ);
+						isDug = !isDug;
+						chunk.SetBlock(position, isDug ? Block::Air : originalBlock);
+						sectionMask = Chunk::GetSectionsAffectedByBlock(position, oldColumnHeight, chunk.GetColumnHeight(positionXZ));
+						chunk.RecreateSectionMeshes(meshes, sectionMask, ChunkMeshingMode::PerFace, Chunk::CaptureNeighborBorders(&chunk, &chunk, &chunk, &chunk));
+					});
+
+				int vertexCount = 0;
+				Chunk::ForEachSection(sectionMask, [&](int sectionIndex) { vertexCount += static_cast<int>(meshes[sectionIndex].vertices.size()); });
+				Chunk::ReleaseSectionMeshes(std::move(meshes));
+
+				return std::format(
+					"Section Remesh (1 edit) : chunk {:.2f} us / edit {:.2f} us ({} section(s), {} vertices) (x{:.1f})\n",
+					chunkMs * 1000.0, editMs * 1000.0, std::popcount(sectionMask), vertexCount, chunkMs / editMs
+				);
+			}
+
+			static std::string Run_Lod()
+			{
+				const Lattice2 center = Lattice2(Chunk::Count / 2, Chunk::Count / 2);
+				const ChunkLodSettings lodSettings = {};
+				const int outerDistance = lodSettings.GetOuterDistance();
+
+				// 描画範囲内は、全て詳細に描画する
+				std::size_t fullVertexCount = 0;
+				for (int dx = -Chunk::DrawDistance; dx <= Chunk::DrawDistance; ++dx)
+					for (int dz = -Chunk::DrawDistance; dz <= Chunk::DrawDistance; ++dz)
+					{
+						TerrainMesh mesh = Chunk::CreateFromNoise(center + Lattice2(dx, dz), { 0.015f, 12.0f }, 16, 18, 24).CreateMesh();
+						fullVertexCount += mesh.vertices.size();
+						Chunk::ReleaseMesh(std::move(mesh));
+					}
+
+				// その外側は、LOD で描画する
+				// チャンクごとのメッシュは、リージョン・レベルごと (キー : リージョンのインデックス * LevelCount + レベル) にまとめて描画する
+				std::size_t lodVertexCount = 0;
+				int lodChunkCount = 0;
+				std::map<int, std::vector<TerrainMesh>> groupMeshes = {};
+				std::map<int, std::vector<Lattice2>> groupChunkOffsets = {};
+				const auto begin = std::chrono::steady_clock::now();
+				for (int dx = -outerDistance; dx <= outerDistance; ++dx)
+					for (int dz = -outerDistance; dz <= outerDistance; ++dz)
+					{
+						const int level = lodSettings.GetLevel(std::max(std::abs(dx), std::abs(dz)));
+						if (level <= 0)
+							continue;
+
+						const Lattice2 chunkIndex = center + Lattice2(dx, dz);
+						const Chunk::SurfaceMap surfaceMap = Chunk::CreateSurfaceMapFromNoise(chunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+						TerrainMesh mesh = Chunk::CreateLodMesh(surfaceMap, level);
+						lodVertexCount += mesh.vertices.size();
+						++lodChunkCount;
+
+						const Lattice2 regionIndex = Lattice2(chunkIndex.x / Chunk::RegionSize, chunkIndex.y / Chunk::RegionSize);
+						const int groupKey = (regionIndex.x * (Chunk::Count / Chunk::RegionSize) + regionIndex.y) * ChunkLodSettings::LevelCount + level;
+						groupMeshes[groupKey].push_back(std::move(mesh));
+						groupChunkOffsets[groupKey].push_back(chunkIndex - regionIndex * Chunk::RegionSize);
+					}
+				const auto end = std::chrono::steady_clock::now();
+				const double lodMs = std::chrono::duration<double, std::milli>(end - begin).count();
+
+				// まとめる前は1チャンク1回、まとめた後は1グループ1回 (共有のインデックスバッファより多い四角形は分ける) 描画する
+				std::size_t mergedVertexCount = 0;
+				int lodDrawCount = 0;
+				int mergedDrawCount = 0;
+				const auto mergeBegin = std::chrono::steady_clock::now();
+				for (auto& [groupKey, meshes] : groupMeshes)
+				{
+					std::vector<const TerrainMesh*> meshPointers = {};
+					for (const TerrainMesh& mesh : meshes)
+					{
+						meshPointers.push_back(&mesh);
+						if (!mesh.vertices.empty())
+							++lodDrawCount;
+					}
+
+					TerrainMesh merged = Chunk::MergeLodMeshes(meshPointers, groupChunkOffsets[groupKey]);
+					mergedVertexCount += merged.vertices.size();
+					mergedDrawCount += (merged.GetQuadCount() + Chunk::MaxMeshQuadCount - 1) / Chunk::MaxMeshQuadCount;
+					Chunk::ReleaseMesh(std::move(merged));
+					for (TerrainMesh& mesh : meshes)
+						Chunk::ReleaseMesh(std::move(mesh));
+				}
+				const auto mergeEnd = std::chrono::steady_clock::now();
+				const double mergeMs = std::chrono::duration<double, std::milli>(mergeEnd - mergeBegin).count();
+
+				Check(mergedVertexCount == lodVertexCount, "LOD merged vertices != LOD vertices");
+
+				// LOD 無しで、同じ範囲を全て詳細に描画した場合 (1チャンクあたりの頂点数は同程度とする)
+				const int fullChunkCount = Chunk::DrawCountMax * Chunk::DrawCountMax;
+				const int outerChunkCount = (outerDistance * 2 + 1) * (outerDistance * 2 + 1);
+				const double fullOuterVertexCount = static_cast<double>(fullVertexCount) / fullChunkCount * outerChunkCount;
+
+				return std::format(
+					"LOD (radius {} -> {}) : full {} chunks, {} vertices / + LOD {} chunks, {} vertices, {} draws -> {} draws merged in {} groups (total x{:.2f}, full detail at radius {} would be x{:.1f}), build {:.2f} us/chunk, merge {:.3f} ms\n",
+					Chunk::DrawDistance, outerDistance, fullChunkCount, fullVertexCount, lodChunkCount, lodVertexCount,
+					lodDrawCount, mergedDrawCount, groupMeshes.size(),
+					static_cast<double>(fullVertexCount + lodVertexCount) / fullVertexCount,
+					outerDistance, fullOuterVertexCount / fullVertexCount,
+					lodMs * 1000.0 / lodChunkCount, mergeMs
+				);
+			}
+
+			static std::string Run_FaceCulling()
+			{
+				// 描画範囲のチャンクのセクションごとのメッシュを、プレイヤーの視点・太陽の向きから見て描画する三角形の数
+				const Lattice2 center = Lattice2(Chunk::Count / 2, Chunk::Count / 2);
+				const Chunk centerChunk = Chunk::CreateFromNoise(center, { 0.015f, 12.0f }, 16, 18, 24);
+				const Vector3 eyePosition = Chunk::GetOriginWorldPosition(center)
+					+ Vector3(8.0f, centerChunk.GetFloorHeight({ 8, 8 }) + 2.6f, 8.0f);
+				const std::array<TerrainFaceCulling, 3> cullings =
+				{
+					TerrainFaceCulling{},
+					TerrainFaceCulling::CreatePerspective(eyePosition),
+					TerrainFaceCulling::CreateOrthographic(Vector3(1.0f, -1.0f, 1.0f).Normed()),
+				};
+				std::array<std::size_t, 3> triangleCounts = {};
+				std::array<int, 3> drawCounts = {};
+				// 同じセクションの範囲を、間の見えない向きごと1回にまとめた場合 (ChunksManager::PackDrawCommands() と同じ. 間の面は裏面カリングで捨てられる)
+				std::array<std::size_t, 3> mergedTriangleCounts = {};
+				std::array<int, 3> mergedDrawCounts = {};
+
+				for (int dx = -Chunk::DrawDistance; dx <= Chunk::DrawDistance; ++dx)
+					for (int dz = -Chunk::DrawDistance; dz <= Chunk::DrawDistance; ++dz)
+					{
+						const Lattice2 chunkIndex = center + Lattice2(dx, dz);
+						Chunk::SectionMeshes meshes = Chunk::CreateFromNoise(chunkIndex, { 0.015f, 12.0f }, 16, 18, 24).CreateSectionMeshes();
+						const Vector3 origin = Chunk::GetOriginWorldPosition(chunkIndex);
+						for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+						{
+							const Vector3 boundsMin = origin + Vector3(0, sectionIndex * Chunk::SectionHeight, 0) - Vector3::One() * 0.5f;
+							const Vector3 boundsMax = origin + Vector3(Chunk::Size, (sectionIndex + 1) * Chunk::SectionHeight, Chunk::Size) - Vector3::One() * 0.5f;
+							for (std::size_t i = 0; i < cullings.size(); ++i)
+							{
+								int mergedBegin = -1;
+								int mergedEnd = -1;
+								TerrainMesh::ForEachFaceRange(meshes[sectionIndex].faceQuadOffsets, cullings[i].CalculateVisibleFaceBits(boundsMin, boundsMax),
+									[&](int firstQuad, int quadCount)
+									{
+										triangleCounts[i] += static_cast<std::size_t>(quadCount) * 2;
+										++drawCounts[i];
+										if (mergedBegin < 0)
+											mergedBegin = firstQuad;
+										mergedEnd = firstQuad + quadCount;
+									});
+								if (mergedBegin >= 0)
+								{
+									mergedTriangleCounts[i] += static_cast<std::size_t>(mergedEnd - mergedBegin) * 2;
+									++mergedDrawCounts[i];
+								}
+							}
+						}
+						Chunk::ReleaseSectionMeshes(std::move(meshes));
+					}
+
+				// 見える向きの範囲ごとに描画するとドローコールが増えるので、まとめた後の数が、カリングしない場合を超えないことを確かめる
+				Check(mergedDrawCounts[1] <= drawCounts[0] && mergedDrawCounts[2] <= drawCounts[0], "Face Culling merged draws > unculled draws");
+
+				return std::format(
+					"Face Culling : none {} triangles, {} draws / camera {} triangles (x{:.2f}), {} draws -> merged {} draws, {} triangles submitted (x{:.2f}) / sun {} triangles (x{:.2f}), {} draws -> merged {} draws, {} triangles submitted (x{:.2f})\n",
+					triangleCounts[0], drawCounts[0],
+					triangleCounts[1], static_cast<double>(triangleCounts[1]) / triangleCounts[0], drawCounts[1],
+					mergedDrawCounts[1], mergedTriangleCounts[1], static_cast<double>(mergedTriangleCounts[1]) / triangleCounts[0],
+					triangleCounts[2], static_cast<double>(triangleCounts[2]) / triangleCounts[0], drawCounts[2],
+					mergedDrawCounts[2], mergedTriangleCounts[2], static_cast<double>(mergedTriangleCounts[2]) / triangleCounts[0]
+				);
+			}
+
+			static std::string Run_Memory()
+			{
+				const Chunk chunk = CreateTerrainChunk();
+
+				// 圧縮前は、1ブロックにつき sizeof(Block) バイトを使う
+				constexpr std::size_t RawBytes = sizeof(Block) * Chunk::Volume;
+
+				return std::format(
+					"Memory : raw {:.1f} KiB / current {:.1f} KiB ({:.2f} bit/block)\n",
+					RawBytes / 1024.0, chunk.GetMemoryUsage() / 1024.0, chunk.GetBitsPerBlock()
+				);
+			}
+
+			static std::string Run_ChunksManagerStartup()
+			{
+				// 旧来は、全チャンク分の配列を5つ、最初に確保していた
+				// (旧来のチャンクは、ブロックの3重ポインタ配列のみを持つ)
+				const double legacyMs = MeasureMilliseconds([]()
+					{
+						const auto generationStates = HeapMultiDimAllocator::CreateArray2D<std::atomic<std::uint8_t>>(Chunk::Count, Chunk::Count);
+						const auto chunks = HeapMultiDimAllocator::CreateArray2D<HeapMultiDimAllocator::Array3D<Block>>(Chunk::Count, Chunk::Count);
+						const auto meshes = HeapMultiDimAllocator::CreateArray2D<Mesh>(Chunk::Count, Chunk::Count);
+						const auto vbvs = HeapMultiDimAllocator::CreateArray2D<VertexBufferView>(Chunk::Count, Chunk::Count);
+						const auto ibvs = HeapMultiDimAllocator::CreateArray2D<IndexBufferView>(Chunk::Count, Chunk::Count);
+					});
+				const double ms = MeasureMilliseconds([]()
+					{
+						const ChunksManager chunksManager = ChunksManager(Lattice2(Chunk::Count / 2, Chunk::Count / 2));
+					});
+
+				return std::format(
+					"ChunksManager Startup : legacy {:.3f} ms / current {:.3f} ms\n",
+					legacyMs, ms
+				);
+			}
+
+			static std::string Run_Pool()
+			{
+				// チャンク・メッシュの生成と破棄を繰り返す (アンロード・再生成を模す)
+				const auto GenerateAndDiscard = []()
+					{
+						const Chunk chunk = CreateTerrainChunk();
+						TerrainMesh mesh = chunk.CreateMesh();
+						Chunk::ReleaseMesh(std::move(mesh));
+					};
+
+				// 1周目でプールが温まる
+				GenerateAndDiscard();
+
+				const auto wordsBefore = VectorPool<std::uint64_t>::GetStats();
+				const auto verticesBefore = VectorPool<VertexDataTerrain>::GetStats();
+				const double ms = MeasureMilliseconds(GenerateAndDiscard);
+				const auto wordsAfter = VectorPool<std::uint64_t>::GetStats();
+				const auto verticesAfter = VectorPool<VertexDataTerrain>::GetStats();
+
+				const std::uint64_t hitCount = (wordsAfter.hitCount - wordsBefore.hitCount)
+					+ (verticesAfter.hitCount - verticesBefore.hitCount);
+				const std::uint64_t missCount = (wordsAfter.missCount - wordsBefore.missCount)
+					+ (verticesAfter.missCount - verticesBefore.missCount);
+
+				// 温まった後は、プールから全て賄える
+				Check(missCount == 0, "Pool missed after warm-up");
+
+				// 保持する量は、バイト数の上限 (共有の保管庫 + スレッドごと) を超えない
+				const std::size_t threadCount = static_cast<std::size_t>(ThreadPool::GetWorkerCount()) + 1;
+				const std::size_t retainedBytes = wordsAfter.retainedBytes + verticesAfter.retainedBytes;
+				Check(wordsAfter.retainedBytes <= VectorPool<std::uint64_t>::SharedCacheCapacityBytes + VectorPool<std::uint64_t>::LocalCacheCapacityBytes * threadCount
+					&& verticesAfter.retainedBytes <= VectorPool<VertexDataTerrain>::SharedCacheCapacityBytes + VectorPool<VertexDataTerrain>::LocalCacheCapacityBytes * threadCount,
+					"Pool retained over the byte cap");
+
+				return std::format(
+					"Pool (generate + mesh + discard) : {:.3f} ms, hit {} / miss {}, retained {:.1f} MiB\n",
+					ms, hitCount, missCount, retainedBytes / (1024.0 * 1024.0)
+				);
+			}
+		};
+	}
+}
\ No newline at end of file
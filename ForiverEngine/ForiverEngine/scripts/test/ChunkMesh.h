@@ -0,0 +1,952 @@
+﻿#pragma once
+
+#include <scripts/test/IncludeInternal.h>
+
+namespace ForiverEngine
+{
+	namespace Test
+	{
+		struct ChunkMesh final
+		{
+		public:
+			DELETE_DEFAULT_METHODS(ChunkMesh);
+
+			static void RunAll()
+			{
+				Run_Greedy_Void();
+				Run_Greedy_Terrain();
+				Run_Greedy_Edited();
+				Run_Greedy_UVTiling();
+				Run_NeighborBorders();
+				Run_PackedVertex_RoundTrip();
+				Run_PackedVertex_Reconstruction();
+				Run_SharedQuadIndices();
+				Run_SectionMeshes_MatchChunkMesh();
+				Run_SectionMeshes_IncrementalEdit();
+				Run_SectionMeshes_ColumnTopEdit();
+				Run_LodMesh_SurfaceMap();
+				Run_LodMesh_Coverage();
+				Run_LodMesh_Merge();
+				Run_FaceRanges();
+				Run_FaceCulling();
+				Run_Occlusion_MatchesReference();
+				Run_Occlusion_Shapes();
+				Run_Occlusion_DiagonalFlip();
+			}
+
+#pragma region Helpers
+
+			static constexpr Lattice2 TestChunkIndex = Lattice2(Chunk::Count / 2, Chunk::Count / 2);
+
+			// 1ブロック分の面 (法線 xyz, ブロック座標 xyz, テクスチャのインデックス)
+			using UnitFace = std::array<int, 7>;
+
+			// メッシュが覆う範囲を、1ブロック分の面の一覧に分解する (ソート済み)
+			// 四角形は、連続する4頂点で1枚とする
+			static std::vector<UnitFace> DecomposeToUnitFaces(const TerrainMesh& mesh)
+			{
+				std::vector<UnitFace> unitFaces = {};
+				for (std::size_t quadBegin = 0; quadBegin + 4 <= mesh.vertices.size(); quadBegin += 4)
+				{
+					const TerrainVertex::Decoded first = TerrainVertex::Decode(mesh.vertices[quadBegin]);
+					const Lattice3& normal = TerrainVertex::FaceNormals[first.faceIndex];
+
+					Lattice3 cornerMin = first.cornerPosition;
+					Lattice3 cornerMax = cornerMin;
+					for (std::size_t i = quadBegin; i < quadBegin + 4; ++i)
+					{
+						const TerrainVertex::Decoded decoded = TerrainVertex::Decode(mesh.vertices[i]);
+						eq(decoded.faceIndex, first.faceIndex);
+						eq(decoded.texIndex, first.texIndex);
+
+						const Lattice3& p = decoded.cornerPosition;
+						cornerMin = Lattice3(std::min(cornerMin.x, p.x), std::min(cornerMin.y, p.y), std::min(cornerMin.z, p.z));
+						cornerMax = Lattice3(std::max(cornerMax.x, p.x), std::max(cornerMax.y, p.y), std::max(cornerMax.z, p.z));
+					}
+
+					// 格子点の範囲 -> ブロックの範囲 (面に垂直な軸は、法線が正なら1つ戻す)
+					const auto toBlockRange = [](int min, int max, int normalComponent)
+						{
+							if (normalComponent != 0)
+							{
+								const int block = (normalComponent > 0) ? min - 1 : min;
+								return Lattice2(block, block);
+							}
+							return Lattice2(min, max - 1);
+						};
+					const Lattice2 rangeX = toBlockRange(cornerMin.x, cornerMax.x, normal.x);
+					const Lattice2 rangeY = toBlockRange(cornerMin.y, cornerMax.y, normal.y);
+					const Lattice2 rangeZ = toBlockRange(cornerMin.z, cornerMax.z, normal.z);
+
+					for (int x = rangeX.x; x <= rangeX.y; ++x)
+						for (int y = rangeY.x; y <= rangeY.y; ++y)
+							for (int z = rangeZ.x; z <= rangeZ.y; ++z)
+								unitFaces.push_back({ normal.x, normal.y, normal.z, x, y, z, static_cast<int>(first.texIndex) });
+				}
+
+				std::sort(unitFaces.begin(), unitFaces.end());
+				return unitFaces;
+			}
+
+			// 面ごとのメッシュと貪欲メッシュで、見える範囲とテクスチャが一致するか調べる
+			// 貪欲メッシュの頂点数を返す
+			static int CheckGreedyCoverage(const Chunk& chunk)
+			{
+				TerrainMesh perFaceMesh = chunk.CreateMesh(ChunkMeshingMode::PerFace);
+				TerrainMesh greedyMesh = chunk.CreateMesh(ChunkMeshingMode::Greedy);
+
+				const std::vector<UnitFace> perFaceUnitFaces = DecomposeToUnitFaces(perFaceMesh);
+				const std::vector<UnitFace> greedyUnitFaces = DecomposeToUnitFaces(greedyMesh);
+				eq(greedyUnitFaces.size(), perFaceUnitFaces.size());
+				eq(greedyUnitFaces == perFaceUnitFaces, true);
+
+				// 4頂点ずつの四角形のみで、共有のインデックスバッファに収まる
+				eq(greedyMesh.vertices.size() % TerrainMesh::VerticesPerQuad, static_cast<std::size_t>(0));
+				eq(perFaceMesh.GetQuadCount() <= Chunk::MaxMeshQuadCount, true);
+
+				const int greedyVertexCount = static_cast<int>(greedyMesh.vertices.size());
+				Chunk::ReleaseMesh(std::move(perFaceMesh));
+				Chunk::ReleaseMesh(std::move(greedyMesh));
+				return greedyVertexCount;
+			}
+
+			// セクションごとのメッシュを、1ブロック分の面の一覧に分解してまとめる (ソート済み)
+			// 各セクションの面が、そのセクションの高さの範囲に収まっているかも調べる
+			static std::vector<UnitFace> DecomposeSectionsToUnitFaces(const Chunk::SectionMeshes& meshes)
+			{
+				std::vector<UnitFace> unitFaces = {};
+				for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+				{
+					for (const UnitFace& unitFace : DecomposeToUnitFaces(meshes[sectionIndex]))
+					{
+						eq(Chunk::GetSectionIndex(unitFace[4]), sectionIndex);
+						unitFaces.push_back(unitFace);
+					}
+				}
+
+				std::sort(unitFaces.begin(), unitFaces.end());
+				return unitFaces;
+			}
+
+			// 四角形が面の向きごとにまとまって並び、faceQuadOffsets がその範囲を指しているか調べる
+			static void CheckFaceQuadOffsets(const TerrainMesh& mesh)
+			{
+				eq(mesh.faceQuadOffsets[0], 0);
+				eq(mesh.faceQuadOffsets[TerrainVertex::FaceCount], mesh.GetQuadCount());
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+				{
+					eq(mesh.GetFaceQuadCount(faceIndex) >= 0, true);
+					for (int quad = mesh.GetFaceQuadBegin(faceIndex); quad < mesh.GetFaceQuadBegin(faceIndex) + mesh.GetFaceQuadCount(faceIndex); ++quad)
+						for (int corner = 0; corner < TerrainMesh::VerticesPerQuad; ++corner)
+							eq(TerrainVertex::Decode(mesh.vertices[static_cast<std::size_t>(quad) * TerrainMesh::VerticesPerQuad + corner]).faceIndex, faceIndex);
+				}
+			}
+
+			// ブロックを1つずつ調べて、面の頂点の遮蔽を求める (CalculateFaceCornerOcclusions() の確認用)
+			// チャンクの外は、隣接チャンク (Right, Left, Forward, Backward, RightForward, RightBackward, LeftForward, LeftBackward の順. nullptr なら何も無い) を見る
+			// ワールドの下 (y < 0) は、不透明ではないが空は見えないとする
+			static std::array<std::uint32_t, 4> CalculateReferenceCornerOcclusions(
+				const Chunk& chunk, const std::array<const Chunk*, 8>& neighborChunks, const Lattice3& position, int faceIndex)
+			{
+				// マスの (不透明か, 空が見えないか)
+				const auto lookUp = [&](const Lattice3& cell) -> std::pair<bool, bool>
+					{
+						if (cell.y < 0)
+							return { false, true };
+
+						const bool isOutsideX = cell.x < 0 || cell.x >= Chunk::Size;
+						const bool isOutsideZ = cell.z < 0 || cell.z >= Chunk::Size;
+						const Chunk* target = &chunk;
+						Lattice3 local = cell;
+						if (isOutsideX && isOutsideZ)
+						{
+							target = neighborChunks[4 + ((cell.x >= Chunk::Size) ? 0 : 2) + ((cell.z >= Chunk::Size) ? 0 : 1)];
+							local.x = (cell.x >= Chunk::Size) ? 0 : Chunk::Size - 1;
+							local.z = (cell.z >= Chunk::Size) ? 0 : Chunk::Size - 1;
+						}
+						else if (isOutsideX)
+						{
+							target = neighborChunks[(cell.x >= Chunk::Size) ? 0 : 1];
+							local.x = (cell.x >= Chunk::Size) ? 0 : Chunk::Size - 1;
+						}
+						else if (isOutsideZ)
+						{
+							target = neighborChunks[(cell.z >= Chunk::Size) ? 2 : 3];
+							local.z = (cell.z >= Chunk::Size) ? 0 : Chunk::Size - 1;
+						}
+						if (!target)
+							return { false, false };
+
+						const bool isOpaque = (local.y < Chunk::Height) && BlockProperties::IsOpaque(target->GetBlock(local));
+						const bool isHidden = local.y <= target->GetColumnHeight({ local.x, local.z });
+						return { isOpaque, isHidden };
+					};
+
+				const Lattice3& normal = TerrainVertex::FaceNormals[faceIndex];
+				const Lattice3 front = position + normal;
+				const Lattice3 tangentU = (normal.x != 0) ? Lattice3::Up() : Lattice3::Right();
+				const Lattice3 tangentV = (normal.z != 0) ? Lattice3::Up() : Lattice3::Forward();
+
+				std::array<std::uint32_t, 4> occlusions = {};
+				for (int corner = 0; corner < 4; ++corner)
+				{
+					// 格子点は、ブロックの中心から見て各接線の正負どちらの側にあるか
+					const int (&offset)[3] = TerrainVertex::FaceCornerOffsets[faceIndex][corner];
+					const int signU = (offset[0] * tangentU.x + offset[1] * tangentU.y + offset[2] * tangentU.z) * 2 - 1;
+					const int signV = (offset[0] * tangentV.x + offset[1] * tangentV.y + offset[2] * tangentV.z) * 2 - 1;
+
+					const auto [frontOpaque, frontHidden] = lookUp(front);
+					const auto [side1Opaque, side1Hidden] = lookUp(front + tangentU * signU);
+					const auto [side2Opaque, side2Hidden] = lookUp(front + tangentV * signV);
+					const auto [diagonalOpaque, diagonalHidden] = lookUp(front + tangentU * signU + tangentV * signV);
+					eq(frontOpaque, false);
+
+					const int ambientOcclusion = (side1Opaque && side2Opaque)
+						? TerrainVertex::MaxAmbientOcclusion
+						: static_cast<int>(side1Opaque) + static_cast<int>(side2Opaque) + static_cast<int>(diagonalOpaque);
+					const int skyOcclusion = static_cast<int>(frontHidden) + static_cast<int>(side1Hidden) + static_cast<int>(side2Hidden) + static_cast<int>(diagonalHidden);
+					occlusions[corner] = TerrainVertex::EncodeOcclusion(ambientOcclusion, skyOcclusion);
+				}
+				return occlusions;
+			}
+
+#pragma endregion
+
+			static void Run_Greedy_Void()
+			{
+				CheckGreedyCoverage(Chunk::CreateVoid());
+			}
+
+			static void Run_Greedy_Terrain()
+			{
+				const Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				const int perFaceVertexCount = static_cast<int>(chunk.CreateMesh().vertices.size());
+				const int greedyVertexCount = CheckGreedyCoverage(chunk);
+
+				// 平坦な地形なので、大きく減るはず
+				eq(greedyVertexCount * 5 <= perFaceVertexCount, true);
+			}
+
+			static void Run_Greedy_Edited()
+			{
+				// テクスチャが違う面はまとめない・穴を掘った面は分割される
+				Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				for (int x = 2; x < 14; x += 3)
+					for (int z = 1; z < 15; z += 2)
+					{
+						const int floorHeight = chunk.GetFloorHeight({ x, z });
+						chunk.SetBlock({ x, floorHeight, z }, Block::Air);
+						chunk.SetBlock({ x, floorHeight + 3, z }, (x + z) % 2 == 0 ? Block::Stone : Block::Sand);
+					}
+				for (int y = 0; y < 8; ++y)
+					chunk.SetBlock({ 0, y, 0 }, Block::Air);
+
+				CheckGreedyCoverage(chunk);
+			}
+
+			static void Run_Greedy_UVTiling()
+			{
+				// 5 x 3 の平らな床 -> 上面は1枚にまとまり、UV値の幅はブロック数に合わせて伸びる
+				Chunk chunk = Chunk::CreateVoid();
+				for (int x = 0; x < 5; ++x)
+					for (int z = 0; z < 3; ++z)
+						chunk.SetBlock({ x, 0, z }, Block::Grass);
+
+				TerrainMesh greedyMesh = chunk.CreateMesh(ChunkMeshingMode::Greedy);
+				CheckGreedyCoverage(chunk);
+
+				bool hasFoundUp = false;
+				for (std::size_t quadBegin = 0; quadBegin + 4 <= greedyMesh.vertices.size(); quadBegin += 4)
+				{
+					if (TerrainVertex::Decode(greedyMesh.vertices[quadBegin]).faceIndex != 0) // Up
+						continue;
+
+					hasFoundUp = true;
+					Vector2 uvMin = TerrainVertex::CalculateUV(TerrainVertex::Decode(greedyMesh.vertices[quadBegin]));
+					Vector2 uvMax = uvMin;
+					for (std::size_t i = quadBegin; i < quadBegin + 4; ++i)
+					{
+						const Vector2 uv = TerrainVertex::CalculateUV(TerrainVertex::Decode(greedyMesh.vertices[i]));
+						uvMin = Vector2(std::min(uvMin.x, uv.x), std::min(uvMin.y, uv.y));
+						uvMax = Vector2(std::max(uvMax.x, uv.x), std::max(uvMax.y, uv.y));
+					}
+					eq(uvMax.x - uvMin.x, 5.0f);
+					eq(uvMax.y - uvMin.y, 3.0f);
+				}
+				eq(hasFoundUp, true);
+
+				// 上・下・側面4つの、6枚のみ
+				eq(greedyMesh.vertices.size(), static_cast<std::size_t>(6 * 4));
+
+				Chunk::ReleaseMesh(std::move(greedyMesh));
+			}
+
+			static void Run_NeighborBorders()
+			{
+				// 高さ4の平らな地面. 周りも同じチャンクなら、境界の側面は全て隠れる
+				Chunk chunk = Chunk::CreateVoid();
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+						for (int y = 0; y < 4; ++y)
+							chunk.SetBlock({ x, y, z }, Block::Stone);
+
+				constexpr int TopBottomFaceCount = Chunk::Size * Chunk::Size * 2;
+				constexpr int SideFaceCount = Chunk::Size * 4 * 4;
+
+				// 隣接チャンクなし -> 側面は見えている
+				{
+					const TerrainMesh mesh = chunk.CreateMesh();
+					eq(static_cast<int>(mesh.vertices.size()), (TopBottomFaceCount + SideFaceCount) * 4);
+				}
+
+				// 4方向とも隣接 -> 側面は全て隠れる (面ごと・貪欲で同じ範囲)
+				{
+					const Chunk::NeighborBorders neighbors = Chunk::CaptureNeighborBorders(&chunk, &chunk, &chunk, &chunk);
+					TerrainMesh perFaceMesh = chunk.CreateMesh(ChunkMeshingMode::PerFace, neighbors);
+					TerrainMesh greedyMesh = chunk.CreateMesh(ChunkMeshingMode::Greedy, neighbors);
+					eq(static_cast<int>(perFaceMesh.vertices.size()), TopBottomFaceCount * 4);
+					eq(DecomposeToUnitFaces(greedyMesh) == DecomposeToUnitFaces(perFaceMesh), true);
+					Chunk::ReleaseMesh(std::move(perFaceMesh));
+					Chunk::ReleaseMesh(std::move(greedyMesh));
+				}
+
+				// Right だけ隣接し、隣接チャンクの境界の列に穴がある -> その分だけ見える
+				{
+					Chunk rightChunk = Chunk::CreateVoid();
+					for (int x = 0; x < Chunk::Size; ++x)
+						for (int z = 0; z < Chunk::Size; ++z)
+							for (int y = 0; y < 4; ++y)
+								rightChunk.SetBlock({ x, y, z }, Block::Stone);
+					rightChunk.SetBlock({ 0, 2, 7 }, Block::Air);
+
+					const Chunk::NeighborBorders neighbors = Chunk::CaptureNeighborBorders(&rightChunk, nullptr, nullptr, nullptr);
+					const TerrainMesh mesh = chunk.CreateMesh(ChunkMeshingMode::PerFace, neighbors);
+					eq(static_cast<int>(mesh.vertices.size()), (TopBottomFaceCount + SideFaceCount / 4 * 3 + 1) * 4);
+				}
+			}
+
+			static void Run_PackedVertex_RoundTrip()
+			{
+				// 8バイトに収まる
+				eq(sizeof(VertexDataTerrain), static_cast<std::size_t>(8));
+
+				// チャンク内の全ての格子点・面・頂点番号で、詰めて戻すと元に戻る
+				for (int x = 0; x <= Chunk::Size; ++x)
+					for (int y = 0; y <= Chunk::Height; ++y)
+						for (int z = 0; z <= Chunk::Size; ++z)
+							for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+								for (int corner = 0; corner < 4; ++corner)
+								{
+									const std::uint32_t texIndex = static_cast<std::uint32_t>((x + y + z + faceIndex) % BlockProperties::Count);
+									const VertexDataTerrain vertex = TerrainVertex::Encode({ x, y, z }, faceIndex, corner, texIndex);
+									const TerrainVertex::Decoded decoded = TerrainVertex::Decode(vertex);
+									eqla(decoded.cornerPosition, Lattice3(x, y, z));
+									eq(decoded.faceIndex, faceIndex);
+									eq(decoded.cornerIndex, corner);
+									eq(decoded.texIndex, texIndex);
+
+									// 未使用のビットは 0
+									eq(vertex.packed >> (TerrainVertex::CornerIndexShift + TerrainVertex::CornerIndexBits), 0u);
+								}
+			}
+
+			static void Run_PackedVertex_Reconstruction()
+			{
+				// 1ブロック分の面について、復元した座標・UV値が、以前の頂点データ (ブロックの中心 ± 0.5, UV値は 0 or 1) と一致する
+				constexpr int LegacyCornerUVs[4][2] = { { 0, 1 }, { 0, 0 }, { 1, 1 }, { 1, 0 } };
+				const Lattice3 blockPosition = Lattice3(3, 70, 12);
+				const Vector3 chunkOrigin = Chunk::GetOriginWorldPosition(TestChunkIndex);
+				const Vector3 worldBlockPosition = chunkOrigin + Vector3(blockPosition);
+
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+				{
+					const TerrainMesh mesh = TerrainMesh::CreateFace(blockPosition, faceIndex, static_cast<std::uint32_t>(Block::Grass));
+					eq(mesh.vertices.size(), static_cast<std::size_t>(4));
+
+					// UV値は、1ブロックごとに繰り返すので、面全体で整数だけずれているのは同じ
+					Vector2 uvShift = Vector2::Zero();
+					for (int corner = 0; corner < 4; ++corner)
+					{
+						const TerrainVertex::Decoded decoded = TerrainVertex::Decode(mesh.vertices[corner]);
+						eq(decoded.cornerIndex, corner);
+
+						const int (&offset)[3] = TerrainVertex::FaceCornerOffsets[faceIndex][corner];
+						const Vector3 expectedPosition = worldBlockPosition + Vector3(offset[0] - 0.5f, offset[1] - 0.5f, offset[2] - 0.5f);
+						eqla(TerrainVertex::CalculateWorldPosition(decoded, chunkOrigin), expectedPosition);
+
+						// 頂点は法線の側の面上にある
+						const Lattice3& normal = TerrainVertex::FaceNormals[faceIndex];
+						const Vector3 toCorner = expectedPosition - worldBlockPosition;
+						eq(toCorner.x * normal.x + toCorner.y * normal.y + toCorner.z * normal.z, 0.5f);
+
+						const Vector2 uv = TerrainVertex::CalculateUV(decoded);
+						const Vector2 shift = uv - Vector2(static_cast<float>(LegacyCornerUVs[corner][0]), static_cast<float>(LegacyCornerUVs[corner][1]));
+						if (corner == 0)
+							uvShift = shift;
+						eqla(shift, uvShift);
+					}
+					eq(uvShift.x, std::round(uvShift.x));
+					eq(uvShift.y, std::round(uvShift.y));
+				}
+			}
+
+			static void Run_SharedQuadIndices()
+			{
+				// 共有のインデックスは、四角形ごとに同じ並び
+				const std::vector<std::uint32_t> indices = TerrainMesh::CreateQuadIndices(3);
+				eq(indices == std::vector<std::uint32_t>({ 0, 1, 2, 2, 1, 3, 4, 5, 6, 6, 5, 7, 8, 9, 10, 10, 9, 11 }), true);
+
+				// 最も面が多くなる市松模様でも、上限に収まる
+				Chunk chunk = Chunk::CreateVoid();
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int y = 0; y < Chunk::Height; ++y)
+						for (int z = 0; z < Chunk::Size; ++z)
+							if ((x + y + z) % 2 == 0)
+								chunk.SetBlock({ x, y, z }, Block::Stone);
+
+				TerrainMesh mesh = chunk.CreateMesh();
+				eq(mesh.GetQuadCount(), Chunk::Volume / 2 * TerrainVertex::FaceCount);
+				eq(mesh.GetQuadCount() <= Chunk::MaxMeshQuadCount, true);
+				eq(mesh.GetIndexCount(), mesh.GetQuadCount() * TerrainMesh::IndicesPerQuad);
+				Chunk::ReleaseMesh(std::move(mesh));
+			}
+
+			static void Run_SectionMeshes_MatchChunkMesh()
+			{
+				Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				// セクションの境界をまたぐ柱
+				const int pillarBottom = chunk.GetFloorHeight({ 7, 7 }) + 1;
+				for (int y = 0; y < 40; ++y)
+					chunk.SetBlock({ 7, pillarBottom + y, 7 }, y % 3 == 0 ? Block::Sand : Block::Stone);
+
+				TerrainMesh chunkMesh = chunk.CreateMesh();
+				const std::vector<UnitFace> chunkUnitFaces = DecomposeToUnitFaces(chunkMesh);
+				Chunk::ReleaseMesh(std::move(chunkMesh));
+
+				for (const ChunkMeshingMode mode : { ChunkMeshingMode::PerFace, ChunkMeshingMode::Greedy })
+				{
+					// 全セクションを合わせると、チャンク全体のメッシュと同じ面になる
+					Chunk::SectionMeshes sectionMeshes = chunk.CreateSectionMeshes(mode);
+					eq(DecomposeSectionsToUnitFaces(sectionMeshes) == chunkUnitFaces, true);
+
+					// 地形より上のセクションは、空 (ダミーも入らない)
+					eq(sectionMeshes[Chunk::SectionCount - 1].vertices.empty(), true);
+					Chunk::ReleaseSectionMeshes(std::move(sectionMeshes));
+				}
+
+				// 空のチャンクは、全セクションが空
+				Chunk::SectionMeshes voidMeshes = Chunk::CreateVoid().CreateSectionMeshes();
+				for (const TerrainMesh& mesh : voidMeshes)
+					eq(mesh.vertices.empty(), true);
+			}
+
+			static void Run_SectionMeshes_IncrementalEdit()
+			{
+				// セクションの境界 (y = 15, 16) や、その他の高さのブロックを書き換える
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, 16, 3 }), Chunk::SectionMask{ 0b11 });
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, 15, 3 }), Chunk::SectionMask{ 0b11 });
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, 20, 3 }), Chunk::SectionMask{ 0b10 });
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, 0, 3 }), Chunk::SectionMask{ 0b1 });
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, Chunk::Height - 1, 3 }), static_cast<Chunk::SectionMask>(1u << (Chunk::SectionCount - 1)));
+
+				Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				Chunk::SectionMeshes meshes = chunk.CreateSectionMeshes();
+
+				const std::vector<std::pair<Lattice3, Block>> edits =
+				{
+					{ { 4, 15, 4 }, Block::Air },
+					{ { 4, 16, 5 }, Block::Air },
+					{ { 5, 31, 5 }, Block::Stone },
+					{ { 5, 32, 5 }, Block::Stone },
+					{ { 9, chunk.GetFloorHeight({ 9, 9 }), 9 }, Block::Air },
+					{ { 9, chunk.GetFloorHeight({ 9, 9 }) + 1, 9 }, Block::Sand },
+				};
+				for (const auto& [position, block] : edits)
+				{
+					chunk.SetBlock(position, block);
+
+					// 影響するセクションのみを作り直す
+					chunk.RecreateSectionMeshes(meshes, Chunk::GetSectionsAffectedByBlock(position));
+
+					// 全て作り直したものと、セクションごとに同じになる
+					Chunk::SectionMeshes expectedMeshes = chunk.CreateSectionMeshes();
+					for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+						eq(DecomposeToUnitFaces(meshes[sectionIndex]) == DecomposeToUnitFaces(expectedMeshes[sectionIndex]), true);
+					Chunk::ReleaseSectionMeshes(std::move(expectedMeshes));
+				}
+
+				Chunk::ReleaseSectionMeshes(std::move(meshes));
+			}
+
+			static void Run_SectionMeshes_ColumnTopEdit()
+			{
+				// 列の最も高いブロックが変わると、空の遮蔽が変わりうる高さのセクションも加わる
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, 20, 3 }, 20, 20), Chunk::SectionMask{ 0b10 });
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, 60, 3 }, 20, 60), Chunk::SectionMask{ 0b1110 });
+				eq(Chunk::GetSectionsAffectedByBlock({ 3, 20, 3 }, 20, -1), Chunk::SectionMask{ 0b11 });
+
+				// チャンク (とその +x 側の隣接チャンク) の列の高さを変える編集 (隣接チャンクとの境界の列も含む)
+				Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				Chunk rightChunk = Chunk::CreateFromNoise(TestChunkIndex + Lattice2(1, 0), { 0.015f, 12.0f }, 16, 18, 24);
+				Chunk::SectionMeshes meshes = chunk.CreateSectionMeshes(ChunkMeshingMode::PerFace, Chunk::CaptureNeighborBorders(&rightChunk, nullptr, nullptr, nullptr));
+				Chunk::SectionMeshes rightMeshes = rightChunk.CreateSectionMeshes(ChunkMeshingMode::PerFace, Chunk::CaptureNeighborBorders(nullptr, &chunk, nullptr, nullptr));
+
+				const std::vector<std::pair<Lattice3, Block>> edits =
+				{
+					{ { 6, chunk.GetFloorHeight({ 6, 6 }) + 40, 6 }, Block::Stone },             // 高い柱の先端 (周囲の列が暗くなる)
+					{ { 6, chunk.GetFloorHeight({ 6, 6 }) + 40, 6 }, Block::Air },               // 元に戻す
+					{ { 8, chunk.GetFloorHeight({ 8, 3 }), 3 }, Block::Air },                    // 地表を1段掘る
+					{ { Chunk::Size - 1, chunk.GetFloorHeight({ Chunk::Size - 1, 7 }) + 35, 7 }, Block::Stone }, // 境界の列
+				};
+				for (const auto& [position, block] : edits)
+				{
+					const Lattice2 positionXZ = Lattice2(position.x, position.z);
+					const int oldColumnHeight = chunk.GetColumnHeight(positionXZ);
+					chunk.SetBlock(position, block);
+					const Chunk::SectionMask sectionMask = Chunk::GetSectionsAffectedByBlock(position, oldColumnHeight, chunk.GetColumnHeight(positionXZ));
+
+					// 影響するセクションのみを作り直す (境界の列なら、隣接チャンクも同じセクションを作り直す)
+					const Chunk::NeighborBorders neighbors = Chunk::CaptureNeighborBorders(&rightChunk, nullptr, nullptr, nullptr);
+					const Chunk::NeighborBorders rightNeighbors = Chunk::CaptureNeighborBorders(nullptr, &chunk, nullptr, nullptr);
+					chunk.RecreateSectionMeshes(meshes, sectionMask, ChunkMeshingMode::PerFace, neighbors);
+					if (position.x == Chunk::Size - 1)
+						rightChunk.RecreateSectionMeshes(rightMeshes, sectionMask, ChunkMeshingMode::PerFace, rightNeighbors);
+
+					// 全て作り直したものと、遮蔽も含めて頂点ごとに同じになる
+					const auto isSameVertices = [](const TerrainMesh& a, const TerrainMesh& b)
+						{
+							if (a.vertices.size() != b.vertices.size())
+								return false;
+							for (std::size_t i = 0; i < a.vertices.size(); ++i)
+							{
+								if (a.vertices[i].packed != b.vertices[i].packed || a.vertices[i].texIndex != b.vertices[i].texIndex)
+									return false;
+							}
+							return true;
+						};
+					Chunk::SectionMeshes expectedMeshes = chunk.CreateSectionMeshes(ChunkMeshingMode::PerFace, neighbors);
+					Chunk::SectionMeshes expectedRightMeshes = rightChunk.CreateSectionMeshes(ChunkMeshingMode::PerFace, rightNeighbors);
+					for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+					{
+						eq(isSameVertices(meshes[sectionIndex], expectedMeshes[sectionIndex]), true);
+						eq(isSameVertices(rightMeshes[sectionIndex], expectedRightMeshes[sectionIndex]), true);
+					}
+					Chunk::ReleaseSectionMeshes(std::move(expectedMeshes));
+					Chunk::ReleaseSectionMeshes(std::move(expectedRightMeshes));
+				}
+
+				Chunk::ReleaseSectionMeshes(std::move(meshes));
+				Chunk::ReleaseSectionMeshes(std::move(rightMeshes));
+			}
+
+			static void Run_LodMesh_SurfaceMap()
+			{
+				// ノイズから直接求めた地表は、生成したチャンクの地表と一致する
+				const Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				const Chunk::SurfaceMap surfaceMap = chunk.CreateSurfaceMap();
+				const Chunk::SurfaceMap noiseSurfaceMap = Chunk::CreateSurfaceMapFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				eq(surfaceMap.heights == noiseSurfaceMap.heights, true);
+				eq(surfaceMap.blocks == noiseSurfaceMap.blocks, true);
+
+				// 空のチャンクは、LOD のメッシュも空
+				eq(Chunk::CreateLodMesh(Chunk::CreateVoid().CreateSurfaceMap(), 1).vertices.empty(), true);
+			}
+
+			static void Run_LodMesh_Coverage()
+			{
+				Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				// 段差を大きくする
+				const int pillarBottom = chunk.GetFloorHeight({ 5, 10 }) + 1;
+				for (int y = 0; y < 12; ++y)
+					chunk.SetBlock({ 5, pillarBottom + y, 10 }, Block::Stone);
+				const Chunk::SurfaceMap surfaceMap = chunk.CreateSurfaceMap();
+
+				int previousVertexCount = std::numeric_limits<int>::max();
+				for (int lodLevel = 1; (1 << lodLevel) <= Chunk::Size; ++lodLevel)
+				{
+					TerrainMesh mesh = Chunk::CreateLodMesh(surfaceMap, lodLevel);
+					const std::vector<UnitFace> unitFaces = DecomposeToUnitFaces(mesh);
+					const auto hasFace = [&](const Lattice3& normal, int x, int y, int z)
+						{
+							const UnitFace unitFace = { normal.x, normal.y, normal.z, x, y, z };
+							return std::any_of(unitFaces.begin(), unitFaces.end(),
+								[&](const UnitFace& face) { return std::equal(face.begin(), face.begin() + 6, unitFace.begin()); });
+						};
+
+					// 列ごとの、LOD での高さ (上面がある高さ)
+					std::array<int, Chunk::Size * Chunk::Size> lodHeights = {};
+					for (int x = 0; x < Chunk::Size; ++x)
+						for (int z = 0; z < Chunk::Size; ++z)
+						{
+							int count = 0;
+							for (const UnitFace& face : unitFaces)
+							{
+								if (face[1] == 1 && face[3] == x && face[5] == z)
+								{
+									lodHeights[x * Chunk::Size + z] = face[4];
+									++count;
+								}
+							}
+
+							// 全ての列に、上面が1枚だけあり、実際の地表より下にはならない
+							eq(count, 1);
+							eq(lodHeights[x * Chunk::Size + z] >= chunk.GetColumnHeight({ x, z }), true);
+						}
+
+					// 隣の列より高い分は、側面で塞がれている (チャンクの境界は Y=0 まで)
+					for (int x = 0; x < Chunk::Size; ++x)
+						for (int z = 0; z < Chunk::Size; ++z)
+							for (int side = 2; side < TerrainVertex::FaceCount; ++side)
+							{
+								const Lattice3& normal = TerrainVertex::FaceNormals[side];
+								const int nx = x + normal.x;
+								const int nz = z + normal.z;
+								const bool isInside = 0 <= nx && nx < Chunk::Size && 0 <= nz && nz < Chunk::Size;
+								const int floorHeight = isInside ? lodHeights[nx * Chunk::Size + nz] : -1;
+								for (int y = floorHeight + 1; y <= lodHeights[x * Chunk::Size + z]; ++y)
+									eq(hasFace(normal, x, y, z), true);
+							}
+
+					// レベルが上がるほど、頂点は減る
+					const int vertexCount = static_cast<int>(mesh.vertices.size());
+					eq(vertexCount < previousVertexCount, true);
+					previousVertexCount = vertexCount;
+					Chunk::ReleaseMesh(std::move(mesh));
+				}
+			}
+
+			static void Run_LodMesh_Merge()
+			{
+				// リージョン内の2チャンクの LOD のメッシュを、リージョンの原点からのチャンク数を詰めてまとめる
+				const Lattice2 regionOrigin = TestChunkIndex / Chunk::RegionSize * Chunk::RegionSize;
+				const std::array<Lattice2, 2> chunkIndices = { regionOrigin + Lattice2(0, 0), regionOrigin + Lattice2(Chunk::RegionSize - 1, 5) };
+				const std::array<Lattice2, 2> chunkOffsets = { chunkIndices[0] - regionOrigin, chunkIndices[1] - regionOrigin };
+				std::array<TerrainMesh, 2> meshes = {};
+				for (int i = 0; i < 2; ++i)
+					meshes[i] = Chunk::CreateLodMesh(Chunk::CreateSurfaceMapFromNoise(chunkIndices[i], { 0.015f, 12.0f }, 16, 18, 24), i + 1);
+				const std::array<const TerrainMesh*, 2> meshPointers = { &meshes[0], &meshes[1] };
+
+				TerrainMesh merged = Chunk::MergeLodMeshes(meshPointers, chunkOffsets);
+				CheckFaceQuadOffsets(merged);
+				eq(merged.vertices.size(), meshes[0].vertices.size() + meshes[1].vertices.size());
+
+				// 向きごとに各メッシュの範囲が順に並び、ワールド座標・テクスチャは元のメッシュと一致する
+				const Vector3 regionOriginWorldPosition = Chunk::GetOriginWorldPosition(regionOrigin);
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+				{
+					eq(merged.GetFaceQuadCount(faceIndex), meshes[0].GetFaceQuadCount(faceIndex) + meshes[1].GetFaceQuadCount(faceIndex));
+
+					int mergedVertex = merged.GetFaceQuadBegin(faceIndex) * TerrainMesh::VerticesPerQuad;
+					for (int i = 0; i < 2; ++i)
+					{
+						const int begin = meshes[i].GetFaceQuadBegin(faceIndex) * TerrainMesh::VerticesPerQuad;
+						const int end = begin + meshes[i].GetFaceQuadCount(faceIndex) * TerrainMesh::VerticesPerQuad;
+						for (int v = begin; v < end; ++v, ++mergedVertex)
+						{
+							const TerrainVertex::Decoded original = TerrainVertex::Decode(meshes[i].vertices[v]);
+							const TerrainVertex::Decoded decoded = TerrainVertex::Decode(merged.vertices[mergedVertex]);
+							eq(decoded.chunkOffset, chunkOffsets[i]);
+							eq(decoded.texIndex, original.texIndex);
+							eq(decoded.cornerPosition, original.cornerPosition);
+							eq(TerrainVertex::CalculateWorldPosition(decoded, regionOriginWorldPosition),
+								TerrainVertex::CalculateWorldPosition(original, Chunk::GetOriginWorldPosition(chunkIndices[i])));
+						}
+					}
+				}
+
+				Chunk::ReleaseMesh(std::move(merged));
+				for (TerrainMesh& mesh : meshes)
+					Chunk::ReleaseMesh(std::move(mesh));
+
+				// 空のメッシュだけなら、まとめても空
+				const TerrainMesh empty = {};
+				const std::array<const TerrainMesh*, 1> emptyPointers = { &empty };
+				const std::array<Lattice2, 1> emptyOffsets = { Lattice2(1, 1) };
+				eq(Chunk::MergeLodMeshes(emptyPointers, emptyOffsets).vertices.empty(), true);
+			}
+
+			static void Run_FaceRanges()
+			{
+				Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				const int pillarBottom = chunk.GetFloorHeight({ 7, 7 }) + 1;
+				for (int y = 0; y < 20; ++y)
+					chunk.SetBlock({ 7, pillarBottom + y, 7 }, Block::Stone);
+
+				// どの作り方でも、四角形は面の向きごとにまとまる
+				for (const ChunkMeshingMode mode : { ChunkMeshingMode::PerFace, ChunkMeshingMode::Greedy })
+				{
+					TerrainMesh mesh = chunk.CreateMesh(mode);
+					CheckFaceQuadOffsets(mesh);
+					Chunk::ReleaseMesh(std::move(mesh));
+
+					Chunk::SectionMeshes sectionMeshes = chunk.CreateSectionMeshes(mode);
+					for (const TerrainMesh& sectionMesh : sectionMeshes)
+						CheckFaceQuadOffsets(sectionMesh);
+					Chunk::ReleaseSectionMeshes(std::move(sectionMeshes));
+				}
+				for (int lodLevel = 1; (1 << lodLevel) <= Chunk::Size; ++lodLevel)
+				{
+					TerrainMesh mesh = Chunk::CreateLodMesh(chunk.CreateSurfaceMap(), lodLevel);
+					CheckFaceQuadOffsets(mesh);
+					Chunk::ReleaseMesh(std::move(mesh));
+				}
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+					CheckFaceQuadOffsets(TerrainMesh::CreateFace({ 1, 2, 3 }, faceIndex, static_cast<std::uint32_t>(Block::Grass)));
+
+				// PerFace の向きごとの数は、数える関数と一致する
+				TerrainMesh mesh = chunk.CreateMesh();
+				const std::array<int, TerrainVertex::FaceCount> counts = chunk.CountExposedFacesByDirection();
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+					eq(mesh.GetFaceQuadCount(faceIndex), counts[faceIndex]);
+				Chunk::ReleaseMesh(std::move(mesh));
+			}
+
+			static void Run_FaceCulling()
+			{
+				// 見える向きの範囲の列挙 (四角形の無い向きは、範囲を途切れさせない)
+				{
+					eq((TerrainMesh::FaceLayoutOrder == std::array<int, TerrainVertex::FaceCount>({ 3, 5, 0, 2, 4, 1 })), true);
+					const TerrainMesh::FaceQuadOffsets offsets = { 0, 2, 2, 5, 7, 7, 9 }; // Left 2, Backward 0, Up 3, Right 2, Forward 0, Down 2
+					const auto collectRanges = [&](std::uint32_t visibleFaceBits)
+						{
+							std::vector<Lattice2> ranges = {};
+							TerrainMesh::ForEachFaceRange(offsets, visibleFaceBits, [&](int firstQuad, int quadCount) { ranges.push_back({ firstQuad, quadCount }); });
+							return ranges;
+						};
+					eq(collectRanges(TerrainFaceCulling::AllFaceBits) == std::vector<Lattice2>({ { 0, 9 } }), true);
+					eq(collectRanges(0b001011) == std::vector<Lattice2>({ { 0, 5 }, { 7, 2 } }), true); // Left, Up, Down
+					eq(collectRanges(0b000100) == std::vector<Lattice2>({ { 5, 2 } }), true);           // Right
+					eq(collectRanges(0).empty(), true);
+
+					// 太陽の向きから見える面は、1つの範囲になる
+					const TerrainMesh::FaceQuadOffsets fullOffsets = { 0, 1, 2, 3, 4, 5, 6 };
+					int rangeCount = 0;
+					TerrainMesh::ForEachFaceRange(fullOffsets,
+						TerrainFaceCulling::CreateOrthographic(Vector3(1.0f, -1.0f, 1.0f).Normed()).CalculateVisibleFaceBits(Vector3::Zero(), Vector3::One()),
+						[&](int firstQuad, int quadCount) { eq(firstQuad, 0); eq(quadCount, 3); ++rangeCount; });
+					eq(rangeCount, 1);
+				}
+
+				// 省いた面は、全て視点から見て裏を向いている
+				// チャンクの原点はワールドの原点とする
+				const Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				Chunk::SectionMeshes meshes = chunk.CreateSectionMeshes();
+				const int surfaceHeight = chunk.GetFloorHeight({ 8, 8 });
+				const std::vector<TerrainFaceCulling> cullings =
+				{
+					TerrainFaceCulling::CreatePerspective(Vector3(8.0f, surfaceHeight + 2.6f, 8.0f)),   // チャンク内の地上
+					TerrainFaceCulling::CreatePerspective(Vector3(-40.0f, surfaceHeight + 30.0f, 70.0f)), // チャンクの外の上空
+					TerrainFaceCulling::CreatePerspective(Vector3(30.0f, 3.0f, -20.0f)),                  // チャンクの外の地中
+					TerrainFaceCulling::CreateOrthographic(Vector3(1.0f, -1.0f, 1.0f).Normed()),
+				};
+				for (const TerrainFaceCulling& culling : cullings)
+				{
+					int culledQuadCount = 0;
+					for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+					{
+						const TerrainMesh& mesh = meshes[sectionIndex];
+						const std::uint32_t visibleFaceBits = culling.CalculateVisibleFaceBits(
+							Vector3(0, sectionIndex * Chunk::SectionHeight, 0) - Vector3::One() * 0.5f,
+							Vector3(Chunk::Size, (sectionIndex + 1) * Chunk::SectionHeight, Chunk::Size) - Vector3::One() * 0.5f);
+
+						std::vector<bool> isDrawn = std::vector<bool>(mesh.GetQuadCount(), false);
+						TerrainMesh::ForEachFaceRange(mesh.faceQuadOffsets, visibleFaceBits,
+							[&](int firstQuad, int quadCount) { std::fill_n(isDrawn.begin() + firstQuad, quadCount, true); });
+
+						for (int quad = 0; quad < mesh.GetQuadCount(); ++quad)
+						{
+							if (isDrawn[quad])
+								continue;
+							++culledQuadCount;
+
+							const TerrainVertex::Decoded decoded = TerrainVertex::Decode(mesh.vertices[static_cast<std::size_t>(quad) * TerrainMesh::VerticesPerQuad]);
+							const Lattice3& normal = TerrainVertex::FaceNormals[decoded.faceIndex];
+							const Vector3 toView = (culling.mode == TerrainFaceCulling::Mode::Perspective)
+								? culling.view - TerrainVertex::CalculateWorldPosition(decoded, Vector3::Zero())
+								: -culling.view;
+							eq(normal.x * toView.x + normal.y * toView.y + normal.z * toView.z <= 0.0f, true);
+						}
+					}
+
+					// チャンク内にいても、下向きの面などは省ける
+					eq(culledQuadCount > 0, true);
+				}
+
+				// カリングしないなら、全ての向きが見える
+				eq(TerrainFaceCulling{}.CalculateVisibleFaceBits(Vector3::Zero(), Vector3::One()), TerrainFaceCulling::AllFaceBits);
+				Chunk::ReleaseSectionMeshes(std::move(meshes));
+			}
+			static void Run_Occlusion_MatchesReference()
+			{
+				// 地形に、張り出し・穴・境界の柱を加える
+				Chunk chunk = Chunk::CreateFromNoise(TestChunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+				for (int x = 3; x < 9; ++x)
+					for (int z = 4; z < 7; ++z)
+						chunk.SetBlock({ x, chunk.GetColumnHeight({ 5, 5 }) + 3, z }, Block::Stone);
+				for (int y = 0; y < chunk.GetColumnHeight({ 10, 10 }); ++y)
+					chunk.SetBlock({ 10, y, 10 }, Block::Air);
+				for (int y = 0; y < 40; ++y)
+					chunk.SetBlock({ Chunk::Size - 1, y, 2 }, Block::Stone);
+
+				const Chunk rightChunk = Chunk::CreateFromNoise(TestChunkIndex + Lattice2(1, 0), { 0.015f, 12.0f }, 16, 18, 24);
+				const Chunk forwardChunk = Chunk::CreateFromNoise(TestChunkIndex + Lattice2(0, 1), { 0.015f, 12.0f }, 16, 18, 24);
+				// 斜めの隣接チャンクの、角の列の柱 (こちらの角の列の面を遮る)
+				Chunk rightForwardChunk = Chunk::CreateFromNoise(TestChunkIndex + Lattice2(1, 1), { 0.015f, 12.0f }, 16, 18, 24);
+				Chunk leftBackwardChunk = Chunk::CreateFromNoise(TestChunkIndex + Lattice2(-1, -1), { 0.015f, 12.0f }, 16, 18, 24);
+				for (int y = 0; y < 60; ++y)
+				{
+					rightForwardChunk.SetBlock({ 0, y, 0 }, Block::Stone);
+					leftBackwardChunk.SetBlock({ Chunk::Size - 1, y, Chunk::Size - 1 }, Block::Stone);
+				}
+				const std::array<const Chunk*, 8> neighborChunks = { &rightChunk, nullptr, &forwardChunk, nullptr, &rightForwardChunk, nullptr, nullptr, &leftBackwardChunk };
+				const Chunk::NeighborBorders neighbors = Chunk::CaptureNeighborBorders(
+					&rightChunk, nullptr, &forwardChunk, nullptr, &rightForwardChunk, nullptr, nullptr, &leftBackwardChunk);
+
+				// 面ごとのメッシュの全頂点が、ブロックを1つずつ調べた値と一致する
+				// 遮蔽は (面の向き, 格子点) だけで決まる (頂点を共有する見えている面どうしは、手前の4マスが同じ) ので、それごとに覚えておく
+				TerrainMesh perFaceMesh = chunk.CreateMesh(ChunkMeshingMode::PerFace, neighbors);
+				std::map<std::array<int, 4>, std::pair<int, int>> occlusionAtCorners = {};
+				int occludedVertexCount = 0;
+				for (std::size_t quadBegin = 0; quadBegin < perFaceMesh.vertices.size(); quadBegin += TerrainMesh::VerticesPerQuad)
+				{
+					const TerrainVertex::Decoded first = TerrainVertex::Decode(perFaceMesh.vertices[quadBegin]);
+					const int (&firstOffset)[3] = TerrainVertex::FaceCornerOffsets[first.faceIndex][first.cornerIndex];
+					const Lattice3 position = first.cornerPosition - Lattice3(firstOffset[0], firstOffset[1], firstOffset[2]);
+					const std::array<std::uint32_t, 4> expected = CalculateReferenceCornerOcclusions(chunk, neighborChunks, position, first.faceIndex);
+
+					for (std::size_t i = quadBegin; i < quadBegin + TerrainMesh::VerticesPerQuad; ++i)
+					{
+						const TerrainVertex::Decoded decoded = TerrainVertex::Decode(perFaceMesh.vertices[i]);
+						eq(TerrainVertex::EncodeOcclusion(decoded.ambientOcclusion, decoded.skyOcclusion), expected[decoded.cornerIndex]);
+						if (expected[decoded.cornerIndex] != 0)
+							++occludedVertexCount;
+
+						const std::array<int, 4> key = { decoded.faceIndex, decoded.cornerPosition.x, decoded.cornerPosition.y, decoded.cornerPosition.z };
+						const std::pair<int, int> occlusion = { decoded.ambientOcclusion, decoded.skyOcclusion };
+						const auto [it, isInserted] = occlusionAtCorners.emplace(key, occlusion);
+						eq(it->second == occlusion, true);
+					}
+				}
+				eq(occludedVertexCount > 0, true);
+
+				// 斜めの柱が、角の列の面の、角の頂点を遮っている
+				const auto isOccludedAt = [&](int faceIndex, const Lattice3& cornerPosition)
+					{
+						const auto it = occlusionAtCorners.find({ faceIndex, cornerPosition.x, cornerPosition.y, cornerPosition.z });
+						return it != occlusionAtCorners.end() && it->second != std::pair<int, int>(0, 0);
+					};
+				constexpr int UpFace = 0;
+				const int topAtCorner = chunk.GetColumnHeight({ Chunk::Size - 1, Chunk::Size - 1 });
+				const int topAtOrigin = chunk.GetColumnHeight({ 0, 0 });
+				eq(isOccludedAt(UpFace, { Chunk::Size, topAtCorner + 1, Chunk::Size }), true);
+				eq(isOccludedAt(UpFace, { 0, topAtOrigin + 1, 0 }), true);
+
+				// 貪欲メッシュの頂点も、同じ格子点の値になる
+				TerrainMesh greedyMesh = chunk.CreateMesh(ChunkMeshingMode::Greedy, neighbors);
+				for (const VertexDataTerrain& vertex : greedyMesh.vertices)
+				{
+					const TerrainVertex::Decoded decoded = TerrainVertex::Decode(vertex);
+					const auto it = occlusionAtCorners.find({ decoded.faceIndex, decoded.cornerPosition.x, decoded.cornerPosition.y, decoded.cornerPosition.z });
+					eq(it != occlusionAtCorners.end(), true);
+					eq((it->second == std::pair<int, int>(decoded.ambientOcclusion, decoded.skyOcclusion)), true);
+				}
+				eq(DecomposeToUnitFaces(greedyMesh) == DecomposeToUnitFaces(perFaceMesh), true);
+
+				Chunk::ReleaseMesh(std::move(perFaceMesh));
+				Chunk::ReleaseMesh(std::move(greedyMesh));
+			}
+
+			static void Run_Occlusion_Shapes()
+			{
+				constexpr int UpFace = 0;
+				const auto occlusion = [](int ambientOcclusion, int skyOcclusion) { return TerrainVertex::EncodeOcclusion(ambientOcclusion, skyOcclusion); };
+
+				// 5x5 の平らな床
+				Chunk chunk = Chunk::CreateVoid();
+				for (int x = 6; x <= 10; ++x)
+					for (int z = 6; z <= 10; ++z)
+						chunk.SetBlock({ x, 0, z }, Block::Stone);
+
+				// 開けた床の上面は、遮られない
+				{
+					const Chunk::OcclusionGrid grid = chunk.CalculateOcclusionGrid();
+					eq((Chunk::CalculateFaceCornerOcclusions(grid, { 8, 0, 8 }, UpFace) == std::array<std::uint32_t, 4>{}), true);
+				}
+
+				// +x 側に壁 -> その側の2頂点が暗くなる (頂点の並びは (0,0), (0,1), (1,0), (1,1))
+				chunk.SetBlock({ 9, 1, 8 }, Block::Stone);
+				{
+					const Chunk::OcclusionGrid grid = chunk.CalculateOcclusionGrid();
+					eq((Chunk::CalculateFaceCornerOcclusions(grid, { 8, 0, 8 }, UpFace) == std::array<std::uint32_t, 4>{ 0, 0, occlusion(1, 1), occlusion(1, 1) }), true);
+				}
+
+				// +z 側にも壁 -> 入隅の頂点は、角によらず最大
+				chunk.SetBlock({ 8, 1, 9 }, Block::Stone);
+				{
+					const Chunk::OcclusionGrid grid = chunk.CalculateOcclusionGrid();
+					eq((Chunk::CalculateFaceCornerOcclusions(grid, { 8, 0, 8 }, UpFace) == std::array<std::uint32_t, 4>{ 0, occlusion(1, 1), occlusion(1, 1), occlusion(3, 2) }), true);
+				}
+
+				// 3x3 の屋根の下 -> 周りの壁が無くても、空が見えない
+				for (int x = 7; x <= 9; ++x)
+					for (int z = 7; z <= 9; ++z)
+						chunk.SetBlock({ x, 5, z }, Block::Stone);
+				chunk.SetBlock({ 9, 1, 8 }, Block::Air);
+				chunk.SetBlock({ 8, 1, 9 }, Block::Air);
+				{
+					const Chunk::OcclusionGrid grid = chunk.CalculateOcclusionGrid();
+					eq((Chunk::CalculateFaceCornerOcclusions(grid, { 8, 0, 8 }, UpFace) == std::array<std::uint32_t, 4>
+						{ occlusion(0, 4), occlusion(0, 4), occlusion(0, 4), occlusion(0, 4) }), true);
+
+					// 屋根の上面は、遮られない
+					eq((Chunk::CalculateFaceCornerOcclusions(grid, { 8, 5, 8 }, UpFace) == std::array<std::uint32_t, 4>{}), true);
+				}
+
+				// LOD メッシュは遮蔽を持たない
+				TerrainMesh lodMesh = Chunk::CreateLodMesh(chunk.CreateSurfaceMap(), 1);
+				for (const VertexDataTerrain& vertex : lodMesh.vertices)
+				{
+					const TerrainVertex::Decoded decoded = TerrainVertex::Decode(vertex);
+					eq(decoded.ambientOcclusion, 0);
+					eq(decoded.skyOcclusion, 0);
+				}
+				Chunk::ReleaseMesh(std::move(lodMesh));
+			}
+
+			static void Run_Occlusion_DiagonalFlip()
+			{
+				const std::array<std::uint32_t, 4> none = {};
+				const std::array<std::uint32_t, 4> diagonal = { 0, TerrainVertex::EncodeOcclusion(2, 1), TerrainVertex::EncodeOcclusion(1, 1), 0 };
+				const std::array<std::uint32_t, 4> opposite = { TerrainVertex::EncodeOcclusion(2, 1), 0, 0, TerrainVertex::EncodeOcclusion(1, 1) };
+				eq((TerrainVertex::GetCornerWriteOrder(none) == std::array<int, 4>{ 0, 1, 2, 3 }), true);
+				eq((TerrainVertex::GetCornerWriteOrder(opposite) == std::array<int, 4>{ 0, 1, 2, 3 }), true);
+				eq((TerrainVertex::GetCornerWriteOrder(diagonal) == std::array<int, 4>{ 2, 0, 3, 1 }), true);
+
+				// 頂点を回して並べても、共有のインデックスで作る三角形は表を向く
+				// (法線の側から見て時計回り. 左手系なので、辺の外積が法線の向きになる. 描画は裏面カリングするので、逆向きだと消える)
+				const std::vector<std::uint32_t> indices = TerrainMesh::CreateQuadIndices(1);
+				const std::uint32_t packedBlockPosition = TerrainVertex::EncodePosition({ 4, 4, 4 });
+				for (int faceIndex = 0; faceIndex < TerrainVertex::FaceCount; ++faceIndex)
+				{
+					for (const std::array<std::uint32_t, 4>& cornerOcclusions : { none, diagonal })
+					{
+						std::array<VertexDataTerrain, 4> vertices = {};
+						TerrainVertex::WriteFace(vertices, packedBlockPosition, faceIndex, 0, cornerOcclusions);
+
+						const Lattice3& normal = TerrainVertex::FaceNormals[faceIndex];
+						for (std::size_t triangle = 0; triangle < indices.size(); triangle += 3)
+						{
+							const Vector3 p0 = TerrainVertex::CalculateWorldPosition(TerrainVertex::Decode(vertices[indices[triangle + 0]]), Vector3::Zero());
+							const Vector3 p1 = TerrainVertex::CalculateWorldPosition(TerrainVertex::Decode(vertices[indices[triangle + 1]]), Vector3::Zero());
+							const Vector3 p2 = TerrainVertex::CalculateWorldPosition(TerrainVertex::Decode(vertices[indices[triangle + 2]]), Vector3::Zero());
+							const Vector3 cross = Vector3::Cross(p1 - p0, p2 - p0);
+							eq(cross.x * normal.x + cross.y * normal.y + cross.z * normal.z > 0.0f, true);
+						}
+						for (int corner = 0; corner < 4; ++corner)
+							eq(TerrainVertex::Decode(vertices[corner]).cornerIndex, TerrainVertex::GetCornerWriteOrder(cornerOcclusions)[corner]);
+					}
+				}
+			}
+		};
+	}
+}
\ No newline at end of file
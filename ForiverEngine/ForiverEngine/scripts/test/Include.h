@@ -2,6 +2,12 @@
 
 #include "./IncludeInternal.h"
 #include "./PlayerControl.h"
+#include "./ChunkMesh.h"
+#include "./RangeAllocator.h"
+#include "./MultiDimArray.h"
+#include "./Noise.h"
+#include "./TerrainGenerator.h"
+#include "./ChunkBenchmark.h"
 
 #undef eq
 #undef neq
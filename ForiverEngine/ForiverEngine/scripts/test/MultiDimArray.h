@@ -0,0 +1,147 @@
+﻿#pragma once
+
+#include <scripts/test/IncludeInternal.h>
+
+namespace ForiverEngine
+{
+	namespace Test
+	{
+		struct MultiDimArray final
+		{
+		public:
+			DELETE_DEFAULT_METHODS(MultiDimArray);
+
+			static void RunAll()
+			{
+				Run_RowMajorOffset();
+				Run_ColumnMajorOffset();
+				Run_Indexing_RowMajor();
+				Run_Indexing_ColumnMajor();
+				Run_Move();
+			}
+
+			template<typename T, int Rank, typename TLayout = MultiDimLayoutRowMajor>
+			using TargetClass = ForiverEngine::MultiDimArray<T, Rank, TLayout>;
+
+			static constexpr int SizeX = 3;
+			static constexpr int SizeY = 4;
+			static constexpr int SizeZ = 5;
+
+#pragma region Helpers
+
+			// 全要素に、x,y,z から一意に決まる値を [x][y][z] で書き込む
+			template<typename TLayout>
+			static TargetClass<int, 3, TLayout> CreateFilled()
+			{
+				auto array = HeapMultiDimAllocator::CreateArrayND<int, TLayout>(SizeX, SizeY, SizeZ);
+				for (int x = 0; x < SizeX; ++x)
+					for (int y = 0; y < SizeY; ++y)
+						for (int z = 0; z < SizeZ; ++z)
+							array[x][y][z] = GetValue(x, y, z);
+				return array;
+			}
+
+			static int GetValue(int x, int y, int z)
+			{
+				return x * 10000 + y * 100 + z;
+			}
+
+#pragma endregion
+
+			static void Run_RowMajorOffset()
+			{
+				// 最後の次元が連続する
+				const std::array<int, 3> extents = { SizeX, SizeY, SizeZ };
+				eq(MultiDimLayoutRowMajor::GetOffset<3>(extents, { 0, 0, 0 }), 0);
+				eq(MultiDimLayoutRowMajor::GetOffset<3>(extents, { 0, 0, 1 }), 1);
+				eq(MultiDimLayoutRowMajor::GetOffset<3>(extents, { 0, 1, 0 }), SizeZ);
+				eq(MultiDimLayoutRowMajor::GetOffset<3>(extents, { 1, 0, 0 }), SizeY * SizeZ);
+				eq(MultiDimLayoutRowMajor::GetOffset<3>(extents, { 2, 3, 4 }), (2 * SizeY + 3) * SizeZ + 4);
+				eq(MultiDimLayoutRowMajor::GetOffset<3>(extents, { SizeX - 1, SizeY - 1, SizeZ - 1 }), SizeX * SizeY * SizeZ - 1);
+
+				// 2次元
+				eq(MultiDimLayoutRowMajor::GetOffset<2>({ SizeX, SizeY }, { 2, 1 }), 2 * SizeY + 1);
+			}
+
+			static void Run_ColumnMajorOffset()
+			{
+				// 最初の次元が連続する
+				const std::array<int, 3> extents = { SizeX, SizeY, SizeZ };
+				eq(MultiDimLayoutColumnMajor::GetOffset<3>(extents, { 0, 0, 0 }), 0);
+				eq(MultiDimLayoutColumnMajor::GetOffset<3>(extents, { 1, 0, 0 }), 1);
+				eq(MultiDimLayoutColumnMajor::GetOffset<3>(extents, { 0, 1, 0 }), SizeX);
+				eq(MultiDimLayoutColumnMajor::GetOffset<3>(extents, { 0, 0, 1 }), SizeX * SizeY);
+				eq(MultiDimLayoutColumnMajor::GetOffset<3>(extents, { 2, 3, 4 }), (4 * SizeY + 3) * SizeX + 2);
+				eq(MultiDimLayoutColumnMajor::GetOffset<3>(extents, { SizeX - 1, SizeY - 1, SizeZ - 1 }), SizeX * SizeY * SizeZ - 1);
+
+				// 2次元
+				eq(MultiDimLayoutColumnMajor::GetOffset<2>({ SizeX, SizeY }, { 2, 1 }), 1 * SizeX + 2);
+			}
+
+			static void Run_Indexing_RowMajor()
+			{
+				const auto array = CreateFilled<MultiDimLayoutRowMajor>();
+				eq(array.GetCount(), SizeX * SizeY * SizeZ);
+				eq(array.GetExtent(0), SizeX);
+				eq(array.GetExtent(1), SizeY);
+				eq(array.GetExtent(2), SizeZ);
+
+				// [x][y][z] で書いた値が、手で計算した位置に並んでいる
+				const int* const values = array.begin();
+				for (int x = 0; x < SizeX; ++x)
+					for (int y = 0; y < SizeY; ++y)
+						for (int z = 0; z < SizeZ; ++z)
+						{
+							eq(values[(x * SizeY + y) * SizeZ + z], GetValue(x, y, z));
+							eq(array[x][y][z], GetValue(x, y, z));
+							eq(array.At({ x, y, z }), GetValue(x, y, z));
+						}
+			}
+
+			static void Run_Indexing_ColumnMajor()
+			{
+				const auto array = CreateFilled<MultiDimLayoutColumnMajor>();
+				eq(array.GetCount(), SizeX * SizeY * SizeZ);
+
+				const int* const values = array.begin();
+				for (int x = 0; x < SizeX; ++x)
+					for (int y = 0; y < SizeY; ++y)
+						for (int z = 0; z < SizeZ; ++z)
+						{
+							eq(values[(z * SizeY + y) * SizeX + x], GetValue(x, y, z));
+							eq(array[x][y][z], GetValue(x, y, z));
+						}
+			}
+
+			static void Run_Move()
+			{
+				auto source = CreateFilled<MultiDimLayoutRowMajor>();
+				const int* const sourceValues = source.begin();
+
+				// ムーブコンストラクタ: メモリはそのまま引き継がれ、移動元は空になる
+				TargetClass<int, 3> moved(std::move(source));
+				eq(moved.begin() == sourceValues, true);
+				eq(moved.GetCount(), SizeX * SizeY * SizeZ);
+				eq(moved[2][3][4], GetValue(2, 3, 4));
+				eq(source.begin() == nullptr, true);
+
+				// ムーブ代入: 代入先の元の中身は解放され、移動元の中身に置き換わる
+				TargetClass<int, 3> assigned = HeapMultiDimAllocator::CreateArrayND<int>(1, 1, 1);
+				assigned = std::move(moved);
+				eq(assigned.begin() == sourceValues, true);
+				eq(assigned.GetExtent(0), SizeX);
+				eq(assigned.GetExtent(1), SizeY);
+				eq(assigned.GetExtent(2), SizeZ);
+				for (int x = 0; x < SizeX; ++x)
+					for (int y = 0; y < SizeY; ++y)
+						for (int z = 0; z < SizeZ; ++z)
+							eq(assigned[x][y][z], GetValue(x, y, z));
+				eq(moved.begin() == nullptr, true);
+
+				// 書き込みも、移動先から行える
+				assigned[1][2][3] = -1;
+				eq(assigned.At({ 1, 2, 3 }), -1);
+			}
+		};
+	}
+}
\ No newline at end of file
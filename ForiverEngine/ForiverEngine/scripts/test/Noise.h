@@ -0,0 +1,129 @@
+﻿#pragma once
+
+#include <scripts/test/IncludeInternal.h>
+
+namespace ForiverEngine
+{
+	namespace Test
+	{
+		struct Noise final
+		{
+		public:
+			DELETE_DEFAULT_METHODS(Noise);
+
+			static void RunAll()
+			{
+				Run_Batch2D_MatchesScalar();
+				Run_Batch3D_MatchesScalar();
+				Run_Grid_MatchesScalar();
+				Run_Batch_Remainder();
+			}
+
+			using TargetClass = ForiverEngine::Noise;
+
+			// 1つずつ求めた値との差の許容値 (演算の順番は同じなので、通常は一致する. コンパイラが元の実装を FMA に置き換えると、セルの境目付近で 6e-4 程度までずれる)
+			static constexpr float Tolerance = 1.0e-3f;
+
+#pragma region Helpers
+
+			// 再現できる乱数で、[-range, range) の座標を count 個作る
+			// 格子点・セルの対角線上など、分岐の境目になる座標も混ぜる
+			static std::vector<float> CreateCoordinates(std::uint32_t seed, int count, float range)
+			{
+				std::uint32_t random = seed;
+				std::vector<float> coordinates = {};
+				for (int i = 0; i < count; ++i)
+				{
+					random = random * 1664525u + 1013904223u;
+					const float value = (static_cast<float>(random >> 8) / static_cast<float>(1 << 24) * 2.0f - 1.0f) * range;
+					coordinates.push_back((i % 7 == 0) ? std::floor(value) : value);
+				}
+				return coordinates;
+			}
+
+			static void CheckNear(float value, float expected)
+			{
+				eq(std::abs(value - expected) <= Tolerance, true);
+			}
+
+#pragma endregion
+
+			static void Run_Batch2D_MatchesScalar()
+			{
+				constexpr int Count = 4099;
+				const std::vector<float> xs = CreateCoordinates(1, Count, 300.0f);
+				std::vector<float> ys = CreateCoordinates(2, Count, 300.0f);
+				for (int i = 0; i < Count; i += 11)
+					ys[i] = xs[i]; // x0 == y0 (三角形の境目)
+
+				std::vector<float> noises(Count);
+				TargetClass::Simplex2D(xs, ys, noises);
+				for (int i = 0; i < Count; ++i)
+					CheckNear(noises[i], TargetClass::Simplex2D(xs[i], ys[i]));
+			}
+
+			static void Run_Batch3D_MatchesScalar()
+			{
+				constexpr int Count = 4099;
+				const std::vector<float> xs = CreateCoordinates(3, Count, 300.0f);
+				std::vector<float> ys = CreateCoordinates(4, Count, 300.0f);
+				std::vector<float> zs = CreateCoordinates(5, Count, 300.0f);
+				for (int i = 0; i < Count; i += 13)
+					ys[i] = xs[i]; // x0 == y0 (四面体の境目)
+				for (int i = 5; i < Count; i += 13)
+					zs[i] = ys[i]; // y0 == z0
+
+				std::vector<float> noises(Count);
+				TargetClass::Simplex3D(xs, ys, zs, noises);
+				for (int i = 0; i < Count; ++i)
+					CheckNear(noises[i], TargetClass::Simplex3D(xs[i], ys[i], zs[i]));
+			}
+
+			static void Run_Grid_MatchesScalar()
+			{
+				// チャンクの列と同じ並び (x が外側)
+				{
+					const Vector2 origin = Vector2(-37.5f, 1250.25f);
+					const Vector2 step = Vector2(0.015f, 0.02f);
+					const Lattice2 count = Lattice2(17, 13);
+					std::vector<float> noises(static_cast<std::size_t>(count.x) * count.y);
+					TargetClass::Simplex2DGrid(noises, origin, step, count);
+					for (int xi = 0; xi < count.x; ++xi)
+						for (int yi = 0; yi < count.y; ++yi)
+							CheckNear(noises[xi * count.y + yi], TargetClass::Simplex2D(origin.x + step.x * xi, origin.y + step.y * yi));
+				}
+
+				{
+					const Vector3 origin = Vector3(512.0f, -3.0f, 77.7f);
+					const Vector3 step = Vector3(0.25f, 0.125f, 0.3f);
+					const Lattice3 count = Lattice3(5, 9, 11);
+					std::vector<float> noises(static_cast<std::size_t>(count.x) * count.y * count.z);
+					TargetClass::Simplex3DGrid(noises, origin, step, count);
+					for (int xi = 0; xi < count.x; ++xi)
+						for (int yi = 0; yi < count.y; ++yi)
+							for (int zi = 0; zi < count.z; ++zi)
+								CheckNear(noises[(xi * count.y + yi) * count.z + zi],
+									TargetClass::Simplex3D(origin.x + step.x * xi, origin.y + step.y * yi, origin.z + step.z * zi));
+				}
+			}
+
+			static void Run_Batch_Remainder()
+			{
+				// レーン数で割り切れない個数でも、範囲外に書き込まない
+				const int laneCount = SimplexNoiseBatch::GetLaneCount();
+				const std::vector<float> xs = CreateCoordinates(6, laneCount * 2 + 1, 50.0f);
+				const std::vector<float> ys = CreateCoordinates(7, laneCount * 2 + 1, 50.0f);
+				for (int count = 0; count <= laneCount * 2 + 1; ++count)
+				{
+					constexpr float Guard = 123.0f;
+					std::vector<float> noises(count + 1, Guard);
+					TargetClass::Simplex2D(std::span(xs).first(count), std::span(ys).first(count), std::span(noises).first(count));
+					TargetClass::Simplex3D(std::span(xs).first(count), std::span(ys).first(count), std::span(xs).first(count), std::span(noises).first(count));
+					for (int i = 0; i < count; ++i)
+						CheckNear(noises[i], TargetClass::Simplex3D(xs[i], ys[i], xs[i]));
+					eq(noises[count], Guard);
+				}
+			}
+		};
+	}
+}
\ No newline at end of file
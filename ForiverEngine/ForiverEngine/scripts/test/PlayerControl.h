@@ -167,7 +167,8 @@ namespace ForiverEngine
 					Chunk::ChunksArray<Chunk> chunks;
 				};
 
-				const ChunksManager_Dummy* chunksManager_Dummy = reinterpret_cast<const ChunksManager_Dummy*>(&chunksManager);
+				// 書き込み時にメモリが確保されるので、非 const でアクセスする
+				ChunksManager_Dummy* chunksManager_Dummy = reinterpret_cast<ChunksManager_Dummy*>(const_cast<ChunksManager*>(&chunksManager));
 				chunksManager_Dummy->chunks[chunkIndex.x][chunkIndex.y] = std::move(newChunk);
 			}
 
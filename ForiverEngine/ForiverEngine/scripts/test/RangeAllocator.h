@@ -0,0 +1,229 @@
+﻿#pragma once
+
+#include <scripts/test/IncludeInternal.h>
+
+namespace ForiverEngine
+{
+	namespace Test
+	{
+		struct RangeAllocator final
+		{
+		public:
+			DELETE_DEFAULT_METHODS(RangeAllocator);
+
+			static void RunAll()
+			{
+				Run_AllocateFirstFit();
+				Run_AllocateOverCapacity();
+				Run_FreeCoalesce();
+				Run_HandleReuse();
+				Run_Defragment();
+				Run_Defragment_Random();
+			}
+
+			using TargetClass = ForiverEngine::RangeAllocator;
+			using Handle = TargetClass::Handle;
+
+#pragma region Helpers
+
+			// 区間の中身を、ハンドルの値で埋める (移動後に、中身が保たれているか確かめるため)
+			static void Fill(std::vector<int>& memory, const TargetClass& allocator, Handle handle)
+			{
+				std::fill_n(memory.begin() + allocator.GetOffset(handle), allocator.GetSize(handle), static_cast<int>(handle));
+			}
+
+			// Defragment() の移動を、その順に memmove する
+			static void ApplyMoves(std::vector<int>& memory, const std::vector<TargetClass::Move>& moves)
+			{
+				for (const TargetClass::Move& move : moves)
+				{
+					eq(move.toOffset < move.fromOffset, true);
+					std::memmove(memory.data() + move.toOffset, memory.data() + move.fromOffset, static_cast<std::size_t>(move.size) * sizeof(int));
+				}
+			}
+
+			// 区間の中身が、ハンドルの値で埋まっているか
+			static void CheckFilled(const std::vector<int>& memory, const TargetClass& allocator, Handle handle)
+			{
+				for (int i = 0; i < allocator.GetSize(handle); ++i)
+					eq(memory[allocator.GetOffset(handle) + i], static_cast<int>(handle));
+			}
+
+#pragma endregion
+
+			static void Run_AllocateFirstFit()
+			{
+				TargetClass allocator(100);
+				const Handle a = allocator.Allocate(30);
+				const Handle b = allocator.Allocate(30);
+				const Handle c = allocator.Allocate(40);
+				eq(allocator.GetOffset(a), 0);
+				eq(allocator.GetOffset(b), 30);
+				eq(allocator.GetOffset(c), 60);
+				eq(allocator.GetUsedSize(), 100);
+				eq(allocator.GetFreeRangeCount(), 0);
+
+				// 空いた区間の先頭から詰める
+				allocator.Free(b);
+				const Handle d = allocator.Allocate(10);
+				const Handle e = allocator.Allocate(10);
+				eq(allocator.GetOffset(d), 30);
+				eq(allocator.GetOffset(e), 40);
+				eq(allocator.GetFreeSize(), 10);
+				eq(allocator.GetLargestFreeSize(), 10);
+				eq(allocator.GetAllocationCount(), 4);
+			}
+
+			static void Run_AllocateOverCapacity()
+			{
+				TargetClass allocator(64);
+				const Handle tooLarge = allocator.Allocate(65);
+				eq(tooLarge, TargetClass::InvalidHandle);
+
+				// 空きの合計は足りていても、連続していなければ確保できない
+				std::vector<Handle> handles = {};
+				for (int i = 0; i < 8; ++i)
+					handles.push_back(allocator.Allocate(8));
+				for (int i = 0; i < 8; i += 2)
+					allocator.Free(handles[i]);
+				eq(allocator.GetFreeSize(), 32);
+				eq(allocator.GetLargestFreeSize(), 8);
+				const Handle fragmented = allocator.Allocate(16);
+				eq(fragmented, TargetClass::InvalidHandle);
+			}
+
+			static void Run_FreeCoalesce()
+			{
+				TargetClass allocator(100);
+				const Handle a = allocator.Allocate(25);
+				const Handle b = allocator.Allocate(25);
+				const Handle c = allocator.Allocate(25);
+				const Handle d = allocator.Allocate(25);
+
+				allocator.Free(a);
+				allocator.Free(c);
+				eq(allocator.GetFreeRangeCount(), 2);
+
+				// 前後の空き区間と結合して、1つになる
+				allocator.Free(b);
+				eq(allocator.GetFreeRangeCount(), 1);
+				eq(allocator.GetLargestFreeSize(), 75);
+
+				allocator.Free(d);
+				eq(allocator.GetFreeRangeCount(), 1);
+				eq(allocator.GetLargestFreeSize(), 100);
+				eq(allocator.GetAllocationCount(), 0);
+
+				const Handle all = allocator.Allocate(100);
+				eq(allocator.GetOffset(all), 0);
+			}
+
+			static void Run_HandleReuse()
+			{
+				TargetClass allocator(16);
+				const Handle a = allocator.Allocate(4);
+				const Handle b = allocator.Allocate(4);
+				eq(allocator.IsValid(a), true);
+
+				allocator.Free(a);
+				eq(allocator.IsValid(a), false);
+				eq(allocator.IsValid(b), true);
+
+				// 解放したハンドルを再利用する
+				const Handle c = allocator.Allocate(8);
+				eq(c, a);
+				eq(allocator.GetOffset(c), 8);
+				eq(allocator.GetSize(c), 8);
+			}
+
+			static void Run_Defragment()
+			{
+				TargetClass allocator(100);
+				std::vector<int> memory(100, -1);
+
+				std::vector<Handle> handles = {};
+				for (int i = 0; i < 10; ++i)
+				{
+					handles.push_back(allocator.Allocate(10));
+					Fill(memory, allocator, handles.back());
+				}
+				for (int i = 0; i < 10; i += 3)
+					allocator.Free(handles[i]);
+				eq(allocator.GetLargestFreeSize(), 10);
+
+				ApplyMoves(memory, allocator.Defragment());
+				eq(allocator.GetFreeRangeCount(), 1);
+				eq(allocator.GetLargestFreeSize(), 40);
+
+				// 先頭から隙間なく、元の順に並ぶ
+				int offset = 0;
+				for (int i = 0; i < 10; ++i)
+				{
+					if (i % 3 == 0)
+						continue;
+					eq(allocator.GetOffset(handles[i]), offset);
+					CheckFilled(memory, allocator, handles[i]);
+					offset += 10;
+				}
+
+				// 詰めた後は、まとまった区間を確保できる
+				const Handle large = allocator.Allocate(40);
+				eq(allocator.GetOffset(large), 60);
+
+				// 詰まっていれば、何も移動しない
+				eq(allocator.Defragment().empty(), true);
+			}
+
+			static void Run_Defragment_Random()
+			{
+				constexpr int Capacity = 4096;
+				TargetClass allocator(Capacity);
+				std::vector<int> memory(Capacity, -1);
+				std::vector<Handle> handles = {};
+
+				std::uint32_t random = 12345;
+				const auto next = [&random](int max)
+					{
+						random = random * 1664525u + 1013904223u;
+						return static_cast<int>((random >> 8) % static_cast<std::uint32_t>(max));
+					};
+
+				for (int step = 0; step < 2000; ++step)
+				{
+					if (handles.empty() || next(3) != 0)
+					{
+						const Handle handle = allocator.Allocate(next(64) + 1);
+						if (handle != TargetClass::InvalidHandle)
+						{
+							Fill(memory, allocator, handle);
+							handles.push_back(handle);
+						}
+					}
+					else
+					{
+						const int i = next(static_cast<int>(handles.size()));
+						allocator.Free(handles[i]);
+						handles.erase(handles.begin() + i);
+					}
+
+					if (step % 500 == 499)
+					{
+						ApplyMoves(memory, allocator.Defragment());
+						eq(allocator.GetLargestFreeSize(), allocator.GetFreeSize());
+						for (const Handle handle : handles)
+							CheckFilled(memory, allocator, handle);
+					}
+				}
+
+				int usedSize = 0;
+				for (const Handle handle : handles)
+				{
+					CheckFilled(memory, allocator, handle);
+					usedSize += allocator.GetSize(handle);
+				}
+				eq(allocator.GetUsedSize(), usedSize);
+				eq(allocator.GetAllocationCount(), static_cast<int>(handles.size()));
+			}
+		};
+	}
+}
\ No newline at end of file
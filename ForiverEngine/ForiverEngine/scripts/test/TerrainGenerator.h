@@ -0,0 +1,523 @@
+﻿#pragma once
+
+#include <scripts/test/IncludeInternal.h>
+
+#include <thread>
+
+namespace ForiverEngine
+{
+	namespace Test
+	{
+		struct TerrainGenerator final
+		{
+		public:
+			DELETE_DEFAULT_METHODS(TerrainGenerator);
+
+			static void RunAll()
+			{
+				Run_SingleOctave_MatchesCreateFromNoise();
+				Run_Cache_MatchesUncached();
+				Run_Cache_Parallel();
+				Run_Continuity();
+				Run_HeightCurve();
+				Run_PaletteArrayFill();
+				Run_FillColumn_MatchesSetBlock();
+				Run_CreateFromHeights_MatchesPerBlock();
+				Run_Density_Disabled_MatchesHeights();
+				Run_Density_LatticePoints_MatchFullResolution();
+				Run_Density_Features();
+				Run_Decoration_CrossesBorders();
+				Run_Decoration_OrderIndependent();
+			}
+
+			using TargetClass = ForiverEngine::TerrainGenerator;
+			using Settings = TerrainGenerationSettings;
+
+#pragma region Helpers
+
+			// 再現できる乱数 ([0, max))
+			static int NextRandom(std::uint32_t& random, int max)
+			{
+				random = random * 1664525u + 1013904223u;
+				return static_cast<int>((random >> 8) % static_cast<std::uint32_t>(max));
+			}
+
+			// 2つのチャンクの、ブロック・占有ビットマスク・ハイトマップが一致するか
+			// 差分更新している最小/最大の高さは、列の高さから求めたものとも比べる
+			static void CheckSameChunk(const Chunk& chunk, const Chunk& expected)
+			{
+				int minHeight = Chunk::Height;
+				int maxHeight = -1;
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+					{
+						minHeight = std::min(minHeight, expected.GetColumnHeight({ x, z }));
+						maxHeight = std::max(maxHeight, expected.GetColumnHeight({ x, z }));
+					}
+				eq(expected.GetMinHeight(), minHeight);
+				eq(expected.GetMaxHeight(), maxHeight);
+
+				for (int x = 0; x < Chunk::Size; ++x)
+					for (int z = 0; z < Chunk::Size; ++z)
+					{
+						for (int y = 0; y < Chunk::Height; ++y)
+							eqen(chunk.GetBlock({ x, y, z }), expected.GetBlock({ x, y, z }));
+						for (int kind = 0; kind < static_cast<int>(OccupancyKind::Count); ++kind)
+							for (int wordIndex = 0; wordIndex < Chunk::OccupancyWordsPerColumn; ++wordIndex)
+								eq(chunk.GetOccupancyColumn({ x, z }, static_cast<OccupancyKind>(kind))[wordIndex],
+									expected.GetOccupancyColumn({ x, z }, static_cast<OccupancyKind>(kind))[wordIndex]);
+						eq(chunk.GetColumnHeight({ x, z }), expected.GetColumnHeight({ x, z }));
+					}
+				eq(chunk.GetMinHeight(), expected.GetMinHeight());
+				eq(chunk.GetMaxHeight(), expected.GetMaxHeight());
+			}
+
+#pragma endregion
+
+			static void Run_SingleOctave_MatchesCreateFromNoise()
+			{
+				TargetClass generator = TargetClass(Settings::CreateSingleOctave());
+				for (const Lattice2& chunkIndex : { Lattice2(0, 0), Lattice2(7, 3), Lattice2(Chunk::Count / 2, Chunk::Count / 2 + 1) })
+				{
+					// 同じ引数の CreateFromNoise() と、ブロック単位で一致する
+					const Chunk expected = Chunk::CreateFromNoise(chunkIndex, { 0.015f, 12.0f }, 16, 18, 24);
+					const Chunk chunk = generator.CreateChunk(chunkIndex);
+					for (int x = 0; x < Chunk::Size; ++x)
+						for (int z = 0; z < Chunk::Size; ++z)
+						{
+							eq(chunk.GetColumnHeight({ x, z }), expected.GetColumnHeight({ x, z }));
+							for (int y = 0; y <= expected.GetColumnHeight({ x, z }) + 1; ++y)
+								eqen(chunk.GetBlock({ x, y, z }), expected.GetBlock({ x, y, z }));
+						}
+
+					const Chunk::SurfaceMap surfaceMap = generator.CreateSurfaceMap(chunkIndex);
+					const Chunk::SurfaceMap expectedSurfaceMap = expected.CreateSurfaceMap();
+					eq(surfaceMap.heights == expectedSurfaceMap.heights, true);
+					eq(surfaceMap.blocks == expectedSurfaceMap.blocks, true);
+				}
+			}
+
+			static void Run_Cache_MatchesUncached()
+			{
+				// 3D の密度を使うと、地表は近似になるので使わない
+				Settings settings = Settings::CreateFractal();
+				settings.overhangAmplitude = 0.0f;
+				settings.caveThreshold = 1.0f;
+				TargetClass generator = TargetClass(settings);
+				const Lattice2 chunkIndex = Lattice2(100, 200);
+
+				eq(generator.IsCached(chunkIndex), false);
+				eq(generator.GetMemoryUsage() < 64ull * 1024, true); // タイルは、使うまで確保しない
+
+				const Chunk::ColumnHeights expected = TargetClass::CalculateColumnHeights(settings, chunkIndex);
+				eq(generator.GetColumnHeights(chunkIndex) == expected, true);
+				eq(generator.IsCached(chunkIndex), true);
+				eq(generator.IsCached(chunkIndex + Lattice2(1, 0)), false); // 同じタイルでも、チャンク単位で埋める
+				eq(generator.GetColumnHeights(chunkIndex) == expected, true);
+
+				// 地形と地表は、同じ高さから作る
+				const Chunk chunk = generator.CreateChunk(chunkIndex);
+				const Chunk::SurfaceMap surfaceMap = generator.CreateSurfaceMap(chunkIndex);
+				eq(chunk.CreateSurfaceMap().heights == surfaceMap.heights, true);
+				eq(chunk.CreateSurfaceMap().blocks == surfaceMap.blocks, true);
+
+				// 解放すると、キャッシュから消える (求め直しても同じ値)
+				generator.ReleaseRegion(chunkIndex);
+				eq(generator.IsCached(chunkIndex), false);
+				eq(generator.GetColumnHeights(chunkIndex) == expected, true);
+			}
+
+			static void Run_Cache_Parallel()
+			{
+				const Settings settings = Settings::CreateFractal();
+				TargetClass generator = TargetClass(settings);
+
+				// 複数スレッドが、同じチャンク群を同時に求める
+				constexpr int ThreadCount = 4;
+				constexpr int ChunkCountPerSide = 6;
+				std::vector<std::thread> threads = {};
+				std::array<std::vector<Chunk::ColumnHeights>, ThreadCount> results = {};
+				for (int t = 0; t < ThreadCount; ++t)
+					threads.emplace_back([&, t]()
+						{
+							for (int i = 0; i < ChunkCountPerSide * ChunkCountPerSide; ++i)
+								results[t].push_back(generator.GetColumnHeights({ 30 + i / ChunkCountPerSide, 30 + i % ChunkCountPerSide }));
+						});
+				for (std::thread& thread : threads)
+					thread.join();
+
+				for (int i = 0; i < ChunkCountPerSide * ChunkCountPerSide; ++i)
+				{
+					const Lattice2 chunkIndex = Lattice2(30 + i / ChunkCountPerSide, 30 + i % ChunkCountPerSide);
+					const Chunk::ColumnHeights expected = TargetClass::CalculateColumnHeights(settings, chunkIndex);
+					eq(generator.IsCached(chunkIndex), true);
+					for (int t = 0; t < ThreadCount; ++t)
+						eq(results[t][i] == expected, true);
+				}
+			}
+
+			static void Run_Continuity()
+			{
+				// チャンクの境界 (リージョンの境界 31 | 32 も含む) をまたいでも、隣り合う列の高さの差が、チャンク内と同程度
+				const Settings settings = Settings::CreateFractal();
+				TargetClass generator = TargetClass(settings);
+				constexpr int ChunkCount = 4;
+				constexpr int FirstChunk = Chunk::RegionSize - ChunkCount / 2;
+				constexpr int ColumnCount = ChunkCount * Chunk::Size;
+
+				const auto getHeight = [&](int worldX, int worldZ)
+					{
+						const Chunk::ColumnHeights heights = generator.GetColumnHeights({ worldX / Chunk::Size, worldZ / Chunk::Size });
+						return static_cast<int>(heights[(worldX % Chunk::Size) * Chunk::Size + worldZ % Chunk::Size]);
+					};
+
+				int maxInnerStep = 0;
+				int maxBorderStep = 0;
+				int minHeight = Chunk::Height;
+				int maxHeight = 0;
+				for (int x = FirstChunk * Chunk::Size; x < FirstChunk * Chunk::Size + ColumnCount - 1; ++x)
+					for (int z = FirstChunk * Chunk::Size; z < FirstChunk * Chunk::Size + ColumnCount - 1; ++z)
+					{
+						const int height = getHeight(x, z);
+						const int step = std::max(std::abs(getHeight(x + 1, z) - height), std::abs(getHeight(x, z + 1) - height));
+						const bool isBorder = ((x + 1) % Chunk::Size == 0) || ((z + 1) % Chunk::Size == 0);
+						int& maxStep = isBorder ? maxBorderStep : maxInnerStep;
+						maxStep = std::max(maxStep, step);
+						minHeight = std::min(minHeight, height);
+						maxHeight = std::max(maxHeight, height);
+					}
+
+				eq(maxBorderStep <= std::max(maxInnerStep, 1) * 2, true);
+				eq(minHeight >= settings.heightBulk, true);
+				eq(maxHeight <= settings.heightBulk + static_cast<int>(settings.heightAmplitude), true);
+				eq(maxHeight > minHeight, true);
+			}
+
+			static void Run_HeightCurve()
+			{
+				// 一定値のカーブなら、全列が同じ高さになる
+				Settings settings = Settings::CreateFractal();
+				settings.heightCurve = { 0.5f, 0.5f, 0.5f };
+				const Chunk::ColumnHeights flatHeights = TargetClass::CalculateColumnHeights(settings, { 5, 9 });
+				for (const std::int16_t height : flatHeights)
+					eq(static_cast<int>(height), settings.heightBulk + static_cast<int>(0.5f * settings.heightAmplitude));
+
+				// 恒等のカーブなら、カーブ無しと一致する
+				settings.heightCurve = { 0.0f, 1.0f };
+				const Chunk::ColumnHeights identityHeights = TargetClass::CalculateColumnHeights(settings, { 5, 9 });
+				settings.heightCurve = {};
+				eq(identityHeights == TargetClass::CalculateColumnHeights(settings, { 5, 9 }), true);
+
+				// 高さは Chunk の範囲に収まる
+				settings.heightBulk = Chunk::Height - 4;
+				for (const std::int16_t height : TargetClass::CalculateColumnHeights(settings, { 5, 9 }))
+					eq(height >= 0 && height <= Chunk::Height - 1, true);
+			}
+
+			static void Run_PaletteArrayFill()
+			{
+				// 値の種類を増やしていき、全ての bit 幅 (0, 1, 2, 4, 8, 16) で、範囲の埋め方を確かめる
+				constexpr int Size = 4096;
+				PaletteArray<int> array = PaletteArray<int>(Size, 0);
+				std::vector<int> expected(Size, 0);
+
+				std::uint32_t random = 777;
+				for (int step = 0; step < 3000; ++step)
+				{
+					const int value = NextRandom(random, 1 + std::min(step / 8, 400));
+					const int begin = NextRandom(random, Size);
+					const int count = (step % 5 == 0) ? 1 : NextRandom(random, std::min(Size - begin, 200)) + 1;
+					array.Fill(begin, count, value);
+					std::fill_n(expected.begin() + begin, count, value);
+
+					if (step % 100 == 0)
+						for (int i = 0; i < Size; ++i)
+							eq(array.Get(i), expected[i]);
+				}
+				eq(array.GetBitsPerEntry(), 16);
+				for (int i = 0; i < Size; ++i)
+					eq(array.Get(i), expected[i]);
+
+				// 詰め直しても、値は変わらない
+				array.Compact();
+				for (int i = 0; i < Size; ++i)
+					eq(array.Get(i), expected[i]);
+
+				// 範囲ごとに同じ値で埋め尽くしたら、詰め直すと一様になる
+				array.Fill(0, Size / 2, 7);
+				array.Fill(Size / 2, Size / 2, 7);
+				eq(array.IsUniform(), false);
+				array.Compact();
+				eq(array.IsUniform(), true);
+				eq(array.Get(0), 7);
+
+				// 全要素を埋めると、一様に戻る
+				array.Fill(0, Size, 5);
+				eq(array.IsUniform(), true);
+				eq(array.Get(Size - 1), 5);
+
+				// 一様なまま同じ値で埋めても、ワード配列を確保しない
+				array.Fill(10, 20, 5);
+				eq(array.IsUniform(), true);
+			}
+
+			static void Run_FillColumn_MatchesSetBlock()
+			{
+				constexpr Block Blocks[] = { Block::Air, Block::Stone, Block::Dirt, Block::Grass, Block::Sand };
+				Chunk chunk = Chunk::CreateVoid();
+				Chunk expected = Chunk::CreateVoid();
+
+				// ワード (縦64ブロック)・セクションの境界をまたぐ範囲や、範囲外にはみ出す範囲も混ぜる
+				std::uint32_t random = 4242;
+				for (int step = 0; step < 600; ++step)
+				{
+					const Lattice2 positionXZ = Lattice2(NextRandom(random, 4), NextRandom(random, 4));
+					const int minY = NextRandom(random, Chunk::Height + 8) - 4;
+					const int maxY = minY + NextRandom(random, (step % 3 == 0) ? 150 : 20);
+					const Block block = Blocks[(step % 4 == 0) ? 0 : NextRandom(random, 5)];
+
+					chunk.FillColumn(positionXZ, minY, maxY, block);
+					for (int y = std::max(minY, 0); y <= std::min(maxY, Chunk::Height - 1); ++y)
+						expected.SetBlock({ positionXZ.x, y, positionXZ.y }, block);
+
+					if (step % 50 == 0)
+						CheckSameChunk(chunk, expected);
+				}
+				CheckSameChunk(chunk, expected);
+
+				// 空の範囲は何もしない
+				chunk.FillColumn({ 0, 0 }, 10, 9, Block::Stone);
+				chunk.FillColumn({ 0, 0 }, Chunk::Height, Chunk::Height + 10, Block::Stone);
+				CheckSameChunk(chunk, expected);
+			}
+
+			static void Run_CreateFromHeights_MatchesPerBlock()
+			{
+				// 高さ・帯の境目 (砂/土/石) の全ての組み合わせを含む高さ
+				Chunk::ColumnHeights heights;
+				for (int i = 0; i < Chunk::Size * Chunk::Size; ++i)
+					heights[i] = static_cast<std::int16_t>((i * 7) % 80);
+				heights[0] = 0;
+				heights[1] = Chunk::Height - 1;
+
+				for (const auto& [minDirtHeight, minStoneHeight] : { std::pair(18, 24), std::pair(20, 44), std::pair(30, 10), std::pair(0, 0) })
+				{
+					// SetBlock() でブロックごとに埋めたもの
+					Chunk expected = Chunk::CreateVoid();
+					for (int x = 0; x < Chunk::Size; ++x)
+						for (int z = 0; z < Chunk::Size; ++z)
+						{
+							const int height = heights[x * Chunk::Size + z];
+							for (int y = 0; y <= height; ++y)
+							{
+								Block block = Block::Sand;
+								if (y >= minStoneHeight)
+									block = Block::Stone;
+								else if (y >= minDirtHeight)
+									block = (y == height) ? Block::Grass : Block::Dirt;
+								expected.SetBlock({ x, y, z }, block);
+							}
+						}
+					expected.Compact();
+
+					const Chunk chunk = Chunk::CreateFromHeights(heights, minDirtHeight, minStoneHeight);
+					CheckSameChunk(chunk, expected);
+					for (int sectionIndex = 0; sectionIndex < Chunk::SectionCount; ++sectionIndex)
+						eq(chunk.IsSectionUniform(sectionIndex), expected.IsSectionUniform(sectionIndex));
+				}
+			}
+
+			static void Run_Density_Disabled_MatchesHeights()
+			{
+				Settings settings = Settings::CreateFractal();
+				settings.overhangAmplitude = 0.0f;
+				settings.caveThreshold = 1.0f;
+				eq(settings.HasDensity(), false);
+
+				// 密度を使わないなら、各列の高さまで埋まったマスク
+				const Lattice2 chunkIndex = Lattice2(300, 301);
+				const Chunk::ColumnHeights heights = TargetClass::CalculateColumnHeights(settings, chunkIndex);
+				const Chunk::ColumnMasks masks = TargetClass::CalculateColumnMasks(settings, chunkIndex, heights);
+				for (int i = 0; i < Chunk::Size * Chunk::Size; ++i)
+					for (int y = 0; y < Chunk::Height; ++y)
+						eq(((masks[i][y >> 6] >> (y & 63)) & 1) != 0, y <= heights[i]);
+
+				// マスクから作っても、高さから作ったチャンクと一致する
+				CheckSameChunk(
+					Chunk::CreateFromColumnMasks(masks, settings.minDirtHeight, settings.minStoneHeight),
+					Chunk::CreateFromHeights(heights, settings.minDirtHeight, settings.minStoneHeight));
+			}
+
+			static void Run_Density_LatticePoints_MatchFullResolution()
+			{
+				// 格子点では補間が効かないので、全ブロックでノイズを求めた場合 (間隔 1) と一致する
+				// (ノイズの配列版は、端数の要素を別の経路で求めるので、境目ぎりぎりの点はずれうる. ごく僅かなら許容する)
+				Settings settings = Settings::CreateFractal();
+				settings.overhangAmplitude = 10.0f;
+				settings.caveThreshold = 0.3f;
+				Settings fullSettings = settings;
+				fullSettings.densityStride = Lattice3(1, 1, 1);
+
+				int pointCount = 0;
+				int mismatchCount = 0;
+				for (const Lattice2& chunkIndex : { Lattice2(40, 40), Lattice2(41, 40) })
+				{
+					const Chunk::ColumnHeights heights = TargetClass::CalculateColumnHeights(settings, chunkIndex);
+					const Chunk::ColumnMasks masks = TargetClass::CalculateColumnMasks(settings, chunkIndex, heights);
+					const Chunk::ColumnMasks fullMasks = TargetClass::CalculateColumnMasks(fullSettings, chunkIndex, heights);
+					for (int x = 0; x < Chunk::Size; x += settings.densityStride.x)
+						for (int z = 0; z < Chunk::Size; z += settings.densityStride.z)
+							for (int y = 0; y < Chunk::Height; y += settings.densityStride.y)
+							{
+								const int i = x * Chunk::Size + z;
+								++pointCount;
+								if (((masks[i][y >> 6] ^ fullMasks[i][y >> 6]) >> (y & 63)) & 1)
+									++mismatchCount;
+							}
+				}
+				eq(mismatchCount * 200 <= pointCount, true);
+			}
+
+			static void Run_Density_Features()
+			{
+				const Settings settings = Settings::CreateFractal();
+				eq(settings.HasDensity(), true);
+				TargetClass generator = TargetClass(settings);
+
+				int carvedCount = 0;   // 高さより下の空気 (洞窟)
+				int overhangCount = 0; // 高さより上のブロック (オーバーハング・浮島)
+				for (int xi = 0; xi < 3; ++xi)
+					for (int zi = 0; zi < 3; ++zi)
+					{
+						const Lattice2 chunkIndex = Lattice2(200 + xi, 200 + zi);
+						const Chunk::ColumnHeights heights = generator.GetColumnHeights(chunkIndex);
+						const Chunk chunk = generator.CreateChunk(chunkIndex);
+						for (int x = 0; x < Chunk::Size; ++x)
+							for (int z = 0; z < Chunk::Size; ++z)
+							{
+								const int height = heights[x * Chunk::Size + z];
+
+								// ワールドの底は塞がっている
+								eq(BlockProperties::IsSolid(chunk.GetBlock({ x, 0, z })), true);
+								// 盛る高さより上には、何も無い
+								eq(chunk.GetColumnHeight({ x, z }) <= height + static_cast<int>(std::ceil(settings.overhangAmplitude)), true);
+
+								for (int y = 0; y < Chunk::Height; ++y)
+								{
+									const Block block = chunk.GetBlock({ x, y, z });
+									const bool isSolid = BlockProperties::IsSolid(block);
+									carvedCount += (y <= height && !isSolid) ? 1 : 0;
+									overhangCount += (y > height && isSolid) ? 1 : 0;
+
+									// 列の最も高いブロックのみ、土の高度なら草 (洞窟の床などは土)
+									if (isSolid && y >= settings.minDirtHeight && y < settings.minStoneHeight)
+										eqen(block, (y == chunk.GetColumnHeight({ x, z })) ? Block::Grass : Block::Dirt);
+								}
+							}
+					}
+				eq(carvedCount > 0, true);
+				eq(overhangCount > 0, true);
+			}
+
+			// 岩の多い設定 (3D の密度は使わない)
+			static Settings CreateBoulderSettings()
+			{
+				Settings settings = Settings::CreateFractal();
+				settings.overhangAmplitude = 0.0f;
+				settings.caveThreshold = 1.0f;
+				settings.boulderAttemptCount = 8;
+				settings.boulderChance = 1.0f;
+				settings.boulderMinRadius = 2;
+				settings.boulderMaxRadius = 3;
+				return settings;
+			}
+
+			// origin を中心に 5x5 のチャンクを生成し、中心の 3x3 のチャンクの装飾を、周囲 3x3 に書き込む
+			// 戻り値のインデックスは (dx + 2) * 5 + (dz + 2)
+			static std::vector<Chunk> CreateDecoratedChunks(TargetClass& generator, const Lattice2& origin)
+			{
+				std::vector<Chunk> chunks = {};
+				for (int dx = -2; dx <= 2; ++dx)
+					for (int dz = -2; dz <= 2; ++dz)
+						chunks.push_back(generator.CreateChunk(origin + Lattice2(dx, dz)));
+
+				for (int sx = -1; sx <= 1; ++sx)
+					for (int sz = -1; sz <= 1; ++sz)
+					{
+						TargetClass::Neighborhood targets = {};
+						for (int dx = -1; dx <= 1; ++dx)
+							for (int dz = -1; dz <= 1; ++dz)
+								targets[TargetClass::GetNeighborhoodIndex({ dx, dz })] = &chunks[(sx + dx + 2) * 5 + (sz + dz + 2)];
+						generator.Decorate(origin + Lattice2(sx, sz), targets);
+					}
+				return chunks;
+			}
+
+			static void Run_Decoration_CrossesBorders()
+			{
+				eq(Settings::CreateSingleOctave().HasDecoration(), false);
+				eq(TargetClass(Settings::CreateSingleOctave()).CalculateBoulders({ 300, 300 }).empty(), true);
+
+				const Settings settings = CreateBoulderSettings();
+				TargetClass generator = TargetClass(settings);
+				const Lattice2 origin = Lattice2(300, 300);
+				const std::vector<Chunk> chunks = CreateDecoratedChunks(generator, origin);
+				const Chunk& center = chunks[2 * 5 + 2];
+
+				// 同じチャンクには、何度求めても同じ岩を置く
+				const std::vector<TargetClass::Boulder> boulders = generator.CalculateBoulders(origin);
+				eq(boulders.empty(), false);
+				eq(TargetClass(settings).CalculateBoulders(origin).size(), boulders.size());
+
+				int crossingCount = 0;
+				for (const TargetClass::Boulder& boulder : boulders)
+				{
+					// 岩の中心から軸方向に半径だけ離れたマスまで、石で埋まる
+					const Lattice3& c = boulder.center;
+					eqen(center.GetBlock(c), Block::Stone);
+					if (c.y + boulder.radius < Chunk::Height)
+						eqen(center.GetBlock(c + Lattice3(0, boulder.radius, 0)), Block::Stone);
+					eq(center.GetColumnHeight({ c.x, c.z }) >= c.y + boulder.radius, true);
+
+					// はみ出した部分は、隣接チャンクに書き込まれる
+					if (c.x + boulder.radius >= Chunk::Size)
+					{
+						eqen(chunks[3 * 5 + 2].GetBlock({ c.x + boulder.radius - Chunk::Size, c.y, c.z }), Block::Stone);
+						++crossingCount;
+					}
+					if (c.z - boulder.radius < 0)
+					{
+						eqen(chunks[2 * 5 + 1].GetBlock({ c.x, c.y, c.z - boulder.radius + Chunk::Size }), Block::Stone);
+						++crossingCount;
+					}
+				}
+				eq(crossingCount > 0, true);
+			}
+
+			static void Run_Decoration_OrderIndependent()
+			{
+				TargetClass generator = TargetClass(CreateBoulderSettings());
+				const Lattice2 origin = Lattice2(300, 300);
+				std::vector<Chunk> chunks = CreateDecoratedChunks(generator, origin);
+				const Chunk& expected = chunks[2 * 5 + 2];
+
+				// 周囲のチャンクの装飾を、後から中心のチャンクだけに書き込んでも (アンロード後の再生成)、同じになる
+				Chunk chunk = generator.CreateChunk(origin);
+				for (int sx = 1; sx >= -1; --sx)
+					for (int sz = 1; sz >= -1; --sz)
+					{
+						TargetClass::Neighborhood targets = {};
+						targets[TargetClass::GetNeighborhoodIndex({ -sx, -sz })] = &chunk;
+						generator.Decorate(origin + Lattice2(sx, sz), targets);
+					}
+				CheckSameChunk(chunk, expected);
+
+				// 同じ装飾を2回書き込んでも、変わらない
+				TargetClass::Neighborhood targets = {};
+				targets[TargetClass::GetNeighborhoodIndex(Lattice2::Zero())] = &chunk;
+				generator.Decorate(origin, targets);
+				CheckSameChunk(chunk, expected);
+			}
+		};
+	}
+}
\ No newline at end of file
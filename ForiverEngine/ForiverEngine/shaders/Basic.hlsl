@@ -20,27 +20,25 @@ cbuffer _1 : register(b1)
     float4 _ShadowColor;
 }
 
+// ドローコールごとのルート定数
+cbuffer _2 : register(b2)
+{
+    float3 _ChunkOrigin; // 描画するチャンクの原点 (ワールド座標. LOD はリージョンの原点)
+}
+
 Texture2DArray<float4> _Texture : register(t0);
 Texture2D<float> _ShadowDepthTexture : register(t1);
 SamplerState _Sampler : register(s0);
 
-struct VSInput
-{
-    float4 pos : POSITION;
-    float2 uv : TEXCOORD0;
-    float3 normal : NORMAL;
-    float3 centerWorldPosition : CENTERPOS;
-    uint texIndex : TEXINDEX;
-};
-
 struct V2P
 {
     float4 pos : SV_POSITION;
     float2 uv : TEXCOORD0;
     float3 normal : NORMAL;
     float3 worldPos : TEXCOORD1;
-    nointerpolation float3 centerWorldPosition : CENTERPOS;
+    nointerpolation float2 atlasCellOrigin : TEXCOORD2;
     nointerpolation uint texIndex : TEXINDEX;
+    float2 occlusion : TEXCOORD3; // VSCalcTerrainOcclusion() の値 (頂点の間で補間する)
 };
 
 struct PSOutput
@@ -49,8 +47,23 @@ struct PSOutput
 };
 
 #include <common/Lighting.hlsl>
+#include <common/TerrainVertex.hlsl>
+
+// テクスチャの1マスの大きさ (凡例は Mesh.h を参照)
+static const float AtlasCellSize = 0.25;
 
-float PSCheckIsSelectedBlock(float3 centerWorldPosition)
+// 面の向きごとの、テクスチャ内で読むマスの左上 (凡例は Mesh.h を参照)
+static const float2 AtlasCellOrigins[6] =
+{
+    float2(0.00, 0.25), // Up
+    float2(0.25, 0.25), // Down
+    float2(0.25, 0.00), // Right
+    float2(0.00, 0.00), // Left
+    float2(0.75, 0.00), // Forward
+    float2(0.50, 0.00), // Backward
+};
+
+float PSCheckIsSelectedBlock(float3 worldPosition, float3 normal)
 {
     // そもそも選択中のブロックが無い
     if (_IsSelectingBlock == 0)
@@ -58,24 +71,33 @@ float PSCheckIsSelectedBlock(float3 centerWorldPosition)
         return 0.0;
     }
     
-    if (all(abs(centerWorldPosition - (float3) _SelectingBlockWorldPosition) < float3(0.01, 0.01, 0.01)))
+    // 面上の位置から、その面を持つブロックの座標を求める (ブロックの中心は整数座標)
+    // 複数ブロックをまとめた面もあるので、頂点ではなくピクセル単位で判定する
+    const float3 blockPosition = floor(worldPosition - normal * 0.5 + 0.5);
+    if (all(abs(blockPosition - (float3) _SelectingBlockWorldPosition) < float3(0.01, 0.01, 0.01)))
     {
         return 1.0;
     }
     return 0.0;
 }
 
-V2P VSMain(VSInput input)
+V2P VSMain(TerrainVertexInput input)
 {
     V2P output;
     
-    output.pos = mul(_Matrix_MVP, input.pos);
-    output.normal = mul((float3x3) _Matrix_M_IT, input.normal);
-    output.worldPos = mul(_Matrix_M, input.pos).xyz;
+    // 法線・UV値は面の向きから、座標はチャンクの原点から復元する
+    const TerrainVertex vertex = VSDecodeTerrainVertex(input);
+    const float4 pos = VSCalcTerrainWorldPosition(vertex, _ChunkOrigin);
+    const float3 normal = TerrainFaceNormals[vertex.faceIndex];
+    
+    output.pos = mul(_Matrix_MVP, pos);
+    output.normal = mul((float3x3) _Matrix_M_IT, normal);
+    output.worldPos = mul(_Matrix_M, pos).xyz;
     
-    output.uv = input.uv;
-    output.centerWorldPosition = input.centerWorldPosition;
-    output.texIndex = input.texIndex;
+    output.uv = VSCalcTerrainUV(vertex);
+    output.atlasCellOrigin = AtlasCellOrigins[vertex.faceIndex];
+    output.texIndex = vertex.texIndex;
+    output.occlusion = VSCalcTerrainOcclusion(vertex);
     
     return output;
 }
@@ -84,13 +106,18 @@ PSOutput PSMain(V2P input)
 {
     PSOutput output;
     
+    // 面の中で、1ブロックごとにテクスチャのマスを繰り返す
+    const float2 uvInAtlas = input.atlasCellOrigin + frac(input.uv) * AtlasCellSize;
+    
     // 1枚のテクスチャに2つ分詰め込まれているので、それをアンパックする
     const uint odd = input.texIndex & 1;
-    const float2 uvReal = odd ? input.uv + float2(0.0, 0.5) : input.uv;
+    const float2 uvReal = odd ? uvInAtlas + float2(0.0, 0.5) : uvInAtlas;
     const uint texIndexReal = input.texIndex >> 1;
     
-    float4 color = _Texture.Sample(_Sampler, float3(uvReal, texIndexReal));
-    if (PSCheckIsSelectedBlock(input.centerWorldPosition) > 0.5)
+    // frac() の継ぎ目で微分が飛ばないよう、繰り返す前のUVから微分を求める
+    const float2 uvScaled = input.uv * AtlasCellSize;
+    float4 color = _Texture.SampleGrad(_Sampler, float3(uvReal, texIndexReal), ddx(uvScaled), ddy(uvScaled));
+    if (PSCheckIsSelectedBlock(input.worldPos, normalize(input.normal)) > 0.5)
         color.rgb = lerp(color.rgb, _SelectColor.rgb, _SelectColor.a);
     
     // ディフューズカラーの計算
@@ -99,6 +126,8 @@ PSOutput PSMain(V2P input)
     lightingParams.SunDirection = normalize(_DirectionalLightDirection);
     lightingParams.SunColor = _DirectionalLightColor.rgb;
     lightingParams.AmbientColor = _AmbientLightColor.rgb;
+    lightingParams.AmbientOcclusion = input.occlusion.x;
+    lightingParams.SkyVisibility = input.occlusion.y;
     const float3 lightColor = PSCalcLighting(lightingParams);
     
     // シャドウの計算
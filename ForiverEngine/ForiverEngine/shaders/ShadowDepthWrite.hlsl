@@ -3,11 +3,13 @@ cbuffer _0 : register(b0)
     float4x4 _Matrix_MVP;
 }
 
-struct VSInput
+// ドローコールごとのルート定数
+cbuffer _1 : register(b1)
 {
-    float4 pos : POSITION;
-    float2 uv : TEXCOORD0;
-};
+    float3 _ChunkOrigin; // 描画するチャンクの原点 (ワールド座標. LOD はリージョンの原点)
+}
+
+#include <common/TerrainVertex.hlsl>
 
 struct V2P
 {
@@ -20,12 +22,13 @@ struct PSOutput
     float depth : SV_TARGET;
 };
 
-V2P VSMain(VSInput input)
+V2P VSMain(TerrainVertexInput input)
 {
     V2P output;
     
-    output.pos = mul(_Matrix_MVP, input.pos);
-    output.uv = input.uv; // 必要ないけど、一応やっておく
+    const TerrainVertex vertex = VSDecodeTerrainVertex(input);
+    output.pos = mul(_Matrix_MVP, VSCalcTerrainWorldPosition(vertex, _ChunkOrigin));
+    output.uv = VSCalcTerrainUV(vertex); // 必要ないけど、一応やっておく
     
     return output;
 }
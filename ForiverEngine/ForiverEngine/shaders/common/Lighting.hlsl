@@ -10,6 +10,9 @@ struct LightingParams
     float3 SunColor; // 太陽光(平行光源) の色
     
     float3 AmbientColor; // 環境光の色
+    
+    float AmbientOcclusion; // 全ての光に掛ける係数 (1.0: 遮られていない)
+    float SkyVisibility; // 空の見え具合. 太陽光と、環境光の一部に掛ける (1.0: 空が見える, 0.0: 屋根の下など)
 };
 
 struct ShadowParams
@@ -25,15 +28,16 @@ struct ShadowParams
 
 float3 PSCalcLighting(LightingParams params)
 {
-    // 太陽光
+    // 太陽光 (空が見えなければ届かない)
     const float NdotL = saturate(dot(params.Normal, -params.SunDirection));
-    const float3 sun = params.SunColor * NdotL / PI;
+    const float3 sun = params.SunColor * NdotL / PI * params.SkyVisibility;
     
-    // 環境光
-    const float3 ambient = params.AmbientColor;
+    // 環境光 (空からの分は、空が見えなければ弱まる)
+    static const float SkyAmbientRatio = 0.6;
+    const float3 ambient = params.AmbientColor * lerp(1.0 - SkyAmbientRatio, 1.0, params.SkyVisibility);
     
     // 光の影響を合成して返す
-    const float3 light = sun + ambient;
+    const float3 light = (sun + ambient) * params.AmbientOcclusion;
     return light;
 }
 
@@ -0,0 +1,82 @@
+// 地形の頂点 (8バイトに詰めたもの) の復元
+// 詰め方は TerrainVertex (scripts/component/Mesh/TerrainMesh.h) と同じにすること
+
+struct TerrainVertexInput
+{
+    uint packed : PACKED; // [0, 5) x, [5, 14) y, [14, 19) z, [19, 22) 面の向き, [22, 24) 面の中での頂点番号, [24, 26) 環境遮蔽, [26, 29) 空の遮蔽
+    uint texIndex : TEXINDEX; // [0, 16) テクスチャのインデックス, [16, 21) x, [21, 26) z 方向の、ドローコールの原点からのチャンク数
+};
+
+struct TerrainVertex
+{
+    float3 cornerPosition; // チャンク内での格子点
+    uint faceIndex; // Up, Down, Right, Left, Forward, Backward
+    uint cornerIndex; // 左下, 左上, 右下, 右上
+    uint ambientOcclusion; // [0, 3] 頂点に接する不透明ブロックの数 (0 は遮られていない)
+    uint skyOcclusion; // [0, 4] 頂点に接する、空が見えないマスの数 (0 は遮られていない)
+    uint texIndex; // 使用するテクスチャのインデックス
+    float3 chunkOffset; // ドローコールの原点から、頂点のチャンクの原点までのずれ (LOD はリージョン単位で描画する. それ以外は 0)
+};
+
+static const float3 TerrainFaceNormals[6] =
+{
+    float3(0, +1, 0), // Up
+    float3(0, -1, 0), // Down
+    float3(+1, 0, 0), // Right
+    float3(-1, 0, 0), // Left
+    float3(0, 0, +1), // Forward
+    float3(0, 0, -1), // Backward
+};
+
+// UV値 = 格子点とこれらの内積 (1ブロック = 1.0)
+static const float3 TerrainFaceUAxes[6] =
+{
+    float3(+1, 0, 0), // Up
+    float3(+1, 0, 0), // Down
+    float3(0, 0, +1), // Right
+    float3(0, 0, -1), // Left
+    float3(-1, 0, 0), // Forward
+    float3(+1, 0, 0), // Backward
+};
+static const float3 TerrainFaceVAxes[6] =
+{
+    float3(0, 0, -1), // Up
+    float3(0, 0, +1), // Down
+    float3(0, -1, 0), // Right
+    float3(0, -1, 0), // Left
+    float3(0, -1, 0), // Forward
+    float3(0, -1, 0), // Backward
+};
+
+TerrainVertex VSDecodeTerrainVertex(TerrainVertexInput input)
+{
+    const uint packed = input.packed;
+    TerrainVertex vertex;
+    vertex.cornerPosition = float3(packed & 0x1F, (packed >> 5) & 0x1FF, (packed >> 14) & 0x1F);
+    vertex.faceIndex = (packed >> 19) & 0x7;
+    vertex.cornerIndex = (packed >> 22) & 0x3;
+    vertex.ambientOcclusion = (packed >> 24) & 0x3;
+    vertex.skyOcclusion = (packed >> 26) & 0x7;
+    vertex.texIndex = input.texIndex & 0xFFFF;
+    vertex.chunkOffset = float3((input.texIndex >> 16) & 0x1F, 0, (input.texIndex >> 21) & 0x1F) * 16.0;
+    return vertex;
+}
+
+// ドローコールの原点 (ワールド座標) から、頂点のワールド座標を求める
+float4 VSCalcTerrainWorldPosition(TerrainVertex vertex, float3 chunkOrigin)
+{
+    return float4(chunkOrigin + vertex.chunkOffset + vertex.cornerPosition - 0.5, 1.0);
+}
+
+// 遮蔽から、光の当たり具合を求める
+// x: 環境遮蔽 (全ての光に掛ける), y: 空の見え具合 (太陽光と、環境光の一部に掛ける). どちらも 1.0 が遮られていない
+float2 VSCalcTerrainOcclusion(TerrainVertex vertex)
+{
+    static const float AmbientOcclusionLevels[4] = { 1.0, 0.8, 0.65, 0.5 };
+    return float2(AmbientOcclusionLevels[vertex.ambientOcclusion], 1.0 - vertex.skyOcclusion / 4.0);
+}
+
+float2 VSCalcTerrainUV(TerrainVertex vertex)
+{
+    return float2(dot(vertex.cornerPosition, TerrainFaceUAxes[vertex.faceIndex]), dot(vertex.cornerPosition, TerrainFaceVAxes[vertex.faceIndex]));
+}
\ No newline at end of file